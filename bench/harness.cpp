@@ -0,0 +1,322 @@
+#include "harness.hpp"
+
+#include "../include/kernels.hpp"
+#include "../include/validation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <numeric>
+#include <regex>
+#include <sstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#ifndef QPP_BENCH_BUILD_TYPE
+#define QPP_BENCH_BUILD_TYPE "unknown"
+#endif
+
+namespace QPP::Bench {
+
+    namespace {
+        typedef std::chrono::steady_clock Clock;
+
+        /// \brief Gets the value of an option of the form --name=value, or nullptr if the argument is another option
+        const char *getValue(const std::string &argument, const std::string &name) {
+            const std::string prefix = "--" + name + "=";
+            return argument.rfind(prefix, 0) == 0 ? argument.c_str() + prefix.size() : nullptr;
+        }
+
+        std::string getCompiler() {
+#if defined(__clang__)
+            return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "GCC " __VERSION__;
+#elif defined(_MSC_VER)
+            return "MSVC " + std::to_string(_MSC_VER);
+#else
+            return "unknown";
+#endif
+        }
+
+        /// \brief Gets the validation policy the suite is built with, and whether its checks are compiled in
+        std::string getValidation() {
+            std::string policy;
+            switch (VALIDATION_POLICY) {
+                case ValidationPolicy::CHECKED:
+                    policy = "CHECKED";
+                    break;
+                case ValidationPolicy::DEBUG_ONLY:
+                    policy = "DEBUG_ONLY";
+                    break;
+                case ValidationPolicy::UNCHECKED:
+                    policy = "UNCHECKED";
+                    break;
+            }
+            return policy + (VALIDATION_ENABLED ? " (enabled)" : " (disabled)");
+        }
+
+        std::string getDate() {
+            const std::time_t now = std::time(nullptr);
+            char buffer[32];
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+            return buffer;
+        }
+    }
+
+    Harness::InvalidOptionException::InvalidOptionException(const std::string &option) :
+            std::runtime_error("Invalid option: " + option) {}
+
+    Harness::Options Harness::parseOptions(int argc, const char *const *argv) {
+        Options options;
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            try {
+                if (argument == "--list") {
+                    options.list = true;
+                } else if (argument == "--help" || argument == "-h") {
+                    options.help = true;
+                } else if (const char *filter = getValue(argument, "filter")) {
+                    options.filter = filter;
+                    // Reject malformed expressions before any case runs
+                    static_cast<void>(std::regex(options.filter));
+                } else if (const char *repetitions = getValue(argument, "repetitions")) {
+                    options.repetitions = std::stoul(repetitions);
+                    if (options.repetitions == 0) {
+                        throw InvalidOptionException(argument);
+                    }
+                } else if (const char *minTime = getValue(argument, "min-time")) {
+                    options.minTime = std::stod(minTime);
+                    if (!(options.minTime >= 0)) {
+                        throw InvalidOptionException(argument);
+                    }
+                } else if (const char *outputPath = getValue(argument, "out")) {
+                    options.outputPath = outputPath;
+                } else if (const char *kernel = getValue(argument, "kernel")) {
+                    options.kernel = kernel;
+                    bool known = false;
+                    for (int level = Kernels::SCALAR; level <= Kernels::AVX512; level++) {
+                        known = known || options.kernel == Kernels::getLevelName(static_cast<Kernels::Level>(level));
+                    }
+                    if (!known) {
+                        throw InvalidOptionException(argument);
+                    }
+                } else {
+                    throw InvalidOptionException(argument);
+                }
+            } catch (const InvalidOptionException &) {
+                throw;
+            } catch (const std::exception &) {
+                // std::stoul, std::stod and std::regex report malformed values with their own exceptions
+                throw InvalidOptionException(argument);
+            }
+        }
+        return options;
+    }
+
+    std::string Harness::getUsage(const std::string &programName) {
+        return "Usage: " + programName + " [options]\n"
+               "  --filter=REGEX       run the cases whose name contains a match of REGEX\n"
+               "  --repetitions=N      time each case N times (default 5)\n"
+               "  --min-time=SECONDS   minimum duration of a repetition (default 0.1)\n"
+               "  --out=FILE           write the JSON report to FILE instead of the standard output\n"
+               "  --kernel=LEVEL       force the scalar, sse, avx2 or avx512 kernels (capped to the CPU)\n"
+               "  --list               list the selected cases without running them\n"
+               "  --help               print this message\n";
+    }
+
+    void Harness::add(const std::string &name, Setup setup, const double &itemsPerOperation,
+                      const std::string &itemName) {
+        cases.push_back({name, std::move(setup), itemsPerOperation, itemName});
+    }
+
+    std::vector<std::string> Harness::getNames(const std::string &filter) const {
+        const std::regex expression(filter);
+        std::vector<std::string> names;
+        for (const auto &benchmarkCase: cases) {
+            if (filter.empty() || std::regex_search(benchmarkCase.name, expression)) {
+                names.push_back(benchmarkCase.name);
+            }
+        }
+        return names;
+    }
+
+    void Harness::run(const Options &options, std::ostream &output, std::ostream &progress) const {
+        for (int level = Kernels::SCALAR; level <= Kernels::AVX512; level++) {
+            if (options.kernel == Kernels::getLevelName(static_cast<Kernels::Level>(level))) {
+                Kernels::setLevel(static_cast<Kernels::Level>(level));
+            }
+        }
+
+        const auto precision = output.precision(9);
+        output << "{\n"
+               << "  \"context\": {\n"
+               << "    \"date\": \"" << getDate() << "\",\n"
+               << "    \"compiler\": \"" << escape(getCompiler()) << "\",\n"
+               << "    \"build_type\": \"" << escape(QPP_BENCH_BUILD_TYPE) << "\",\n"
+               << "    \"validation\": \"" << getValidation() << "\",\n"
+               << "    \"kernel\": \"" << Kernels::getLevelName(Kernels::getLevel()) << "\",\n"
+               << "    \"repetitions\": " << options.repetitions << ",\n"
+               << "    \"min_time\": " << options.minTime << ",\n"
+               << "    \"filter\": \"" << escape(options.filter) << "\"\n"
+               << "  },\n"
+               << "  \"benchmarks\": [";
+
+        const std::regex expression(options.filter);
+        bool first = true;
+        for (const auto &benchmarkCase: cases) {
+            if (!options.filter.empty() && !std::regex_search(benchmarkCase.name, expression)) {
+                continue;
+            }
+            progress << benchmarkCase.name << std::endl;
+            output << (first ? "\n" : ",\n") << "    {\n"
+                   << "      \"name\": \"" << escape(benchmarkCase.name) << "\",\n";
+            first = false;
+
+            const bool peakReset = resetPeakResidentSetSize();
+            try {
+                Operation operation = benchmarkCase.setup();
+                const auto time = [&operation](const std::size_t &iterations) {
+                    const auto start = Clock::now();
+                    for (std::size_t i = 0; i < iterations; i++) {
+                        operation();
+                    }
+                    return std::chrono::duration<double>(Clock::now() - start).count();
+                };
+
+                // The first call warms up caches and lazily compiled programs, and the calibration warms up further
+                operation();
+                std::size_t iterations = 1;
+                for (double elapsed = time(iterations); elapsed < options.minTime; elapsed = time(iterations)) {
+                    const double scale = elapsed > 0 ? std::min(options.minTime * 1.2 / elapsed, 10.0) : 10.0;
+                    iterations = std::max(iterations + 1, static_cast<std::size_t>(static_cast<double>(iterations) * scale));
+                }
+
+                std::vector<double> nanoseconds;
+                std::vector<double> throughput;
+                for (std::size_t repetition = 0; repetition < options.repetitions; repetition++) {
+                    const double perOperation = time(iterations) / static_cast<double>(iterations);
+                    nanoseconds.push_back(perOperation * 1e9);
+                    throughput.push_back(perOperation > 0 ? benchmarkCase.itemsPerOperation / perOperation : 0);
+                }
+
+                output << "      \"iterations\": " << iterations << ",\n"
+                       << "      \"repetitions\": " << options.repetitions << ",\n"
+                       << "      \"ns_per_op\": ";
+                writeSummary(output, summarize(nanoseconds));
+                if (benchmarkCase.itemsPerOperation > 0) {
+                    output << ",\n      \"" << escape(benchmarkCase.itemName) << "_per_op\": "
+                           << benchmarkCase.itemsPerOperation
+                           << ",\n      \"" << escape(benchmarkCase.itemName) << "_per_second\": ";
+                    writeSummary(output, summarize(throughput));
+                }
+                output << ",\n";
+            } catch (const std::exception &exception) {
+                output << "      \"error\": \"" << escape(exception.what()) << "\",\n";
+            }
+            output << "      \"peak_rss_bytes\": " << getPeakResidentSetSize() << ",\n"
+                   << "      \"peak_rss_scope\": \"" << (peakReset ? "case" : "process") << "\"\n"
+                   << "    }";
+        }
+        output << (first ? "]\n" : "\n  ]\n") << "}\n";
+        output.precision(precision);
+    }
+
+    std::size_t Harness::getPeakResidentSetSize() {
+#if defined(__linux__)
+        // VmHWM follows the resets made through clear_refs, unlike getrusage
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.rfind("VmHWM:", 0) == 0) {
+                return std::stoul(line.substr(6)) * 1024;
+            }
+        }
+        return 0;
+#elif defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return 0;
+        }
+        return counters.PeakWorkingSetSize;
+#elif defined(__unix__) || defined(__APPLE__)
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+#if defined(__APPLE__)
+        return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    bool Harness::resetPeakResidentSetSize() {
+#if defined(__linux__)
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5";
+        clearRefs.flush();
+        return clearRefs.good();
+#else
+        return false;
+#endif
+    }
+
+    Harness::Summary Harness::summarize(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        const auto count = static_cast<double>(samples.size());
+        const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+        double squares = 0;
+        for (const auto &sample: samples) {
+            squares += (sample - mean) * (sample - mean);
+        }
+        const std::size_t middle = samples.size() / 2;
+        return {
+                mean,
+                samples.size() % 2 == 1 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2,
+                samples.size() > 1 ? std::sqrt(squares / (count - 1)) : 0,
+                samples.front(),
+                samples.back()
+        };
+    }
+
+    void Harness::writeSummary(std::ostream &output, const Summary &summary) {
+        output << "{\"mean\": " << summary.mean
+               << ", \"median\": " << summary.median
+               << ", \"stddev\": " << summary.standardDeviation
+               << ", \"min\": " << summary.min
+               << ", \"max\": " << summary.max << "}";
+    }
+
+    std::string Harness::escape(const std::string &text) {
+        std::string escaped;
+        for (const auto &character: text) {
+            if (character == '"' || character == '\\') {
+                escaped += '\\';
+                escaped += character;
+            } else if (static_cast<unsigned char>(character) < 0x20) {
+                const char *digits = "0123456789abcdef";
+                escaped += "\\u00";
+                escaped += digits[(character >> 4) & 0xF];
+                escaped += digits[character & 0xF];
+            } else {
+                escaped += character;
+            }
+        }
+        return escaped;
+    }
+
+}
@@ -0,0 +1,113 @@
+/**
+ * @file harness.hpp
+ * @brief This file contains the Harness class used by the qpp_bench benchmark suite.
+ * @author Mario Deaconescu
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace QPP::Bench {
+
+/**
+ * @class Harness
+ * @brief Runs named benchmark cases and reports their timings as JSON.
+ *
+ * A case is registered with a setup function, which builds whatever the case needs (circuits, states, inputs) and
+ * returns the operation to time. Setups only run for the cases selected by the filter, one case at a time, so large
+ * states are freed before the next case starts.
+ *
+ * Each operation is run once to warm up, then the number of iterations is calibrated so that a repetition lasts at
+ * least the minimum time. Every repetition is one sample of the time per operation, and the report holds the mean,
+ * median, standard deviation, minimum and maximum of the samples.
+ */
+    class Harness {
+    public:
+        typedef std::function<void()> Operation;
+        typedef std::function<Operation()> Setup;
+
+        /// \brief Command line options of the benchmark suite
+        struct Options {
+            /// \brief ECMAScript regular expression searched in the names of the cases (empty selects every case)
+            std::string filter;
+            /// \brief The number of timed repetitions of each case
+            std::size_t repetitions = 5;
+            /// \brief The minimum duration of a repetition, in seconds
+            double minTime = 0.1;
+            /// \brief The file the report is written to (empty writes to the standard output)
+            std::string outputPath;
+            /// \brief The kernel level forced for double-precision state vectors (empty keeps the detected one)
+            std::string kernel;
+            /// \brief Only list the names of the selected cases
+            bool list = false;
+            /// \brief Only print the usage
+            bool help = false;
+        };
+
+        class InvalidOptionException : public std::runtime_error {
+        public:
+            explicit InvalidOptionException(const std::string &option);
+        };
+
+        /// \brief Parses the command line of the benchmark suite
+        [[nodiscard]] static Options parseOptions(int argc, const char *const *argv);
+
+        /// \brief Gets the usage of the benchmark suite
+        [[nodiscard]] static std::string getUsage(const std::string &programName);
+
+        /// \brief Registers a case
+        /// \param name The name of the case, made of '/'-separated components
+        /// \param setup Builds the inputs of the case and returns the operation to time
+        /// \param itemsPerOperation The number of items (shots, gates, ...) processed by an operation, or 0
+        /// \param itemName The name of the items, reported next to the throughput
+        void add(const std::string &name, Setup setup, const double &itemsPerOperation = 0,
+                 const std::string &itemName = "");
+
+        /// \brief Gets the names of the cases selected by a filter, in registration order
+        [[nodiscard]] std::vector<std::string> getNames(const std::string &filter) const;
+
+        /// \brief Runs the selected cases and writes the JSON report
+        /// \param options The options of the run
+        /// \param output The stream the report is written to
+        /// \param progress The stream the name of each case is written to before it runs
+        void run(const Options &options, std::ostream &output, std::ostream &progress) const;
+
+        /// \brief Gets the peak resident set size of the process, in bytes (0 if unknown)
+        [[nodiscard]] static std::size_t getPeakResidentSetSize();
+
+        /// \brief Resets the peak resident set size to the current one, where the platform allows it
+        /// \return True if the peak was reset, false if it covers the whole lifetime of the process
+        static bool resetPeakResidentSetSize();
+
+    private:
+        struct Case {
+            std::string name;
+            Setup setup;
+            double itemsPerOperation;
+            std::string itemName;
+        };
+
+        struct Summary {
+            double mean;
+            double median;
+            double standardDeviation;
+            double min;
+            double max;
+        };
+
+        std::vector<Case> cases;
+
+        [[nodiscard]] static Summary summarize(std::vector<double> samples);
+
+        static void writeSummary(std::ostream &output, const Summary &summary);
+
+        [[nodiscard]] static std::string escape(const std::string &text);
+    };
+
+}
@@ -0,0 +1,418 @@
+#include <fstream>
+#include <iostream>
+#include <numbers>
+
+#include "harness.hpp"
+#include "../include/circuit.hpp"
+
+#include "../examples/shors_algorithm.hpp"
+
+/// This executable is the benchmark suite of the library
+/// Every case has a fixed seed, so that runs of different versions of the library do the same work
+
+namespace {
+    typedef QPP::Circuit<double> Circuit;
+    typedef QPP::Bench::Harness Harness;
+    typedef std::shared_ptr<QPP::ProbabilityEngine<double>> Engine;
+
+    constexpr std::uint64_t SEED = 42;
+    constexpr size_t SHOT_COUNT = 10000;
+    constexpr size_t AGGREGATED_SHOT_COUNT = 1000000;
+
+    /// Gates are applied on a register of GATE_QUBIT_COUNT qubits, targeting qubits above the lowest ones so that
+    /// the vectorized kernels are used
+    constexpr size_t GATE_QUBIT_COUNT = 16;
+    constexpr size_t TARGET = 8;
+    constexpr size_t CONTROL = 3;
+
+    /// The number of layers of the brickwork circuits run on the MPS backend, bounding their bond dimension by 2^(d/2)
+    constexpr size_t BRICKWORK_DEPTH = 8;
+
+    /// The size of the circuits built and copied by the construction cases
+    constexpr size_t CONSTRUCTION_QUBIT_COUNT = 16;
+    constexpr size_t CONSTRUCTION_GATE_COUNT = 1024;
+
+    /// The number of passes of the shift-and-add circuits run on the sparse backend
+    constexpr size_t ARITHMETIC_PASSES = 16;
+
+    /// Keeps the results of the timed operations alive, so that they are not optimized away
+    volatile size_t sink = 0;
+
+    Engine makeEngine() {
+        return std::make_shared<QPP::ProbabilityEngine<double>>(2e-10, SEED);
+    }
+
+    Circuit makeGHZ(const Engine &engine, const size_t &qubitCount, const bool &perShot) {
+        Circuit circuit(engine, qubitCount, qubitCount);
+        circuit.addHadamardGate(0);
+        for (size_t i = 1; i < qubitCount; i++) {
+            circuit.addCXGate(i - 1, i);
+        }
+        std::vector<std::pair<size_t, size_t>> measurements;
+        for (size_t i = 0; i < qubitCount; i++) {
+            measurements.emplace_back(i, i);
+        }
+        circuit.addMeasureGate(measurements);
+        if (perShot) {
+            // A gate after the measurements keeps the shots from being sampled from a single evolution
+            circuit.addXGate(0);
+        }
+        return circuit;
+    }
+
+    Circuit makeBrickwork(const Engine &engine, const size_t &qubitCount) {
+        Circuit circuit(engine, qubitCount, qubitCount);
+        for (size_t layer = 0; layer < BRICKWORK_DEPTH; layer++) {
+            for (size_t i = 0; i < qubitCount; i++) {
+                circuit.addHadamardGate(i);
+                circuit.addPhaseGate(i, 0.1 * double(layer + i));
+            }
+            for (size_t i = layer % 2; i + 1 < qubitCount; i += 2) {
+                circuit.addCXGate(i, i + 1);
+            }
+        }
+        std::vector<std::pair<size_t, size_t>> measurements;
+        for (size_t i = 0; i < qubitCount; i++) {
+            measurements.emplace_back(i, i);
+        }
+        circuit.addMeasureGate(measurements);
+        return circuit;
+    }
+
+    Circuit makeArithmetic(const Engine &engine, const size_t &qubitCount) {
+        // A superposition of 16 inputs, carried through reversible gates that never add basis states
+        Circuit circuit(engine, qubitCount, qubitCount);
+        for (size_t i = 0; i < 4; i++) {
+            circuit.addHadamardGate(i);
+        }
+        for (size_t pass = 0; pass < ARITHMETIC_PASSES; pass++) {
+            for (size_t i = 0; i + 2 < qubitCount; i++) {
+                circuit.addCXGate(i, i + 1);
+                circuit.addSwapGate(i + 1, i + 2);
+            }
+            circuit.addXGate(pass % qubitCount);
+        }
+        return circuit;
+    }
+
+    /// Adds a mix of single-qubit, controlled, swap and measure gates, spread over the first qubits of the circuit
+    void addMixedGates(Circuit &circuit, const size_t &qubitCount, const size_t &gateCount) {
+        for (size_t i = 0; i < gateCount; i++) {
+            const size_t qubit = i % qubitCount;
+            switch (i % 5) {
+                case 0:
+                    circuit.addHadamardGate(qubit);
+                    break;
+                case 1:
+                    circuit.addCXGate(qubit, (qubit + 1) % qubitCount);
+                    break;
+                case 2:
+                    circuit.addControlledPhaseGate(qubit, (qubit + qubitCount / 2) % qubitCount, std::numbers::pi / 4);
+                    break;
+                case 3:
+                    circuit.addSwapGate(qubit, (qubit + 3) % qubitCount);
+                    break;
+                default:
+                    circuit.addMeasureGate({{qubit, qubit}});
+            }
+        }
+    }
+
+    void addGateCases(Harness &harness) {
+        const std::vector<std::pair<std::string, std::function<std::unique_ptr<Circuit::Gate>()>>> gates = {
+                {"MeasureGate", [] { return std::make_unique<Circuit::MeasureGate>(std::vector<std::pair<size_t, size_t>>{{TARGET, 0}}); }},
+                {"HadamardGate", [] { return std::make_unique<Circuit::HadamardGate>(TARGET); }},
+                {"ControlledHadamardGate", [] { return std::make_unique<Circuit::ControlledHadamardGate>(CONTROL, TARGET); }},
+                {"XGate", [] { return std::make_unique<Circuit::XGate>(TARGET); }},
+                {"CXGate", [] { return std::make_unique<Circuit::CXGate>(CONTROL, TARGET); }},
+                {"YGate", [] { return std::make_unique<Circuit::YGate>(TARGET); }},
+                {"CYGate", [] { return std::make_unique<Circuit::CYGate>(CONTROL, TARGET); }},
+                {"ZGate", [] { return std::make_unique<Circuit::ZGate>(TARGET); }},
+                {"CZGate", [] { return std::make_unique<Circuit::CZGate>(CONTROL, TARGET); }},
+                {"SwapGate", [] { return std::make_unique<Circuit::SwapGate>(TARGET, TARGET + 1); }},
+                {"CustomControlledGate", [] {
+                    return std::make_unique<Circuit::CustomControlledGate>(CONTROL, std::make_unique<Circuit::SwapGate>(TARGET, TARGET + 1));
+                }},
+                {"CircuitGate", [] {
+                    auto subCircuit = std::make_shared<Circuit>(makeEngine(), 3);
+                    subCircuit->addHadamardGate(0);
+                    subCircuit->addCXGate(0, 1);
+                    subCircuit->addCXGate(1, 2);
+                    return std::make_unique<Circuit::CircuitGate>(subCircuit, std::vector<size_t>{TARGET, TARGET + 1, TARGET + 2});
+                }},
+                {"PhaseGate", [] { return std::make_unique<Circuit::PhaseGate>(TARGET, std::numbers::pi / 8); }},
+                {"ControlledPhaseGate", [] { return std::make_unique<Circuit::ControlledPhaseGate>(CONTROL, TARGET, std::numbers::pi / 8); }},
+                {"InitGate", [] {
+                    return std::make_unique<Circuit::InitGate>(TARGET, QPP::Qubit<double>::State(makeEngine(), 1, 0));
+                }},
+                {"FusedGate", [] {
+                    // H ⊗ H
+                    std::vector<Circuit::FusedGate::Amplitude> matrix(16);
+                    for (size_t row = 0; row < 4; row++) {
+                        for (size_t column = 0; column < 4; column++) {
+                            matrix[row * 4 + column] = std::popcount(row & column) % 2 == 0 ? 0.5 : -0.5;
+                        }
+                    }
+                    return std::make_unique<Circuit::FusedGate>(std::vector<size_t>{TARGET, TARGET + 1}, matrix);
+                }},
+                {"PermutationGate", [] {
+                    // Increment modulo 8
+                    std::vector<size_t> table(8);
+                    for (size_t i = 0; i < table.size(); i++) {
+                        table[i] = (i + 1) % table.size();
+                    }
+                    return std::make_unique<Circuit::PermutationGate>(std::vector<size_t>{TARGET, TARGET + 1, TARGET + 2}, table);
+                }},
+                // PrintGate is deprecated and writes to a stream on every application, so it is not benchmarked
+        };
+
+        for (const auto &[name, makeGate]: gates) {
+            harness.add("gate/" + name + "/q" + std::to_string(GATE_QUBIT_COUNT), [makeGate] {
+                auto circuit = std::make_shared<Circuit>(makeEngine(), GATE_QUBIT_COUNT, 1);
+                for (size_t i = 0; i < GATE_QUBIT_COUNT; i++) {
+                    Circuit::HadamardGate(i).apply(circuit.get());
+                }
+                std::shared_ptr<Circuit::Gate> gate = makeGate();
+                return [circuit, gate] {
+                    gate->apply(circuit.get());
+                };
+            }, 1, "gates");
+        }
+    }
+
+    void addSimulationCases(Harness &harness) {
+        harness.add("simulate/bell/shots" + std::to_string(SHOT_COUNT), [] {
+            auto circuit = std::make_shared<Circuit>(makeGHZ(makeEngine(), 2, false));
+            return [circuit] {
+                sink = circuit->simulate(SHOT_COUNT).getShotCount();
+            };
+        }, SHOT_COUNT, "shots");
+
+        for (const size_t qubitCount: {4, 8, 12, 16, 20}) {
+            harness.add("simulate/ghz/q" + std::to_string(qubitCount) + "/shots" + std::to_string(SHOT_COUNT), [qubitCount] {
+                auto circuit = std::make_shared<Circuit>(makeGHZ(makeEngine(), qubitCount, false));
+                return [circuit] {
+                    sink = circuit->simulate(SHOT_COUNT).getShotCount();
+                };
+            }, SHOT_COUNT, "shots");
+        }
+
+        for (const size_t qubitCount: {2, 4, 8}) {
+            harness.add("simulate/ghz-per-shot/q" + std::to_string(qubitCount) + "/shots" + std::to_string(SHOT_COUNT), [qubitCount] {
+                auto circuit = std::make_shared<Circuit>(makeGHZ(makeEngine(), qubitCount, true));
+                return [circuit] {
+                    sink = circuit->simulate(SHOT_COUNT).getShotCount();
+                };
+            }, SHOT_COUNT, "shots");
+        }
+
+        // Far beyond what a state vector can hold, so only the stabilizer backend runs them
+        for (const size_t qubitCount: {64, 256, 1024, 4096}) {
+            harness.add("stabilizer/ghz/q" + std::to_string(qubitCount), [qubitCount] {
+                const Engine engine = makeEngine();
+                auto circuit = std::make_shared<Circuit>(makeGHZ(engine, qubitCount, false));
+                circuit->setBackend(Circuit::STABILIZER);
+                auto workspace = std::make_shared<Circuit::Workspace>(engine);
+                return [circuit, workspace] {
+                    circuit->run(*workspace);
+                };
+            }, 1, "shots");
+        }
+
+        // Brickwork circuits of nearest-neighbour gates, whose bond dimension stays small on the MPS backend
+        for (const size_t qubitCount: {64, 128}) {
+            harness.add("mps/brickwork/q" + std::to_string(qubitCount) + "/depth" + std::to_string(BRICKWORK_DEPTH), [qubitCount] {
+                const Engine engine = makeEngine();
+                auto circuit = std::make_shared<Circuit>(makeBrickwork(engine, qubitCount));
+                circuit->setBackend(Circuit::MATRIX_PRODUCT_STATE);
+                auto workspace = std::make_shared<Circuit::Workspace>(engine);
+                return [circuit, workspace] {
+                    circuit->run(*workspace);
+                };
+            }, 1, "shots");
+        }
+
+        // Far beyond what a state vector can hold, with 16 populated basis states on the sparse backend
+        for (const size_t qubitCount: {40, 56}) {
+            const size_t gateCount = makeArithmetic(makeEngine(), qubitCount).getGates().size();
+            harness.add("sparse/arithmetic/q" + std::to_string(qubitCount), [qubitCount] {
+                const Engine engine = makeEngine();
+                auto circuit = std::make_shared<Circuit>(makeArithmetic(engine, qubitCount));
+                circuit->setBackend(Circuit::SPARSE);
+                auto workspace = std::make_shared<Circuit::Workspace>(engine);
+                return [circuit, workspace] {
+                    circuit->run(*workspace);
+                };
+            }, static_cast<double>(gateCount), "gates");
+        }
+    }
+
+    void addAlgorithmCases(Harness &harness) {
+        for (size_t qubitCount = 4; qubitCount <= 24; qubitCount += 4) {
+            const size_t gateCount = CQFT(makeEngine(), qubitCount).getGates().size();
+            harness.add("cqft/q" + std::to_string(qubitCount), [qubitCount] {
+                const Engine engine = makeEngine();
+                auto circuit = std::make_shared<Circuit>(CQFT(engine, qubitCount));
+                auto workspace = std::make_shared<Circuit::Workspace>(engine);
+                return [circuit, workspace] {
+                    circuit->run(*workspace);
+                };
+            }, static_cast<double>(gateCount), "gates");
+        }
+
+        for (const size_t countingQubits: {4, 8}) {
+            harness.add("shor/a7/counting" + std::to_string(countingQubits) + "/shots" + std::to_string(SHOT_COUNT), [countingQubits] {
+                auto circuit = std::make_shared<Circuit>(shorsCircuit(makeEngine(), 7, countingQubits));
+                return [circuit] {
+                    sink = circuit->simulate(SHOT_COUNT).getShotCount();
+                };
+            }, SHOT_COUNT, "shots");
+        }
+    }
+
+    void addAggregationCases(Harness &harness) {
+        // Results of up to DENSE_BIT_LIMIT bits are counted in a dense array, wider ones in a hash table
+        for (const size_t bitCount: {16, 64}) {
+            const std::string suffix = "/bits" + std::to_string(bitCount) + "/shots" + std::to_string(AGGREGATED_SHOT_COUNT);
+            const auto makeResults = [bitCount] {
+                auto engine = makeEngine();
+                auto results = std::make_shared<std::vector<Circuit::Result>>(4096, Circuit::Result(bitCount));
+                for (auto &result: *results) {
+                    for (size_t bit = 0; bit < bitCount; bit++) {
+                        // Only a few bits vary, so that wide results repeat like real measurement outcomes
+                        result.setBit(bit, bit < 12 && engine->getBits() % 2 == 1);
+                    }
+                }
+                return results;
+            };
+
+            harness.add("compound-result/add" + suffix, [makeResults] {
+                auto results = makeResults();
+                return [results] {
+                    Circuit::CompoundResult compound;
+                    for (size_t shot = 0; shot < AGGREGATED_SHOT_COUNT; shot++) {
+                        compound.addResult((*results)[shot % results->size()]);
+                    }
+                    sink = compound.getShotCount();
+                };
+            }, AGGREGATED_SHOT_COUNT, "shots");
+
+            harness.add("compound-result/merge" + suffix, [makeResults] {
+                auto results = makeResults();
+                // 64 partial results, like the ones of the threads of simulate
+                auto blocks = std::make_shared<std::vector<Circuit::CompoundResult>>(64);
+                for (size_t shot = 0; shot < AGGREGATED_SHOT_COUNT; shot++) {
+                    (*blocks)[shot % blocks->size()].addResult((*results)[shot % results->size()]);
+                }
+                return [blocks] {
+                    Circuit::CompoundResult compound;
+                    for (const auto &block: *blocks) {
+                        compound += block;
+                    }
+                    sink = compound.getShotCount();
+                };
+            }, AGGREGATED_SHOT_COUNT, "shots");
+
+            harness.add("compound-result/get-results" + suffix, [makeResults] {
+                auto results = makeResults();
+                auto compound = std::make_shared<Circuit::CompoundResult>();
+                for (size_t shot = 0; shot < AGGREGATED_SHOT_COUNT; shot++) {
+                    compound->addResult((*results)[shot % results->size()]);
+                }
+                return [compound] {
+                    sink = compound->getResults().size();
+                };
+            });
+        }
+    }
+
+    /// Building and copying circuits, whose gates are verified when QPP_VALIDATION enables the checks; compare the
+    /// reports of qpp_bench and qpp_bench_unchecked to get the cost of the validation
+    void addConstructionCases(Harness &harness) {
+        const std::string suffix = "/q" + std::to_string(CONSTRUCTION_QUBIT_COUNT) + "/gates" + std::to_string(CONSTRUCTION_GATE_COUNT);
+        harness.add("circuit/add" + suffix, [] {
+            const Engine engine = makeEngine();
+            return [engine] {
+                Circuit circuit(engine, CONSTRUCTION_QUBIT_COUNT, CONSTRUCTION_QUBIT_COUNT);
+                addMixedGates(circuit, CONSTRUCTION_QUBIT_COUNT, CONSTRUCTION_GATE_COUNT);
+                sink = circuit.getGates().size();
+            };
+        }, static_cast<double>(CONSTRUCTION_GATE_COUNT), "gates");
+
+        harness.add("circuit/copy-and-add" + suffix, [] {
+            auto circuit = std::make_shared<Circuit>(makeEngine(), CONSTRUCTION_QUBIT_COUNT, CONSTRUCTION_QUBIT_COUNT);
+            addMixedGates(*circuit, CONSTRUCTION_QUBIT_COUNT, CONSTRUCTION_GATE_COUNT);
+            return [circuit] {
+                // The copy shares the gates until the added gate makes it clone them
+                Circuit copy = *circuit;
+                copy.addXGate(0);
+                sink = copy.getGates().size();
+            };
+        }, static_cast<double>(CONSTRUCTION_GATE_COUNT), "gates");
+
+        harness.add("circuit/append-wider" + suffix, [] {
+            const Engine engine = makeEngine();
+            auto circuit = std::make_shared<Circuit>(engine, 2 * CONSTRUCTION_QUBIT_COUNT, 2 * CONSTRUCTION_QUBIT_COUNT);
+            addMixedGates(*circuit, CONSTRUCTION_QUBIT_COUNT, CONSTRUCTION_GATE_COUNT);
+            return [engine, circuit] {
+                // The gates only fit the narrower circuit because they use its first qubits, so they are verified again
+                Circuit narrower(engine, CONSTRUCTION_QUBIT_COUNT, CONSTRUCTION_QUBIT_COUNT);
+                narrower += *circuit;
+                sink = narrower.getGates().size();
+            };
+        }, static_cast<double>(CONSTRUCTION_GATE_COUNT), "gates");
+    }
+
+    void addRepresentationCases(Harness &harness) {
+        for (const auto &[qubitCount, gateCount]: std::vector<std::pair<size_t, size_t>>{{8, 64}, {16, 256}, {16, 1024}}) {
+            harness.add("representation/q" + std::to_string(qubitCount) + "/gates" + std::to_string(gateCount), [qubitCount, gateCount] {
+                auto circuit = std::make_shared<Circuit>(makeEngine(), qubitCount, qubitCount);
+                addMixedGates(*circuit, qubitCount, gateCount);
+                return [circuit] {
+                    sink = circuit->getRepresentation().size();
+                };
+            }, static_cast<double>(gateCount), "gates");
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    Harness harness;
+    addGateCases(harness);
+    addSimulationCases(harness);
+    addAlgorithmCases(harness);
+    addAggregationCases(harness);
+    addConstructionCases(harness);
+    addRepresentationCases(harness);
+
+    Harness::Options options;
+    try {
+        options = Harness::parseOptions(argc, argv);
+    } catch (const Harness::InvalidOptionException &exception) {
+        std::cerr << exception.what() << "\n" << Harness::getUsage(argv[0]);
+        return 1;
+    }
+
+    if (options.help) {
+        std::cout << Harness::getUsage(argv[0]);
+        return 0;
+    }
+    if (options.list) {
+        for (const auto &name: harness.getNames(options.filter)) {
+            std::cout << name << "\n";
+        }
+        return 0;
+    }
+
+    if (options.outputPath.empty()) {
+        harness.run(options, std::cout, std::cerr);
+        return 0;
+    }
+    std::ofstream output(options.outputPath);
+    if (!output) {
+        std::cerr << "Cannot open " << options.outputPath << "\n";
+        return 1;
+    }
+    harness.run(options, output, std::cerr);
+    return 0;
+}
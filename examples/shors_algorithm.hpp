@@ -55,18 +55,10 @@ QPP::Circuit<double> CQFT(const std::shared_ptr<QPP::ProbabilityEngine<double>>&
     return circuit;
 }
 
-/// @brief Shor's Algorithm for N = 15
-///
-/// This example showcases the usage of the library to implement Shor's Algorithm
-/// Shor's Algorithm is a quantum algorithm that aims to find the period of a function defined as:
-/// f(x) = a^x mod N
-/// where a and N are integers and a is coprime to N
-/// The period of the function is the smallest positive integer r such that f(x) = f(x + r) = 1
-inline QPP::Circuit<double>::CompoundResult shorsAlgorithm(unsigned long a, unsigned long countingQubits, unsigned long repetitions = 1000) {
+/// @brief The circuit of Shor's Algorithm for N = 15, measuring the counting qubits
+inline QPP::Circuit<double> shorsCircuit(const std::shared_ptr<QPP::ProbabilityEngine<double>>& probabilityEngine, unsigned long a, unsigned long countingQubits) {
 
     // Create a Quantum Circuit with N counting qubits plus 4 qubits for U to act on.
-    const std::shared_ptr<QPP::ProbabilityEngine<double>> &probabilityEngine = std::make_shared<QPP::ProbabilityEngine<double>>();
-
     auto circuit = QPP::Circuit<double>(probabilityEngine, countingQubits + 4, countingQubits);
 
     // Initialize counting qubits to |+>
@@ -98,6 +90,18 @@ inline QPP::Circuit<double>::CompoundResult shorsAlgorithm(unsigned long a, unsi
     for (size_t i = 0; i < countingQubits; i++) {
         circuit.addMeasureGate({{i, i}});
     }
+    return circuit;
+}
+
+/// @brief Shor's Algorithm for N = 15
+///
+/// This example showcases the usage of the library to implement Shor's Algorithm
+/// Shor's Algorithm is a quantum algorithm that aims to find the period of a function defined as:
+/// f(x) = a^x mod N
+/// where a and N are integers and a is coprime to N
+/// The period of the function is the smallest positive integer r such that f(x) = f(x + r) = 1
+inline QPP::Circuit<double>::CompoundResult shorsAlgorithm(unsigned long a, unsigned long countingQubits, unsigned long repetitions = 1000) {
+    auto circuit = shorsCircuit(std::make_shared<QPP::ProbabilityEngine<double>>(), a, countingQubits);
 
     std::cout << circuit << std::endl;
     return circuit.simulate(repetitions);
@@ -0,0 +1,104 @@
+/// @file angle.hpp
+/// @brief This file contains the Angle class template.
+///
+/// An Angle is either a constant or an affine function of a single parameter, offset + coefficient × parameter, whose
+/// value is only known once the parameters of the circuit are bound. Circuits built with parametric angles can then be
+/// run for many parameter values without being rebuilt.
+///
+/// @author Mario Deaconescu
+
+#pragma once
+
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "probability.hpp"
+#include "representable.hpp"
+
+namespace QPP {
+
+/// @class Angle
+/// @brief A class template representing a constant angle or an affine function of a parameter.
+///
+/// Parameters are identified by their index in the vector of values bound to the circuit, so a sub-circuit using a
+/// parameter reads the value bound to its top-level circuit at that index.
+/// @tparam FloatingNumberType The type of the floating-point number used to represent the angle.
+    template<std_floating_point FloatingNumberType>
+    class Angle : public Representable {
+    private:
+        class UnboundParameterException : public std::runtime_error {
+        public:
+            UnboundParameterException(const size_t &parameter, const size_t &valueCount);
+
+        private:
+            const size_t parameter;
+            const size_t valueCount;
+        };
+
+        /// @brief The index of the parameter of a constant angle.
+        static constexpr size_t NO_PARAMETER = std::numeric_limits<size_t>::max();
+
+        size_t parameter = NO_PARAMETER;
+        FloatingNumberType coefficient = 0;
+        FloatingNumberType offset = 0;
+
+        Angle(const size_t &parameter, const FloatingNumberType &coefficient, const FloatingNumberType &offset);
+
+    public:
+        /// @brief Creates a constant angle.
+        /// @param value The angle, in radians.
+        Angle(const FloatingNumberType &value = 0);
+
+        /// @brief Creates the angle equal to a parameter.
+        /// @param index The index of the parameter in the bound values.
+        /// @return The parametric angle.
+        [[nodiscard]] static Angle Parameter(const size_t &index);
+
+        /// @brief Checks if the angle depends on a parameter.
+        [[nodiscard]] bool isParametric() const;
+
+        /// @brief Gets the index of the parameter the angle depends on. Only meaningful for parametric angles.
+        [[nodiscard]] size_t getParameter() const;
+
+        /// @brief Gets the factor the parameter is multiplied by. 0 for constant angles.
+        [[nodiscard]] FloatingNumberType getCoefficient() const;
+
+        /// @brief Gets the constant part of the angle.
+        [[nodiscard]] FloatingNumberType getOffset() const;
+
+        /// @brief Evaluates the angle.
+        /// @param values The values of the parameters.
+        /// @return The angle, in radians.
+        [[nodiscard]] FloatingNumberType evaluate(std::span<const FloatingNumberType> values) const;
+
+        Angle operator-() const;
+
+        Angle operator+(const FloatingNumberType &value) const;
+
+        Angle operator-(const FloatingNumberType &value) const;
+
+        Angle operator*(const FloatingNumberType &factor) const;
+
+        Angle operator/(const FloatingNumberType &divisor) const;
+
+        friend Angle operator+(const FloatingNumberType &value, const Angle &angle) {
+            return angle + value;
+        }
+
+        friend Angle operator-(const FloatingNumberType &value, const Angle &angle) {
+            return -angle + value;
+        }
+
+        friend Angle operator*(const FloatingNumberType &factor, const Angle &angle) {
+            return angle * factor;
+        }
+
+        /// @brief Gets the representation of the angle.
+        /// @return The value of a constant angle, or offset + coefficient×θ[parameter].
+        [[nodiscard]] std::string getRepresentation() const override;
+    };
+
+#include "templates/angle.tpp"
+
+}
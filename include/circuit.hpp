@@ -15,9 +15,35 @@
 #include<vector>
 #include<array>
 #include<map>
+#include<set>
+#include<algorithm>
+#include<utility>
+#include<numeric>
 #include<memory>
 #include<iostream>
+#include<sstream>
+#include<thread>
+#include<atomic>
+#include<exception>
+#include<limits>
+#include<span>
+#include<cstdint>
+#include<bit>
+#include<complex>
+#include<cstring>
+#include<charconv>
+#include<string_view>
+#include<numbers>
+#include<cctype>
+#include "angle.hpp"
 #include "qubit.hpp"
+#include "state_vector.hpp"
+#include "matrix_product_state.hpp"
+#include "sparse_state_vector.hpp"
+#include "tableau.hpp"
+#include "program.hpp"
+#include "histogram.hpp"
+#include "profile.hpp"
 
 namespace QPP {
 
@@ -34,16 +60,35 @@ namespace QPP {
     class Circuit : public Representable {
     public:
 
+        class Encoder;
+
+        class QASMWriter;
+
         class Gate : public Representable {
             friend class Circuit<FloatingNumberType>;
 
         public :
             [[nodiscard]] constexpr virtual const char* getSymbol() const = 0;
-            typedef std::vector<std::array<std::string, 3>> Drawings;
+
+            /// @brief The drawing of a gate: three lines of text for every row it spans, from firstRow down.
+            /// @details Row getQubitCount() holds the classic bits. Every line has the same display width, and the
+            /// rows outside the span are drawn as wires by the circuit.
+            struct Drawings {
+                size_t firstRow = 0;
+                std::vector<std::array<std::string, 3>> rows;
+            };
 
             /// @brief Applies the gate to the given circuitPointer.
+            /// @details The gate is compiled against the current state of the circuit and executed right away.
             /// @param circuit The circuitPointer to apply the gate to.
-            virtual void apply(Circuit<FloatingNumberType> *circuit) = 0;
+            virtual void apply(Circuit<FloatingNumberType> *circuit);
+
+            /// @brief Appends the instructions of the gate to a program.
+            /// @details Qubit and classic bit indices are resolved through the circuit, so that the instructions of
+            /// controlled gates and sub-circuits refer directly to the register.
+            /// @param circuit The circuitPointer the gate is compiled for.
+            /// @param program The program to append the instructions to.
+            virtual void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const = 0;
 
             /// @brief Clone the gate.
             /// @return A pointer to the cloned gate.
@@ -55,12 +100,57 @@ namespace QPP {
             /// @return True if the gate is valid, false otherwise.
             virtual void verify(const Circuit *circuit) const = 0;
 
+            /// @brief Get the qubits the gate acts on, including its quantum controls.
+            /// @return The qubit indices.
+            [[nodiscard]] virtual std::vector<size_t> getQubitIndices() const = 0;
+
+            /// @brief Replace every qubit index i of the gate, including its quantum controls, with qubitMap[i].
+            /// @details Used to move the gates of a sub-circuit onto the qubits of its parent. Classic bits are kept.
+            /// @param qubitMap The new index of every qubit the gate acts on.
+            virtual void remapQubits(const std::vector<size_t> &qubitMap) = 0;
+
+            /// @brief Get the gates equivalent to this gate once every sub-circuit is inlined.
+            /// @details Gates that do not contain a sub-circuit are returned as a single clone.
+            /// @return The flattened gates, acting on the qubits of the circuit the gate belongs to.
+            [[nodiscard]] virtual std::vector<std::unique_ptr<Gate>> flatten() const;
+
             /// @brief Get a controlled version of the gate.
             /// @param controlIndex The index of the control qubit.
             /// @return A pointer to the controlled gate.
             [[nodiscard]] std::unique_ptr<Gate>
             makeControlled(const size_t &controlIndex, const bool &classic = false) const;
 
+            /// @brief Check if the gate applies the same transformation on every run.
+            /// @details Deterministic gates do not measure qubits, read classic bits or have side effects.
+            /// @return True if the gate is deterministic, false otherwise.
+            [[nodiscard]] virtual bool isDeterministic() const;
+
+            /// @brief Check if the gate depends on parameters, whose values are only known once they are bound.
+            /// @details Parametric gates are never fused, so that binding new values does not need a new circuit.
+            /// @return True if the gate has a parametric angle, false otherwise.
+            [[nodiscard]] virtual bool isParametric() const;
+
+            /// @brief Check if the gate only permutes the basis states, without changing their amplitudes.
+            /// @details Permutation gates are reversible classical maps, like X, CX or Swap gates.
+            /// @return True if the gate is a permutation, false otherwise.
+            [[nodiscard]] virtual bool isPermutation() const;
+
+            /// @brief Applies the permutation of the gate to a basis state.
+            /// @details Only meaningful if isPermutation returns true.
+            /// @param basisState The basis state, in which bit i corresponds to qubit i of the circuit.
+            /// @return The image of the basis state.
+            [[nodiscard]] virtual size_t permuteBasisState(const size_t &basisState) const;
+
+            /// @brief Writes the gate in the binary circuit format.
+            /// @details Every gate of the library can be saved, except for Print gates.
+            /// @param encoder The encoder to write the gate to.
+            virtual void encode(Encoder &encoder) const;
+
+            /// @brief Writes the gate as OpenQASM 2 statements.
+            /// @details Gates with no equivalent in the standard library qelib1.inc throw an exception.
+            /// @param writer The writer to write the gate to.
+            virtual void writeQASM(QASMWriter &writer) const;
+
         protected:
             /// @brief Returns a standard string representation of the gate based on an identifier.
             /// @param identifier The identifier of the gate.
@@ -72,11 +162,23 @@ namespace QPP {
             /// @brief Returns a string representation of the gate.
             /// @return A string representation of the gate.
             [[nodiscard]] virtual Drawings getDrawings(const Circuit<FloatingNumberType> *circuit) const = 0;
+
+            /// @brief Repeats a glyph, which may take several bytes.
+            [[nodiscard]] static std::string repeatGlyph(const std::string &glyph, const size_t &count);
+
+            /// @brief Gets the number of columns a line takes on a terminal, i.e. its number of UTF-8 code points.
+            [[nodiscard]] static size_t getDisplayWidth(const std::string &line);
+
+            /// @brief Extends a drawing with wire rows until it spans a row.
+            /// @param drawings The drawing to extend.
+            /// @param row The row to span.
+            /// @param classicRow The row of the classic bits, drawn as a double wire.
+            static void extendDrawings(Drawings &drawings, const size_t &row, const size_t &classicRow);
         };
 
         class ControlledGate : public virtual Gate {
         protected:
-            const size_t controlIndex;
+            size_t controlIndex;
 
             [[nodiscard]] typename Gate::Drawings
             getStandardDrawing(const Circuit<FloatingNumberType> *circuit, const std::string &identifier,
@@ -85,6 +187,7 @@ namespace QPP {
         public:
             explicit ControlledGate(const size_t &controlIndex);
 
+            [[deprecated("Controlled gates are applied coherently. This collapses the control qubit.")]]
             [[nodiscard]] bool getControlState(Circuit<FloatingNumberType> *circuit) const;
 
             [[nodiscard]] size_t getControlIndex() const;
@@ -92,6 +195,165 @@ namespace QPP {
             void verify(const Circuit *circuit) const override;
         };
 
+        /// @brief The registers a circuit can run on.
+        enum Backend {
+            STATE_VECTOR, /**< A StateVector, for any circuit of at most a few dozen qubits. */
+            STABILIZER,           /**< A Tableau, for Clifford circuits of any size. */
+            MATRIX_PRODUCT_STATE, /**< A MatrixProductState, for wide circuits with little entanglement. */
+            SPARSE,               /**< A SparseStateVector, for circuits that keep few basis states populated. */
+            AUTOMATIC             /**< A Tableau if the circuit is Clifford, a StateVector otherwise. */
+        };
+
+        /// @brief Selects the part of a circuit drawn by draw(), to preview large circuits.
+        /// @details Only the gates of the window are laid out, keeping their order on every qubit, including the hidden
+        /// ones. Columns with no gate on the drawn rows are left out, and the row of the classic bits is always drawn.
+        struct DrawingWindow {
+            size_t firstGate = 0;
+            size_t gateCount = std::numeric_limits<size_t>::max();
+            size_t firstQubit = 0;
+            size_t qubitCount = std::numeric_limits<size_t>::max();
+        };
+
+        /// @brief The gates of a circuit, in order.
+        /// @details Gates are never modified once added, so they are shared by the copies of the circuit, by the
+        /// circuits it is added to and by the CircuitGates made from it.
+        using GateList = std::vector<std::shared_ptr<const Gate>>;
+
+        /// @class Encoder
+        /// @brief Writes circuits in the binary circuit format.
+        ///
+        /// The format is a sequence of 32-bit little-endian words, so that a file can be memory-mapped and read in
+        /// place. Floating-point values are stored as IEEE 754 doubles, in two words. A file holds a header (magic
+        /// number, version and number of circuits), the circuits, each as its qubit count, classic bit count, gate
+        /// count and gates, and the parameter values bound to the last one, which is the saved circuit. The circuits
+        /// before it are the sub-circuits of its CircuitGates, each written once however many gates share it, and
+        /// always before the circuits using it. A gate is its GateCode followed by its operands.
+        class Encoder {
+        public:
+            /// @brief The codes identifying the gate classes.
+            enum GateCode : std::uint32_t {
+                HADAMARD = 1,       /**< Target. */
+                CONTROLLED_HADAMARD, /**< Control and target. */
+                X,                  /**< Target. */
+                CX,                 /**< Control and target. */
+                Y,                  /**< Target. */
+                CY,                 /**< Control and target. */
+                Z,                  /**< Target. */
+                CZ,                 /**< Control and target. */
+                PHASE,              /**< Target and angle. */
+                CONTROLLED_PHASE,   /**< Control, target and angle. */
+                SWAP,               /**< Both qubits. */
+                MEASURE,            /**< Number of pairs, then every qubit and classic bit. */
+                INIT,               /**< Target, then the amplitudes of ❘0〉 and ❘1〉. */
+                CIRCUIT,            /**< Index of the sub-circuit, name, number of qubits and qubit indices. */
+                CUSTOM_CONTROLLED,  /**< Control, 1 if it is a classic bit and 0 otherwise, and the controlled gate. */
+                FUSED,              /**< Number of qubits, qubit indices and unitary, in row-major order. */
+                PERMUTATION         /**< Number of qubits, qubit indices and table. */
+            };
+
+            /// @brief Writes an unsigned integer, which must fit in 32 bits.
+            void writeWord(const size_t &word);
+
+            /// @brief Writes a floating-point number as a double.
+            void writeFloat(const FloatingNumberType &value);
+
+            /// @brief Writes the real and imaginary parts of a complex number.
+            void writeComplex(const std::complex<FloatingNumberType> &value);
+
+            /// @brief Writes an angle as its parameter (0xFFFFFFFF for constants), coefficient and offset.
+            void writeAngle(const Angle<FloatingNumberType> &angle);
+
+            /// @brief Writes the length of a string, then its bytes, padded to a whole number of words.
+            void writeString(const std::string &string);
+
+            /// @brief Writes a gate nested in another one.
+            void writeGate(const Gate &gate);
+
+            /// @brief Writes the index of a sub-circuit, encoding it first if it was not encoded yet.
+            void writeCircuit(const Circuit &circuit);
+
+        private:
+            /// @brief The encoded circuits, every circuit after its sub-circuits.
+            std::vector<std::vector<std::uint32_t>> circuits;
+
+            /// @brief The index of every encoded circuit, keyed by its gate list and its qubit and classic bit counts.
+            std::map<std::tuple<const GateList*, size_t, size_t>, size_t> circuitIndices;
+
+            /// @brief The words of the circuit being encoded.
+            std::vector<std::uint32_t> *words = nullptr;
+
+            /// @brief Encodes a circuit, unless it was already encoded.
+            /// @return The index of the circuit.
+            size_t encodeCircuit(const Circuit &circuit);
+
+            friend class Circuit;
+        };
+
+        /// @class QASMWriter
+        /// @brief Writes gates as OpenQASM 2 statements using the gates of qelib1.inc.
+        ///
+        /// Sub-circuits are inlined, and quantum controls are added to the names of the operations (x, cx, ccx), so
+        /// only the combinations defined by qelib1.inc can be written.
+        class QASMWriter {
+        public:
+            /// @brief Writes an operation on qubits of the circuit being written, adding the current controls.
+            /// @param name The name of the operation.
+            /// @param qubits The qubits the operation acts on.
+            /// @param parameters The parameters of the operation.
+            void writeOperation(const std::string &name, const std::vector<size_t> &qubits,
+                                const std::vector<FloatingNumberType> &parameters = {});
+
+            /// @brief Writes the measurement of a qubit into a classic bit.
+            void writeMeasure(const size_t &qubitIndex, const size_t &classicBitIndex);
+
+            /// @brief Writes the reset of a qubit to ❘0〉.
+            void writeReset(const size_t &qubitIndex);
+
+            /// @brief Writes a comment.
+            void writeComment(const std::string &comment);
+
+            /// @brief Writes a gate controlled by a qubit or by a classic bit.
+            void writeControlled(const size_t &controlIndex, const bool &classic, const Gate &gate);
+
+            /// @brief Writes the gates of a sub-circuit, moved onto qubits of the circuit being written.
+            void writeCircuit(const Circuit &circuit, const std::vector<size_t> &qubitIndices);
+
+            /// @brief Evaluates an angle with the parameter values of the written circuit.
+            [[nodiscard]] FloatingNumberType evaluate(const Angle<FloatingNumberType> &angle) const;
+
+            /// @brief Checks if the gates being written are controlled by qubits.
+            [[nodiscard]] bool isControlled() const;
+
+        private:
+            QASMWriter(std::ostream &stream, const size_t &qubitCount, const bool &splitClassicBits,
+                       std::span<const FloatingNumberType> parameterValues);
+
+            std::ostream &stream;
+
+            /// @brief Maps the qubits of the gates being written to qubits of the written circuit.
+            std::vector<size_t> qubitMap;
+
+            /// @brief The qubits of the written circuit controlling the gates being written.
+            std::vector<size_t> controls;
+
+            /// @brief The classic bit controlling the gates being written, or NO_CONDITION.
+            size_t condition;
+
+            /// @brief Whether every classic bit is a register of its own, so that it can be used in conditions.
+            bool splitClassicBits;
+
+            std::span<const FloatingNumberType> parameterValues;
+
+            static constexpr size_t NO_CONDITION = std::numeric_limits<size_t>::max();
+
+            [[nodiscard]] std::string getClassicBitName(const size_t &classicBitIndex) const;
+
+            /// @brief Writes the condition of the statement being written, if any.
+            void writeCondition();
+
+            friend class Circuit;
+        };
+
     private:
 
         class InvalidQubitIndexException : public std::runtime_error {
@@ -110,6 +372,248 @@ namespace QPP {
             const size_t index;
         };
 
+        class InvalidFusionWidthException : public std::runtime_error {
+        public:
+            explicit InvalidFusionWidthException(const size_t &width);
+
+        private:
+            const size_t width;
+        };
+
+        class TooManyClassicBitsException : public std::runtime_error {
+        public:
+            explicit TooManyClassicBitsException(const size_t &classicBitCount);
+
+        private:
+            const size_t classicBitCount;
+        };
+
+        class CircuitFormatException : public std::runtime_error {
+        public:
+            explicit CircuitFormatException(const std::string &reason);
+        };
+
+        class UnsupportedGateException : public std::runtime_error {
+        public:
+            explicit UnsupportedGateException(const std::string &reason);
+        };
+
+        class QASMParseException : public std::runtime_error {
+        public:
+            QASMParseException(const size_t &line, const std::string &reason);
+
+        private:
+            const size_t line;
+        };
+
+        /// @brief The first word of the binary circuit format, "QPPC" in ASCII.
+        static constexpr std::uint32_t FORMAT_MAGIC = 0x43505051;
+
+        /// @brief The version of the binary circuit format.
+        static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+        /// @brief The maximum number of qubits and classic bits of all the circuits of the binary data together, so
+        /// that a corrupted count is rejected before the registers are allocated.
+        static constexpr size_t FORMAT_MAX_BIT_COUNT = size_t(1) << 20;
+
+        /// @brief The maximum nesting depth of the controlled gates of the binary data, so that reading them cannot
+        /// overflow the stack.
+        static constexpr size_t FORMAT_MAX_NESTING_DEPTH = 64;
+
+        /// @class Decoder
+        /// @brief Reads circuits in the binary circuit format, in place.
+        class Decoder {
+        public:
+            Decoder(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine, std::span<const std::byte> data);
+
+            [[nodiscard]] size_t readWord();
+
+            [[nodiscard]] FloatingNumberType readFloat();
+
+            [[nodiscard]] std::complex<FloatingNumberType> readComplex();
+
+            [[nodiscard]] Angle<FloatingNumberType> readAngle();
+
+            [[nodiscard]] std::string readString();
+
+            [[nodiscard]] std::shared_ptr<Gate> readGate();
+
+            /// @brief Checks that the data holds at least wordCount more words, before they are allocated for.
+            void require(const size_t &wordCount) const;
+
+            std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine;
+            std::span<const std::byte> data;
+            size_t position = 0;
+
+            /// @brief The circuits read so far, which the CircuitGates refer to by index.
+            std::vector<std::shared_ptr<Circuit>> circuits;
+
+            /// @brief The number of controlled gates readGate is in.
+            size_t depth = 0;
+        };
+
+        /// @class QASMParser
+        /// @brief Parses OpenQASM 2 in a single pass, building the gates as the statements are read.
+        ///
+        /// The gates of qelib1.inc are mapped onto the gate classes of the library, and the gates defined in the
+        /// source become CircuitGates. The body of a definition is parsed where it appears, so it can only use the
+        /// gates defined before it, and its sub-circuit is built once for every list of parameter values.
+        class QASMParser {
+        public:
+            QASMParser(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine, std::string_view source);
+
+            /// @brief Parses the whole source.
+            /// @return The circuit.
+            [[nodiscard]] Circuit parse();
+
+        private:
+            struct Register {
+                size_t offset;
+                size_t size;
+            };
+
+            /// @brief The qubits an argument refers to: a single qubit, or a whole register broadcast over.
+            struct Argument {
+                size_t offset;
+                size_t size;
+            };
+
+            /// @brief A step of an expression, in postfix order.
+            struct Term {
+                enum Kind {
+                    NUMBER, PARAMETER, ADD, SUBTRACT, MULTIPLY, DIVIDE, POWER, NEGATE, FUNCTION
+                };
+                Kind kind;
+                FloatingNumberType number = 0;
+                size_t parameter = 0;
+                FloatingNumberType (*function)(FloatingNumberType) = nullptr;
+            };
+
+            /// @brief An expression of the parameters of a gate definition, evaluated when the gate is used.
+            using Expression = std::vector<Term>;
+
+            /// @brief The gates of qelib1.inc.
+            enum BuiltinOperation {
+                U3, U2, U1, RX, RY, RZ, SX, SXDG, X, Y, Z, H, S, SDG, T, TDG, ID, CX, CY, CZ, CH, SWAP, CU1, CRZ, CRX,
+                CRY, CU3, CCX, CSWAP
+            };
+
+            struct Builtin {
+                std::string_view name;
+                BuiltinOperation operation;
+                size_t parameterCount;
+                size_t qubitCount;
+            };
+
+            struct Definition;
+
+            /// @brief A gate applied in the body of a definition.
+            struct Statement {
+                const Builtin *builtin;
+                Definition *definition;
+                std::vector<Expression> parameters;
+                /// @brief The indices of the qubits of the definition the gate is applied to.
+                std::vector<size_t> qubits;
+            };
+
+            /// @brief A gate defined in the source.
+            struct Definition {
+                std::string name;
+                std::vector<std::string> parameters;
+                std::vector<std::string> qubits;
+                std::vector<Statement> body;
+                /// @brief The nesting depth of the sub-circuits of the gate, 1 if it only applies gates of qelib1.inc.
+                size_t depth = 1;
+                /// @brief The sub-circuit of the gate for every list of parameter values it was used with.
+                std::map<std::vector<FloatingNumberType>, std::shared_ptr<Circuit>> expansions;
+            };
+
+            /// @brief The maximum nesting depth of gate definitions, so that building their sub-circuits cannot
+            /// overflow the stack.
+            static constexpr size_t MAX_DEFINITION_DEPTH = 256;
+
+            std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine;
+            std::string_view source;
+            size_t position = 0;
+
+            std::map<std::string, Register, std::less<>> quantumRegisters;
+            std::map<std::string, Register, std::less<>> classicRegisters;
+            size_t qubitCount = 0;
+            size_t classicBitCount = 0;
+
+            /// @brief The gates defined so far. Their addresses are stable, so statements refer to them directly.
+            std::map<std::string, Definition, std::less<>> definitions;
+
+            /// @brief The definition whose body is being parsed, or null at the top level.
+            const Definition *definition = nullptr;
+
+            /// @brief The expression being read at the top level, reused from one operation to the next.
+            Expression expression;
+
+            /// @brief The stack of evaluate, reused from one expression to the next.
+            std::vector<FloatingNumberType> stack;
+
+            GateList gates;
+
+            [[noreturn]] void fail(const std::string &reason) const;
+
+            void skipSpace();
+
+            [[nodiscard]] bool accept(const char &character);
+
+            void expect(const char &character);
+
+            [[nodiscard]] std::string_view readIdentifier();
+
+            [[nodiscard]] size_t readInteger();
+
+            void readExpression(Expression &terms);
+
+            void readTerm(Expression &terms);
+
+            void readFactor(Expression &terms);
+
+            void readPrimary(Expression &terms);
+
+            /// @brief Evaluates an expression.
+            /// @param terms The expression.
+            /// @param parameterValues The values of the parameters of the definition it belongs to.
+            [[nodiscard]] FloatingNumberType evaluate(const Expression &terms,
+                                                      std::span<const FloatingNumberType> parameterValues);
+
+            [[nodiscard]] Argument readArgument(const bool &classic);
+
+            void parseStatement();
+
+            void parseRegister(const bool &classic);
+
+            void parseDefinition();
+
+            void parseOperation(const std::string_view &name, const std::vector<size_t> &conditions);
+
+            void parseMeasure(const std::vector<size_t> &conditions);
+
+            /// @brief Finds the gate of qelib1.inc with the given name.
+            /// @return The gate, or null if there is none.
+            [[nodiscard]] static const Builtin *findBuiltin(const std::string_view &name);
+
+            /// @brief Finds a gate defined before, or of qelib1.inc, and checks the number of its arguments.
+            void resolve(const std::string_view &name, const size_t &parameterCount, const size_t &qubitCount,
+                         const Builtin *&builtin, Definition *&gateDefinition);
+
+            /// @brief Adds a gate to a list, classically controlled by every bit of the conditions.
+            static void addGate(GateList &target, std::unique_ptr<Gate> gate, const std::vector<size_t> &conditions);
+
+            /// @brief Adds the gates of an operation applied to single qubits to a list.
+            void addOperation(GateList &target, const Builtin *builtin, Definition *gateDefinition,
+                              const std::vector<FloatingNumberType> &parameters, const std::vector<size_t> &qubits,
+                              const std::vector<size_t> &conditions);
+
+            /// @brief Builds the sub-circuit of a gate defined in the source, for some parameter values.
+            [[nodiscard]] std::shared_ptr<Circuit> expand(Definition &gateDefinition,
+                                                          const std::vector<FloatingNumberType> &parameters);
+        };
+
 
         template<typename DerivedGate>
         [[deprecated("Use gate.clone() instead")]]
@@ -120,31 +624,198 @@ namespace QPP {
 
         std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine;
 
-        std::vector<Qubit<FloatingNumberType>> qubits;
+        StateVector<FloatingNumberType> state;
+        Tableau<FloatingNumberType> tableau;
+        MatrixProductState<FloatingNumberType> matrixProductState;
+        SparseStateVector<FloatingNumberType> sparseState;
         std::vector<ClassicBit> classicBits;
-        std::vector<std::unique_ptr<Gate>> gates;
+
+        /// @brief The gates of the circuit.
+        /// @details Shared with the copies of the circuit, and copied by the first of them to add a gate.
+        std::shared_ptr<GateList> gates = std::make_shared<GateList>();
+
+        /// @brief The number of classic bits of the circuit.
+        /// @details classicBits can be longer, to hold the scratch classic bits of the compiled sub-circuits.
+        size_t classicBitCount;
+
+        /// @brief The compiled gates, or null if the gates changed since the last compilation.
+        /// @details Shared with the copies of the circuit until one of them binds new parameter values.
+        std::shared_ptr<Program<FloatingNumberType>> program;
+
+        /// @brief The values of the parameters of the parametric angles, by index.
+        std::vector<FloatingNumberType> parameterValues;
+
+        /// @brief The gates with every sub-circuit inlined, or null if the gates changed since they were flattened.
+        /// @details Shared by the copies of the circuit, so the CircuitGates made from it flatten it only once.
+        std::shared_ptr<const std::vector<std::unique_ptr<Gate>>> flattenedGates;
+
+        /// @brief Whether CircuitGates are inlined when they are added.
+        bool circuitGateInlining = false;
+
+        /// @brief Whether the gates are compiled with profiling instructions.
+        bool profiling = false;
+
+        /// @brief The profile of the last run or simulation, when profiling is enabled.
+        Profile profile;
+
+        /// @brief The register the circuit runs on.
+        Backend backend = STATE_VECTOR;
+
+        /// @brief The weight discarded by the matrix product state of the last run, or the largest one over the shots
+        /// of the last simulation.
+        FloatingNumberType discardedWeight = 0;
+
+        /// @brief Maps the qubit indices used by the running gates to qubits of the register.
+        /// @details This is the identity, except while the gates of a CircuitGate run on the register of its parent.
+        std::vector<size_t> qubitMap;
+
+        /// @brief Maps the qubits of the register to their position in the compiled state vector.
+        /// @details While compiling, an uncontrolled SwapGate only exchanges two entries instead of adding an
+        /// instruction. The layout is restored to the identity (see restoreLayout) wherever the caller reads the state.
+        std::vector<size_t> layout;
+
+        /// @brief Whether the gates currently being compiled are classically controlled.
+        bool classicallyControlled = false;
+
+        /// @brief The positions in the register of the qubits that control the gates currently being applied.
+        std::vector<size_t> controls;
+
+        /// @brief The classic bit corresponding to the classic bit 0 of the gates currently being compiled.
+        size_t classicBitOffset = 0;
+
+        /// @brief Gets the position in the state vector of a qubit index of the running gate.
+        /// @param qubitIndex The qubit index.
+        /// @return The position of the qubit, through the qubit map and the layout.
+        [[nodiscard]] size_t resolveQubit(const size_t &qubitIndex) const;
+
+        /// @brief Exchanges the positions of two qubits in the layout, which swaps them without touching the state.
+        /// @details Only valid for swaps that are neither quantum nor classically controlled.
+        /// @param qubitIndex1 The first qubit index of the running gate.
+        /// @param qubitIndex2 The second qubit index of the running gate.
+        void swapLayout(const size_t &qubitIndex1, const size_t &qubitIndex2);
+
+        /// @brief Adds the instructions moving every qubit back to its own position, and resets the layout.
+        /// @details A single transposition is restored with a swap. Larger permutations of at most
+        /// MAX_LAYOUT_PERMUTATION_WIDTH qubits are restored with a single permutation, and wider ones with swaps.
+        /// Programs compiled for the MATRIX_PRODUCT_STATE backend always use swaps, as a permutation would be applied
+        /// on a block of all the qubits it moves.
+        /// @param program The program to append the instructions to.
+        void restoreLayout(Program<FloatingNumberType> &program);
+
+        /// @brief The maximum number of displaced qubits restored with a single permutation.
+        static constexpr size_t MAX_LAYOUT_PERMUTATION_WIDTH = 12;
+
+        /// @brief Gets the classic bit corresponding to a classic bit index of the gate being compiled.
+        /// @param classicBitIndex The classic bit index.
+        /// @return The classic bit of the program.
+        [[nodiscard]] size_t resolveClassicBit(const size_t &classicBitIndex) const;
+
+        /// @brief Adds a qubit to the controls of the gates applied from now on.
+        /// @param qubitIndex The qubit index of the control.
+        /// @return The previous number of controls, to be restored with popControl.
+        size_t pushControl(const size_t &qubitIndex);
+
+        /// @brief Restores the controls.
+        /// @param previousControlCount The number returned by pushControl.
+        void popControl(const size_t &previousControlCount);
+
+        /// @brief Appends the instructions of a gate, or of a gate nested in another one, to a program.
+        /// @details When profiling is enabled, the instructions are surrounded by profiling instructions.
+        /// @param gate The gate.
+        /// @param program The program to append the instructions to.
+        void compileGate(const Gate &gate, Program<FloatingNumberType> &program);
+
+        /// @brief Appends a verified gate, inlining it if CircuitGate inlining is enabled.
+        /// @param gate The gate to append.
+        void appendGate(std::unique_ptr<Gate> gate);
+
+        /// @brief Gets the gates of the circuit for modification, copying them first if they are shared.
+        /// @details Only the list is copied: the gates themselves stay shared.
+        /// @return The gates, owned only by this circuit.
+        GateList &getMutableGates();
+
+        /// @brief Gets the gates of the circuit with every sub-circuit inlined, flattening them if needed.
+        /// @return The cached flattened gates.
+        const std::vector<std::unique_ptr<Gate>> &getFlattenedGates();
     public:
 
         /// @brief Holds the result of a circuitPointer run.
+        ///
+        /// The classic bits are packed into 64-bit words: classic bit i is bit i % 64 of word i / 64.
         /// @tparam FloatingNumberType The type of the floating-point number used to represent the probabilities.
         class Result : public Representable {
         private:
-            std::vector<ClassicBit> classicBits;
+            size_t bitCount;
+            std::vector<std::uint64_t> words;
         public:
+            /// @brief Creates a Result with the given number of classic bits, all 0.
+            /// @param bitCount The number of classic bits.
+            explicit Result(const size_t &bitCount = 0);
+
             /// @brief Creates a Result with the given vector of classic bits.
             /// @param classicBits The vector of classic bits.
             explicit Result(const std::vector<ClassicBit> &classicBits);
 
+            /// @brief Creates a Result with the first classic bits of a vector.
+            /// @param classicBits The vector of classic bits.
+            /// @param bitCount The number of classic bits to keep.
+            Result(const std::vector<ClassicBit> &classicBits, const size_t &bitCount);
+
+            /// @brief Creates a Result from packed words.
+            /// @param bitCount The number of classic bits.
+            /// @param words The packed classic bits.
+            Result(const size_t &bitCount, std::span<const std::uint64_t> words);
+
+            /// @brief Replaces the classic bits with the first classic bits of a vector.
+            /// @details The words are reused, so loading results of the same width does not allocate.
+            /// @param classicBits The vector of classic bits.
+            /// @param bitCount The number of classic bits to keep.
+            void load(const std::vector<ClassicBit> &classicBits, const size_t &bitCount);
+
+            /// @brief Returns the number of classic bits.
+            /// @return The number of classic bits.
+            [[nodiscard]] size_t getBitCount() const;
+
+            /// @brief Returns the state of a classic bit.
+            /// @param index The index of the classic bit.
+            /// @return True if the classic bit is 1, false otherwise.
+            [[nodiscard]] bool getBit(const size_t &index) const;
+
+            /// @brief Sets the state of a classic bit.
+            /// @param index The index of the classic bit.
+            /// @param value The state of the classic bit.
+            void setBit(const size_t &index, const bool &value);
+
+            /// @brief Returns the packed classic bits.
+            /// @return The words holding the classic bits.
+            [[nodiscard]] const std::vector<std::uint64_t> &getWords() const;
+
             /// @brief Returns a string representation of the result.
-            /// @return A string representation of the result.
+            /// @return A string representation of the result, with the last classic bit first.
             [[nodiscard]] std::string getRepresentation() const override;
         };
 
         /// @brief Holds the result of multiple circuitPointer runs.
+        ///
+        /// The results are counted in a Histogram keyed by their packed classic bits, so adding a result does not
+        /// format it. Strings are only built by getRepresentation.
         /// @tparam FloatingNumberType The type of the floating-point number used to represent the probabilities.
         class CompoundResult : public Representable {
         private:
-            std::map<std::string, size_t> resultMap;
+            Histogram histogram;
+
+            class ResultWidthMismatchException : public std::runtime_error {
+            public:
+                ResultWidthMismatchException(const size_t &expected, const size_t &actual);
+
+            private:
+                const size_t expected;
+                const size_t actual;
+            };
+
+            /// @brief Prepares the histogram for results of the given width.
+            /// @param bitCount The number of classic bits of the results.
+            void checkWidth(const size_t &bitCount);
         public:
             /// @brief Creates a CompoundResult with no results.
             CompoundResult();
@@ -160,19 +831,95 @@ namespace QPP {
             /// @brief Adds a result to the compound result.
             /// @param result The result to add.
             void addResult(const Result &result);
+
+            /// @brief Adds a result to the compound result a number of times.
+            /// @param result The result to add.
+            /// @param count The number of times the result was obtained.
+            void addResult(const Result &result, const size_t &count);
+
+            /// @brief Returns the number of times a result was obtained.
+            /// @param result The result.
+            /// @return The number of occurrences of the result.
+            [[nodiscard]] size_t getCount(const Result &result) const;
+
+            /// @brief Returns the total number of results.
+            /// @return The number of results that were added.
+            [[nodiscard]] size_t getShotCount() const;
+
+            /// @brief Returns the distinct results, in increasing order, with their number of occurrences.
+            /// @return The results and their counts.
+            [[nodiscard]] std::vector<std::pair<Result, size_t>> getResults() const;
+
+            /// @brief Adds the results of another compound result.
+            /// @param other The compound result to merge.
+            /// @return A reference to this compound result.
+            CompoundResult &operator+=(const CompoundResult &other);
+        };
+
+        /// @brief Holds the buffers needed to run a circuit, so that they can be reused from one run to the next.
+        ///
+        /// A workspace is not tied to a circuit: running a circuit on it only allocates when the circuit needs more
+        /// qubits or classic bits than any circuit run on it before, or, on the matrix product state backend, larger
+        /// tensors than the earlier runs reached. Measurements draw from the probability engine of the workspace, so
+        /// workspaces with engines of their own can be used from different threads.
+        class Workspace {
+        private:
+            std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine;
+            StateVector<FloatingNumberType> state;
+            Tableau<FloatingNumberType> tableau;
+            MatrixProductState<FloatingNumberType> matrixProductState;
+            SparseStateVector<FloatingNumberType> sparseState;
+            std::vector<ClassicBit> classicBits;
+            Result result;
+
+            /// @brief Calls a function with the register of the workspace used by a backend.
+            /// @param backend The backend, other than AUTOMATIC.
+            /// @param function The function, called with a reference to the register.
+            template<class Function>
+            void visitRegister(const Backend &backend, const Function &function);
+
+            friend class Circuit;
+        public:
+            /// @brief Creates an empty workspace.
+            /// @param probabilityEngine The probability engine used for measurements.
+            explicit Workspace(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine);
+
+            /// @brief Returns the result of the last run.
+            /// @return The result.
+            [[nodiscard]] const Result &getResult() const;
+
+            /// @brief Returns the state of the register after the last run.
+            /// @return The state vector.
+            [[nodiscard]] const StateVector<FloatingNumberType> &getState() const;
+
+            /// @brief Returns the stabilizer state of the register after the last run on the stabilizer backend.
+            /// @return The tableau.
+            [[nodiscard]] const Tableau<FloatingNumberType> &getTableau() const;
+
+            /// @brief Returns the state of the register after the last run on the matrix product state backend.
+            /// @return The matrix product state.
+            [[nodiscard]] const MatrixProductState<FloatingNumberType> &getMatrixProductState() const;
+
+            /// @brief Returns the state of the register after the last run on the sparse backend.
+            /// @return The sparse state vector.
+            [[nodiscard]] const SparseStateVector<FloatingNumberType> &getSparseState() const;
         };
 
         //#region Gates
 
         class SingleTargetGate : public virtual Gate {
         protected:
-            const size_t qubitIndex;
+            size_t qubitIndex;
 
             explicit SingleTargetGate(const size_t &targetIndex);
 
             void verify(const Circuit *circuit) const override;
         public:
             [[nodiscard]] size_t getTargetIndex() const;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
         };
 
         /// @class MeasureGate
@@ -195,7 +942,7 @@ namespace QPP {
         public:
 
             [[nodiscard]] constexpr const char* getSymbol() const override {
-                return "H";
+                return "M";
             }
 
             /// @brief Creates a MeasureGate with the given vector of qubit-classic bit pairs.
@@ -206,13 +953,28 @@ namespace QPP {
             /// @return A string representation of the measure gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the measure gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the measure gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the measure gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the measure gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] bool isDeterministic() const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
+
+            /// @brief Returns the measured qubit-classic bit pairs.
+            /// @return The vector of qubit-classic bit pairs.
+            [[nodiscard]] const std::vector<std::pair<size_t, size_t>> &getQubitClassicBitPairs() const;
         };
 
         /// @class HadamardGate
@@ -240,13 +1002,18 @@ namespace QPP {
             /// @return A string representation of the Hadamard gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the Hadamard gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the Hadamard gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the Hadamard gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Hadamard gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
         };
 
         /// @class ControlledHadamardGate
@@ -274,13 +1041,22 @@ namespace QPP {
             /// @return A string representation of the CNOT gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the CNOT gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the CNOT gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the CNOT gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the CNOT gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
         };
 
         /// @class XGate
@@ -307,13 +1083,22 @@ namespace QPP {
             /// @return A string representation of the NOT gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the NOT gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the NOT gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the NOT gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the NOT gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] bool isPermutation() const override;
+
+            [[nodiscard]] size_t permuteBasisState(const size_t &basisState) const override;
         };
 
         /// @class CXGate
@@ -341,13 +1126,26 @@ namespace QPP {
             /// @return A string representation of the CNOT gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the CNOT gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the CNOT gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the CNOT gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the CNOT gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
+
+            [[nodiscard]] bool isPermutation() const override;
+
+            [[nodiscard]] size_t permuteBasisState(const size_t &basisState) const override;
         };
 
         /// @class YGate
@@ -374,13 +1172,18 @@ namespace QPP {
             /// @return A string representation of the Y gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the Y gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the Y gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the Y gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Y gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
         };
 
         /// @class CYGate
@@ -408,13 +1211,22 @@ namespace QPP {
             /// @return A string representation of the CY gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the CY gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the CY gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the CY gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the CY gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
         };
 
         /// @class ZGate
@@ -441,13 +1253,18 @@ namespace QPP {
             /// @return A string representation of the Z gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the Z gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the Z gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the Z gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Z gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
         };
 
         /// @class CZGate
@@ -475,13 +1292,22 @@ namespace QPP {
             /// @return A string representation of the CZ gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the CZ gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the CZ gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the CZ gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the CZ gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
         };
 
         /// @class SwapGate
@@ -491,8 +1317,8 @@ namespace QPP {
         /// @tparam FloatingNumberType The type of the floating-point number used to represent the probabilities.
         class SwapGate : public virtual Gate {
         protected:
-            const size_t qubitIndex1;
-            const size_t qubitIndex2;
+            size_t qubitIndex1;
+            size_t qubitIndex2;
 
             [[nodiscard]] typename Gate::Drawings
             getDrawings(const Circuit<FloatingNumberType> *circuit) const override;
@@ -519,13 +1345,26 @@ namespace QPP {
             /// @return A string representation of the Swap gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the Swap gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the Swap gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the Swap gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Swap gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
+
+            [[nodiscard]] bool isPermutation() const override;
+
+            [[nodiscard]] size_t permuteBasisState(const size_t &basisState) const override;
         };
 
         /// @class CustomControlledGate
@@ -535,7 +1374,7 @@ namespace QPP {
         /// @tparam FloatingNumberType The type of the floating-point number used to represent the probabilities.
         class CustomControlledGate : public Gate {
         protected:
-            const size_t controlIndex;
+            size_t controlIndex;
             const bool classic;
             std::unique_ptr<Gate> gatePointer;
 
@@ -563,13 +1402,37 @@ namespace QPP {
             /// @return A string representation of the CustomControlledGate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the CustomControlledGate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the CustomControlledGate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the CustomControlledGate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the CustomControlledGate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
+
+            /// @brief Checks if the gate is controlled by a classic bit rather than by a qubit.
+            [[nodiscard]] bool isClassic() const;
+
+            /// @brief Flattens the controlled gate, controlling every gate of the result.
+            /// @return The flattened gates.
+            [[nodiscard]] std::vector<std::unique_ptr<Gate>> flatten() const override;
+
+            [[nodiscard]] bool isDeterministic() const override;
+
+            [[nodiscard]] bool isParametric() const override;
+
+            [[nodiscard]] bool isPermutation() const override;
+
+            [[nodiscard]] size_t permuteBasisState(const size_t &basisState) const override;
         };
 
         /// @class CircuitGate
@@ -639,13 +1502,35 @@ namespace QPP {
             /// @return A string representation of the Circuit gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the Circuit gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the Circuit gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the Circuit gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Circuit gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
+
+            /// @brief Returns the gates of the circuit, moved onto the qubit indices of the CircuitGate.
+            /// @details Circuits with classic bits keep their own scratch bits, so they are not flattened.
+            /// @return The flattened gates.
+            [[nodiscard]] std::vector<std::unique_ptr<Gate>> flatten() const override;
+
+            [[nodiscard]] bool isDeterministic() const override;
+
+            [[nodiscard]] bool isParametric() const override;
+
+            [[nodiscard]] bool isPermutation() const override;
+
+            [[nodiscard]] size_t permuteBasisState(const size_t &basisState) const override;
         };
 
         /// @class PhaseGate
@@ -655,7 +1540,7 @@ namespace QPP {
         /// @tparam FloatingNumberType The type of the floating-point number used to represent the probabilities.
         class PhaseGate : public virtual SingleTargetGate {
         protected:
-            double angle;
+            Angle<FloatingNumberType> angle;
 
             [[nodiscard]] typename Gate::Drawings
             getDrawings(const Circuit<FloatingNumberType> *circuit) const override;
@@ -668,19 +1553,27 @@ namespace QPP {
 
             /// @brief Creates a PhaseGate with the given qubit index.
             /// @param qubitIndex The qubit index.
-            explicit PhaseGate(const size_t &qubitIndex, const double &angle);
+            /// @param angle The angle of the phase, constant or parametric.
+            explicit PhaseGate(const size_t &qubitIndex, const Angle<FloatingNumberType> &angle);
 
             /// @brief Returns a string representation of the Phase gate.
             /// @return A string representation of the Phase gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the Phase gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the Phase gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the Phase gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Phase gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] bool isParametric() const override;
         };
 
         /// @class ControlledPhaseGate
@@ -702,19 +1595,28 @@ namespace QPP {
             /// @brief Creates a ControlledPhaseGate with the given control qubit index.
             /// @param controlQubitIndex The control qubit index.
             ControlledPhaseGate(const size_t &controlQubitIndex, const size_t &qubitIndex,
-                                         const double &angle);
+                                         const Angle<FloatingNumberType> &angle);
 
             /// @brief Returns a string representation of the Controlled Phase gate.
             /// @return A string representation of the Controlled Phase gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the Controlled Phase gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the Controlled Phase gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the Controlled Phase gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Controlled Phase gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
         };
 
         /// @class InitGate
@@ -747,13 +1649,20 @@ namespace QPP {
             /// @return A string representation of the Init gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the Init gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the Init gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the Init gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Init gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] bool isDeterministic() const override;
         };
 
         /// @class PrintGate
@@ -783,13 +1692,135 @@ namespace QPP {
             /// @return A string representation of the Print gate.
             [[nodiscard]] std::string getRepresentation() const override;
 
-            /// @brief Applies the Print gate to the given circuitPointer.
-            /// @param circuit The circuitPointer to apply the Print gate to.
-            void apply(Circuit<FloatingNumberType> *circuit) override;
+            /// @brief Compiles the Print gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Print gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
 
             void verify(const Circuit *circuit) const override;
 
             std::unique_ptr<Gate> clone() const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] bool isDeterministic() const override;
+        };
+
+        /// @class FusedGate
+        /// @brief A class representing a Fused gate.
+        ///
+        /// A Fused gate applies a precomputed unitary to a few qubits. It replaces a run of gates acting on those
+        /// qubits, so that the state is traversed only once. Fused gates are created by Circuit::fuseGates.
+        /// @tparam FloatingNumberType The type of the floating-point number used to represent the probabilities.
+        class FusedGate : public Gate {
+        public:
+            typedef typename StateVector<FloatingNumberType>::Amplitude Amplitude;
+
+        protected:
+            std::vector<size_t> qubitIndices;
+            const std::vector<Amplitude> matrix;
+
+            [[nodiscard]] typename Gate::Drawings
+            getDrawings(const Circuit<FloatingNumberType> *circuit) const override;
+
+        public:
+
+            [[nodiscard]] constexpr const char* getSymbol() const override {
+                return "U";
+            }
+
+            /// @brief Creates a FusedGate with the given qubit indices and unitary.
+            /// @param qubitIndices The qubit indices. Bit i of a row or column index of the matrix corresponds to qubitIndices[i].
+            /// @param matrix The 2^k x 2^k unitary matrix, in row-major order.
+            FusedGate(const std::vector<size_t> &qubitIndices, const std::vector<Amplitude> &matrix);
+
+            /// @brief Returns a string representation of the Fused gate.
+            /// @return A string representation of the Fused gate.
+            [[nodiscard]] std::string getRepresentation() const override;
+
+            /// @brief Compiles the Fused gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Fused gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
+
+            void verify(const Circuit *circuit) const override;
+
+            std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            void writeQASM(QASMWriter &writer) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
+
+            /// @brief Returns the unitary of the Fused gate.
+            /// @return The 2^k x 2^k unitary matrix, in row-major order.
+            [[nodiscard]] const std::vector<Amplitude> &getMatrix() const;
+        };
+
+        /// @class PermutationGate
+        /// @brief A class representing a Permutation gate.
+        ///
+        /// A Permutation gate applies a reversible classical map to a few qubits, stored as the image of each of their
+        /// basis states. It replaces a run of X, CX, Swap and similar gates, so that the state is traversed only once.
+        /// Permutation gates are created by Circuit::collapsePermutations.
+        /// @tparam FloatingNumberType The type of the floating-point number used to represent the probabilities.
+        class PermutationGate : public Gate {
+        protected:
+            std::vector<size_t> qubitIndices;
+            const std::vector<size_t> table;
+
+            [[nodiscard]] typename Gate::Drawings
+            getDrawings(const Circuit<FloatingNumberType> *circuit) const override;
+
+            class InvalidPermutationException : public std::runtime_error {
+            public:
+                explicit InvalidPermutationException(const size_t &qubitCount);
+
+            private:
+                const size_t qubitCount;
+            };
+
+        public:
+
+            [[nodiscard]] constexpr const char* getSymbol() const override {
+                return "PERM";
+            }
+
+            /// @brief Creates a PermutationGate with the given qubit indices and table.
+            /// @param qubitIndices The qubit indices. Bit i of an entry of the table corresponds to qubitIndices[i].
+            /// @param table The image of each of the 2^k basis states of the qubits.
+            PermutationGate(const std::vector<size_t> &qubitIndices, const std::vector<size_t> &table);
+
+            /// @brief Returns a string representation of the Permutation gate.
+            /// @return A string representation of the Permutation gate.
+            [[nodiscard]] std::string getRepresentation() const override;
+
+            /// @brief Compiles the Permutation gate for the given circuitPointer.
+            /// @param circuit The circuitPointer to compile the Permutation gate for.
+            /// @param program The program to append the instructions to.
+            void compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const override;
+
+            /// @details Also checks that the table is a permutation of the basis states of the qubits.
+            void verify(const Circuit *circuit) const override;
+
+            std::unique_ptr<Gate> clone() const override;
+
+            void encode(Encoder &encoder) const override;
+
+            [[nodiscard]] std::vector<size_t> getQubitIndices() const override;
+
+            void remapQubits(const std::vector<size_t> &qubitMap) override;
+
+            [[nodiscard]] bool isPermutation() const override;
+
+            [[nodiscard]] size_t permuteBasisState(const size_t &basisState) const override;
+
+            /// @brief Returns the table of the Permutation gate.
+            /// @return The image of each of the 2^k basis states of the qubits.
+            [[nodiscard]] const std::vector<size_t> &getTable() const;
         };
 
         //#endregion
@@ -808,17 +1839,129 @@ namespace QPP {
 
         Circuit(const Circuit &other);
 
+        /// @brief Creates a copy of a circuit that uses a different probability engine.
+        /// @param other The circuit to copy.
+        /// @param probabilityEngine The probability engine to use.
+        Circuit(const Circuit &other, std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine);
+
         Circuit &operator=(const Circuit &other);
 
         /// @brief Returns a drawing representation of the circuit.
         /// @return A drawing representation of the circuit.
         [[nodiscard]] std::string getRepresentation() const override;
 
+        /// @brief Draws the circuit to a stream.
+        ///
+        /// Gates acting on disjoint rows are packed into the same column, and every gate only draws the rows it spans,
+        /// so the cost grows with the size of the drawing rather than with the number of gates times the number of
+        /// qubits. The lines are written to the stream one after the other, without building the whole drawing.
+        /// @param stream The stream to write the drawing to.
+        void draw(std::ostream &stream) const;
+
+        /// @brief Draws part of the circuit to a stream.
+        /// @param stream The stream to write the drawing to.
+        /// @param window The gates and qubits to draw.
+        void draw(std::ostream &stream, const DrawingWindow &window) const;
+
+        friend std::ostream &operator<<(std::ostream &stream, const Circuit &circuit) {
+            circuit.draw(stream);
+            return stream;
+        }
+
         /// @brief Resets the circuit.
         ///
         /// @details Resets the circuit by resetting the qubits.
         void reset();
 
+        /// @brief Enables or disables the inlining of CircuitGates.
+        ///
+        /// When enabled, a CircuitGate added with addGate or addCircuitGate, or a controlled version of one built with
+        /// makeControlled, is replaced by the gates of its circuit moved onto its qubit indices. Nested sub-circuits
+        /// are inlined as well, and the flattened gates of a circuit are cached, so repeated uses of the same
+        /// sub-circuit only remap them. Sub-circuits with classic bits are always kept as CircuitGates.
+        /// Gates added before the call are not affected.
+        /// @param enabled True to inline CircuitGates, false to keep them as single gates.
+        void setCircuitGateInlining(const bool &enabled);
+
+        /// @brief Checks if CircuitGates are inlined when they are added.
+        /// @return True if CircuitGate inlining is enabled, false otherwise.
+        [[nodiscard]] bool isCircuitGateInlining() const;
+
+        /// @brief Enables or disables the profiling of runs and simulations.
+        ///
+        /// When enabled, the circuit is compiled with instructions recording, for every class of gate, the number of
+        /// applications, their cumulative and longest wall time, and the measurements and probability draws they
+        /// made. Gates nested in CircuitGates and CustomControlledGates are recorded under their parent gate.
+        /// The profile of the last run or simulation is returned by getProfile.
+        ///
+        /// Profiled gates are not batched together by the compiler, and when a simulation uses several threads,
+        /// the times of the gates add up the time spent by every thread. When disabled, the compiled program does
+        /// not contain any profiling instruction.
+        /// @param enabled True to profile the runs, false otherwise.
+        void setProfiling(const bool &enabled);
+
+        /// @brief Checks if the runs and simulations are profiled.
+        /// @return True if profiling is enabled, false otherwise.
+        [[nodiscard]] bool isProfiling() const;
+
+        /// @brief Gets the profile of the last run or simulation.
+        /// @return The profile, empty if profiling was disabled.
+        [[nodiscard]] const Profile &getProfile() const;
+
+        /// @brief Selects the register the circuit runs on.
+        ///
+        /// Circuits made only of Clifford operations (H, X, Y, Z, CX, CY, CZ, Swap, Phase gates with a multiple of
+        /// pi / 2 as angle, Controlled Phase gates with a multiple of pi, measurements, Init gates preparing one of
+        /// the six Pauli eigenstates, and classically controlled or nested versions of them) can run on a stabilizer
+        /// Tableau, whose memory grows with the square of the qubit count instead of exponentially. A run gives the
+        /// same result on both registers for the same seed.
+        ///
+        /// Running a circuit that is not Clifford on the STABILIZER backend throws a NonCliffordOperationException.
+        ///
+        /// Any circuit can run on the MATRIX_PRODUCT_STATE backend, whose memory and time grow with the entanglement
+        /// of the state rather than with the qubit count. Its bonds are truncated as set by setTruncation, and
+        /// getDiscardedWeight tells how far the results may be from the exact ones. Programs compiled for it only
+        /// batch the diagonal gates of adjacent qubits.
+        ///
+        /// The SPARSE backend only stores the populated basis states, which suits circuits that act on a few basis
+        /// states at a time, such as modular arithmetic. It becomes dense by itself when the populated states exceed
+        /// the fill ratio set by setSparsity.
+        ///
+        /// Gates applied directly with Gate::apply always act on the state vector.
+        /// @param backend_ The backend.
+        void setBackend(const Backend &backend_);
+
+        /// @brief Gets the register the circuit runs on.
+        /// @return The backend.
+        [[nodiscard]] Backend getBackend() const;
+
+        /// @brief Checks if every gate of the circuit is a Clifford operation, so that it can run on the STABILIZER
+        /// backend.
+        /// @details The check is made on the compiled program, so the circuit is compiled if needed.
+        /// @return True if the circuit is Clifford, false otherwise.
+        [[nodiscard]] bool isClifford();
+
+        /// @brief Sets the limits of the bond dimensions of the MATRIX_PRODUCT_STATE backend.
+        /// @details By default, the bonds are never truncated, so the runs are exact but may grow exponentially.
+        /// @param truncation The maximum bond dimension and the weight that can be dropped at each bond.
+        void setTruncation(const typename MatrixProductState<FloatingNumberType>::Truncation &truncation);
+
+        /// @brief Gets the limits of the bond dimensions of the MATRIX_PRODUCT_STATE backend.
+        /// @return The truncation.
+        [[nodiscard]] const typename MatrixProductState<FloatingNumberType>::Truncation &getTruncation() const;
+
+        /// @brief Gets the weight discarded by the truncations of the MATRIX_PRODUCT_STATE backend.
+        /// @return The discarded weight of the last run, or the largest one over the shots of the last simulation.
+        [[nodiscard]] FloatingNumberType getDiscardedWeight() const;
+
+        /// @brief Sets when the SPARSE backend drops amplitudes and when it becomes dense.
+        /// @param sparsity The pruning threshold and the fill ratio.
+        void setSparsity(const typename SparseStateVector<FloatingNumberType>::Sparsity &sparsity);
+
+        /// @brief Gets when the SPARSE backend drops amplitudes and when it becomes dense.
+        /// @return The sparsity.
+        [[nodiscard]] const typename SparseStateVector<FloatingNumberType>::Sparsity &getSparsity() const;
+
         //#region Gate Adders
 
         /// @brief Adds an already constructed CircuitGate to the circuit.
@@ -826,6 +1969,7 @@ namespace QPP {
         void addGate(std::unique_ptr<CircuitGate> gate, const std::vector<size_t> &qubitIndices);
 
         /// @brief Adds a gate to the circuit.
+        /// @details The gate is verified against the circuit unless validation is disabled (see VALIDATION_POLICY).
         /// @param gate The pointer to the gate to add.
         void addGate(std::unique_ptr<Gate> gate);
 
@@ -881,13 +2025,15 @@ namespace QPP {
 
         /// @brief Adds a Phase gate to the circuit.
         /// @param qubitIndex The qubit index.
-        void addPhaseGate(const size_t &qubitIndex, const FloatingNumberType &angle);
+        /// @param angle The angle of the phase, constant or parametric.
+        void addPhaseGate(const size_t &qubitIndex, const Angle<FloatingNumberType> &angle);
 
         /// @brief Adds a Controlled Phase gate to the circuit.
         /// @param controlQubitIndex The control qubit index.
         /// @param targetQubitIndex The target qubit index.
+        /// @param angle The angle of the phase, constant or parametric.
         void addControlledPhaseGate(const size_t &controlQubitIndex, const size_t &targetQubitIndex,
-                                    const FloatingNumberType &angle);
+                                    const Angle<FloatingNumberType> &angle);
 
         void addInitGate(const size_t &qubitIndex, const typename Qubit<FloatingNumberType>::State &state);
 
@@ -907,22 +2053,255 @@ namespace QPP {
 
         /// @brief Returns the gates.
         /// @return The gates.
-        [[nodiscard]] const std::vector<std::unique_ptr<Gate>> &getGates() const;
+        [[nodiscard]] const GateList &getGates() const;
+
+        /// @brief Returns the state of the register after the last run.
+        /// @return The state vector.
+        [[nodiscard]] const StateVector<FloatingNumberType> &getState() const;
+
+        /// @brief Returns the stabilizer state of the register after the last run on the stabilizer backend.
+        /// @return The tableau.
+        [[nodiscard]] const Tableau<FloatingNumberType> &getTableau() const;
+
+        /// @brief Returns the state of the register after the last run on the matrix product state backend.
+        /// @return The matrix product state.
+        [[nodiscard]] const MatrixProductState<FloatingNumberType> &getMatrixProductState() const;
+
+        /// @brief Returns the state of the register after the last run on the sparse backend.
+        /// @return The sparse state vector.
+        [[nodiscard]] const SparseStateVector<FloatingNumberType> &getSparseState() const;
 
         //#endregion
 
+        /// @brief Appends the gates of another circuit.
+        /// @details The gates are shared with the other circuit rather than cloned.
         Circuit &operator+=(const Circuit &other);
 
+        /// @brief Wraps the circuit in a CircuitGate.
+        /// @details The CircuitGate shares the gates of the circuit, so later changes to the circuit do not affect it.
         CircuitGate toGate() const;
 
+        /// @brief Saves the circuit in the binary circuit format described by Encoder.
+        /// @details The gates, the sub-circuits of the CircuitGates, the classical controls and the bound parameter
+        /// values are saved. Settings such as the backend are not. Print gates cannot be saved.
+        /// @param stream The stream to write to, opened in binary mode.
+        void save(std::ostream &stream) const;
+
+        /// @brief Loads a circuit saved with save().
+        /// @details The data is read in place, so it can be a memory-mapped file. Sub-circuits shared by several
+        /// CircuitGates stay shared.
+        /// @param probabilityEngine The probability engine of the circuit.
+        /// @param data The saved circuit.
+        /// @return The circuit.
+        [[nodiscard]] static Circuit load(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                          std::span<const std::byte> data);
+
+        /// @brief Loads a circuit saved with save() from a stream.
+        /// @param probabilityEngine The probability engine of the circuit.
+        /// @param stream The stream to read from, opened in binary mode.
+        /// @return The circuit.
+        [[nodiscard]] static Circuit load(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                          std::istream &stream);
+
+        /// @brief Writes the circuit as an OpenQASM 2 program using the gates of qelib1.inc.
+        ///
+        /// Sub-circuits are inlined and parametric angles are evaluated with the bound values. Init gates become a
+        /// reset followed by a u3 preparing the state, and single-qubit fused gates a u3, up to a global phase.
+        /// Classic bits are declared as a register c, unless a gate is classically controlled: OpenQASM 2 conditions
+        /// compare whole registers, so every bit is then a register of its own, c0, c1 and so on.
+        /// @param stream The stream to write to.
+        void writeQASM(std::ostream &stream) const;
+
+        /// @brief Gets the circuit as an OpenQASM 2 program.
+        /// @return The program, as written by writeQASM.
+        [[nodiscard]] std::string toQASM() const;
+
+        /// @brief Builds a circuit from an OpenQASM 2 program.
+        ///
+        /// The registers are laid out one after the other, in the order they are declared. The gates of qelib1.inc
+        /// are mapped onto the gates of the library (u3, u2, rx, ry and sx as single-qubit fused gates, rz as a Phase
+        /// gate, up to a global phase), and the gates defined in the program become CircuitGates. Conditions can only
+        /// require classic bits to be 1, and opaque gates are not supported.
+        /// @param probabilityEngine The probability engine of the circuit.
+        /// @param source The program.
+        /// @return The circuit.
+        [[nodiscard]] static Circuit fromQASM(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                              std::string_view source);
+
+        /// @brief Creates an equivalent circuit in which runs of deterministic gates are fused.
+        ///
+        /// Consecutive gates are grouped into blocks acting on at most maxFusedWidth qubits, and each block of two or
+        /// more gates is replaced by a FusedGate holding its precomputed unitary. Blocks on disjoint qubits are grouped
+        /// independently, so gates do not need to be adjacent in the gate list to be fused. Measurements, Init gates,
+        /// Print gates and classically controlled gates are never fused and keep their order.
+        ///
+        /// A width of 1 only merges single-qubit gates. Larger widths also merge controlled gates, swaps and small
+        /// CircuitGates with their neighbours, at the cost of a 4^width matrix per fused block.
+        /// @param maxFusedWidth The maximum number of qubits of a fused block.
+        /// @return The fused circuit.
+        [[nodiscard]] Circuit fuseGates(const size_t &maxFusedWidth = 1) const;
+
+        /// @brief Creates an equivalent circuit in which runs of permutation gates are collapsed.
+        ///
+        /// Consecutive gates that only permute the basis states (X, CX, Swap, quantum controlled versions of them and
+        /// CircuitGates made only of them) are grouped while they act on at most maxPermutationWidth qubits, and each
+        /// group is replaced by a PermutationGate. Applying it is a single gather pass over the amplitudes, instead of
+        /// one pass per gate. Single gates are only replaced if they expand to several gates, like CircuitGates.
+        ///
+        /// The table of a PermutationGate has 2^width entries, so wide groups trade memory for passes.
+        /// @param maxPermutationWidth The maximum number of qubits of a PermutationGate.
+        /// @return The collapsed circuit.
+        [[nodiscard]] Circuit collapsePermutations(const size_t &maxPermutationWidth = 12) const;
+
+        /// @brief Compiles the gates into a Program.
+        ///
+        /// The program is cached until the gates of the circuit change, and shared by the copies of the circuit.
+        /// run and simulate compile the circuit automatically.
+        /// @return The compiled program.
+        std::shared_ptr<const Program<FloatingNumberType>> compile();
+
         /// @brief Runs the circuitPointer.
         /// @return The result of the circuitPointer.
         Result run();
 
+        /// @brief Runs the circuit from ❘0...0〉 on a workspace.
+        ///
+        /// Once the circuit is compiled and the workspace is large enough, a run does not allocate memory or copy
+        /// shared pointers.
+        /// @param workspace The workspace holding the register and classic bits.
+        /// @return The result of the run, held by the workspace until its next run.
+        const Result &run(Workspace &workspace);
+
         /// @brief Simulates the circuitPointer a number of times.
+        ///
+        /// On the state vector backend, when every measurement is at the end of the circuit and all the other gates
+        /// are deterministic, the circuit is evolved once and the shots are sampled from the resulting distribution.
+        /// In that case, the state of the circuit after the simulation is the one before the measurements.
+        ///
+        /// Otherwise, and on the other backends, the shots are split into blocks of SHOT_BLOCK_SIZE, each drawing from its own substream of the
+        /// probability engine, and the blocks are run by a pool of threads on private copies of the circuit.
+        /// The result only depends on the seed of the probability engine, not on the number of threads.
+        ///
+        /// Each thread evolves the instructions before the first measurement or Init gate with an uncertain outcome
+        /// once, and restores the resulting register at the start of every shot, so that only the rest of the circuit
+        /// is replayed. The results are the same as when every shot runs the whole circuit.
         /// @param count The number of times to simulate the circuitPointer.
+        /// @param threadCount The number of threads to use (0 uses one thread per hardware core).
         /// @return The compound result of the simulation.
-        CompoundResult simulate(const size_t &count);
+        CompoundResult simulate(const size_t &count, const size_t &threadCount = 1);
+
+        /// @brief The number of consecutive shots that share a substream of the probability engine.
+        static constexpr size_t SHOT_BLOCK_SIZE = 64;
+
+        /// @brief Computes the exact probability of every outcome of the classic bits, without sampling.
+        ///
+        /// The circuit is run once up to its terminal measurements, splitting into one branch per outcome of every
+        /// measurement or Init gate whose outcome is uncertain, so circuits without mid-circuit measurements are
+        /// evolved once. The terminal measurements are then read from the distribution of the measured qubits of each
+        /// branch. Outcomes that the probability engine compares equal to 0 are left out.
+        ///
+        /// The probabilities are computed on a SparseStateVector on the SPARSE backend, and on a StateVector on all the
+        /// others. The state of the circuit and the probability engine are left untouched.
+        /// @return The probability of every possible outcome, keyed by the classic bits, bit i being classic bit i.
+        [[nodiscard]] std::map<size_t, FloatingNumberType> probabilities();
+
+        /// @brief Computes the exact probability of every outcome of measuring some qubits at the end of the circuit.
+        /// @details The branches are followed as for probabilities(), and their distributions of the qubits are added.
+        /// @param qubitIndices The measured qubits. Bit i of an outcome corresponds to qubitIndices[i].
+        /// @return The probability of each of the 2^k outcomes.
+        [[nodiscard]] std::vector<FloatingNumberType> probabilities(const std::vector<size_t> &qubitIndices);
+
+        /// @brief Sets the values of the parameters of the parametric angles.
+        ///
+        /// The gates are left as they are: once the circuit is compiled, binding only recomputes the phases of the
+        /// parametric instructions of its program. Running a circuit whose parametric angles use a parameter without a
+        /// value throws an exception.
+        /// @param values The value of every parameter, by index.
+        void bind(const std::vector<FloatingNumberType> &values);
+
+        /// @brief Gets the values of the parameters bound by the last call to bind.
+        [[nodiscard]] const std::vector<FloatingNumberType> &getParameterValues() const;
+
+        /// @brief Simulates the circuit for several values of its parameters.
+        /// @details The circuit is compiled once, and each point only binds its values and runs simulate.
+        /// @param points The values of the parameters of every point.
+        /// @param count The number of shots of every point.
+        /// @param threadCount The number of threads to use (0 uses one thread per hardware core).
+        /// @return The compound result of every point. The circuit stays bound to the last point.
+        std::vector<CompoundResult> sweep(const std::vector<std::vector<FloatingNumberType>> &points,
+                                          const size_t &count, const size_t &threadCount = 1);
+
+        /// @brief Computes the exact distribution of the classic bits for several values of its parameters.
+        /// @details The circuit is compiled once, and each point only binds its values and runs probabilities.
+        /// @param points The values of the parameters of every point.
+        /// @return The distribution of every point. The circuit stays bound to the last point.
+        std::vector<std::map<size_t, FloatingNumberType>> sweepProbabilities(const std::vector<std::vector<FloatingNumberType>> &points);
+
+    private:
+        /// @brief Gets the index of the first gate of the block of measurements that ends the circuit.
+        /// @return The index of the first terminal MeasureGate, or the gate count if the circuit does not end in one.
+        [[nodiscard]] size_t getTerminalMeasurementsStart() const;
+
+        /// @brief Checks if the shots can be sampled from a single evolution of the circuit.
+        /// @return True if all the gates before the terminal measurements are deterministic, false otherwise.
+        [[nodiscard]] bool hasOnlyTerminalMeasurements() const;
+
+        /// @brief Runs the circuit up to its terminal measurements on every branch of its measurement outcomes.
+        /// @param leaf The function called with the register, the classic bits and the probability of every branch.
+        template<class Leaf>
+        void visitBranches(const Leaf &leaf);
+
+        /// @brief Evolves the circuit up to its terminal measurements and samples the measured qubits.
+        /// @param count The number of shots.
+        /// @param profile_ The profile recording the run, or null.
+        /// @return The compound result of the shots.
+        CompoundResult sampleTerminalMeasurements(const size_t &count, Profile *profile_);
+
+        /// @brief Runs every shot separately, on a pool of threads sharing the compiled program.
+        /// @param count The number of shots.
+        /// @param threadCount The number of threads to use (0 uses one thread per hardware core).
+        /// @param compiled The compiled program.
+        /// @param backend_ The backend the shots run on, other than AUTOMATIC.
+        /// @param profile_ The profile the profiles of the threads are added to, or null.
+        /// @return The compound result of the shots.
+        CompoundResult runShots(const size_t &count, const size_t &threadCount,
+                                const std::shared_ptr<const Program<FloatingNumberType>> &compiled,
+                                const Backend &backend_, Profile *profile_);
+
+        /// @brief Gets the backend the runs use, resolving AUTOMATIC.
+        /// @return The backend, other than AUTOMATIC.
+        [[nodiscard]] Backend getRunBackend();
+
+        /// @brief Gets the compiled program, compiling the circuit if needed.
+        /// @return The cached program.
+        const Program<FloatingNumberType> &getProgram();
+
+        /// @brief Prepares a workspace for a program of this circuit.
+        /// @param program The compiled program.
+        /// @param workspace The workspace.
+        /// @param backend_ The backend whose register is used, other than AUTOMATIC.
+        void prepareWorkspace(const Program<FloatingNumberType> &program, Workspace &workspace,
+                              const Backend &backend_) const;
+
+        /// @brief Runs a single shot of a program on a prepared workspace.
+        /// @param program The compiled program.
+        /// @param workspace The workspace.
+        /// @param backend_ The backend whose register is used, other than AUTOMATIC.
+        /// @param profile_ The profile recording the shot, or null.
+        void runShot(const Program<FloatingNumberType> &program, Workspace &workspace, const Backend &backend_,
+                     Profile *profile_ = nullptr) const;
+
+        /// @brief Gets the result held by the classic bits of the circuit.
+        /// @return The result.
+        [[nodiscard]] Result getResult() const;
+
+        /// @brief Computes the unitary applied by a sequence of deterministic gates on a few qubits.
+        /// @details The gates are run on every basis state of a register made only of the given qubits.
+        /// @param qubitIndices The qubits the gates act on. Bit i of a basis state corresponds to qubitIndices[i].
+        /// @param blockGates The gates, in order.
+        /// @return The 2^k x 2^k unitary matrix, in row-major order.
+        [[nodiscard]] std::vector<typename StateVector<FloatingNumberType>::Amplitude>
+        getBlockUnitary(const std::vector<size_t> &qubitIndices, const GateList &blockGates) const;
     };
 
 
@@ -939,6 +2318,10 @@ namespace QPP {
 #include "templates/circuit_gate.tpp"
 #include "templates/phase.tpp"
 #include "templates/control.tpp"
+#include "templates/fused.tpp"
+#include "templates/permutation.tpp"
+#include "templates/serialization.tpp"
+#include "templates/qasm.tpp"
 
 }
 
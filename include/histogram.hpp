@@ -0,0 +1,76 @@
+/**
+ * @file histogram.hpp
+ * @brief This file contains the Histogram class.
+ * @author Mario Deaconescu
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace QPP {
+
+/**
+ * @class Histogram
+ * @brief Counts the occurrences of fixed-width bit strings.
+ *
+ * A key is a bit string stored as little-endian 64-bit words (bit i of the key is bit i % 64 of word i / 64).
+ * Histograms of at most DENSE_BIT_LIMIT bits use a dense array indexed by the key, allocated on the first insertion.
+ * Wider histograms use an open-addressing hash table with linear probing, so memory grows with the number of
+ * distinct keys instead of the width.
+ */
+    class Histogram {
+    public:
+        /// \brief The widest keys counted in a dense array
+        static constexpr std::size_t DENSE_BIT_LIMIT = 20;
+
+        /// \brief Creates an empty histogram
+        /// \param bitCount The width of the keys
+        explicit Histogram(const std::size_t &bitCount = 0);
+
+        /// \brief Gets the width of the keys
+        [[nodiscard]] std::size_t getBitCount() const;
+
+        /// \brief Gets the number of words of a key
+        [[nodiscard]] std::size_t getWordCount() const;
+
+        /// \brief Adds occurrences of a key
+        /// \param key The words of the key (getWordCount() of them)
+        /// \param count The number of occurrences
+        void add(std::span<const std::uint64_t> key, const std::size_t &count = 1);
+
+        /// \brief Gets the number of occurrences of a key
+        /// \param key The words of the key (getWordCount() of them)
+        [[nodiscard]] std::size_t getCount(std::span<const std::uint64_t> key) const;
+
+        /// \brief Gets the total number of occurrences
+        [[nodiscard]] std::size_t getTotal() const;
+
+        /// \brief Gets the keys that occurred at least once, in increasing order, with their number of occurrences
+        [[nodiscard]] std::vector<std::pair<std::vector<std::uint64_t>, std::size_t>> getEntries() const;
+
+        /// \brief Adds the occurrences of another histogram with the same width
+        Histogram &operator+=(const Histogram &other);
+
+    private:
+        std::size_t bitCount; /**< The width of the keys. */
+        std::size_t wordCount; /**< The number of words of a key. */
+        std::size_t total; /**< The total number of occurrences. */
+        std::size_t usedSlots; /**< The number of occupied slots of the hash table. */
+        std::vector<std::size_t> counts; /**< The counts, indexed by key (dense) or by slot (hashed, 0 if free). */
+        std::vector<std::uint64_t> keys; /**< The keys of the slots of the hash table, wordCount words each. */
+
+        [[nodiscard]] bool isDense() const;
+
+        /// \brief Finds the slot holding a key, or the free slot where it would be inserted
+        [[nodiscard]] std::size_t findSlot(std::span<const std::uint64_t> key) const;
+
+        /// \brief Doubles the capacity of the hash table
+        void grow();
+    };
+
+}
@@ -0,0 +1,84 @@
+/**
+ * @file kernels.hpp
+ * @brief This file contains the Kernels class.
+ * @author Mario Deaconescu
+ */
+
+#pragma once
+
+#include <array>
+#include <complex>
+#include <cstddef>
+
+namespace QPP {
+
+/**
+ * @class Kernels
+ * @brief Vectorized gate kernels for double-precision state vectors.
+ *
+ * Every kernel has a portable scalar variant and SSE, AVX2 and AVX-512 variants working directly on the interleaved
+ * std::complex<double> layout. The variant is picked at runtime from the instruction sets supported by the CPU, so
+ * the library does not need to be compiled with architecture-specific flags.
+ *
+ * Vector variants process 1 (SSE), 2 (AVX2) or 4 (AVX-512) consecutive amplitudes at once, so they fall back to the
+ * scalar loop when the target or a control is one of the lowest qubits.
+ */
+    class Kernels {
+    public:
+        enum Level {
+            SCALAR = 0,
+            SSE = 1,
+            AVX2 = 2,
+            AVX512 = 3
+        };
+
+        typedef std::complex<double> Amplitude;
+        typedef std::array<Amplitude, 4> Matrix;
+
+        /// \brief Gets the most advanced variant supported by the CPU
+        [[nodiscard]] static Level getSupportedLevel();
+
+        /// \brief Gets the variant used by the kernels
+        [[nodiscard]] static Level getLevel();
+
+        /// \brief Sets the variant used by the kernels
+        /// \param level_ The variant to use (capped to the supported level)
+        static void setLevel(const Level &level_);
+
+        /// \brief Gets the name of a variant ("scalar", "sse", "avx2" or "avx512")
+        [[nodiscard]] static const char *getLevelName(const Level &level_);
+
+        /// \brief Applies a single-qubit unitary on the amplitudes whose control bits are all 1
+        /// \param amplitudes The amplitudes of the register
+        /// \param size The number of amplitudes (a power of 2)
+        /// \param target The target qubit
+        /// \param matrix The unitary matrix, in row-major order
+        /// \param controlMask The control mask
+        /// \param level_ The variant to use
+        static void applyMatrix(Amplitude *amplitudes, const size_t &size, const size_t &target, const Matrix &matrix,
+                                const size_t &controlMask, const Level &level_ = getLevel());
+
+        /// \brief Multiplies the amplitudes whose mask bits are all 1 by a phase
+        /// \param amplitudes The amplitudes of the register
+        /// \param size The number of amplitudes (a power of 2)
+        /// \param mask The bits that must be set (target and controls)
+        /// \param phase The phase factor
+        /// \param level_ The variant to use
+        static void applyPhase(Amplitude *amplitudes, const size_t &size, const size_t &mask, const Amplitude &phase,
+                               const Level &level_ = getLevel());
+
+        /// \brief Multiplies every amplitude by a phase read from a table, indexed by a range of qubits
+        /// \param amplitudes The amplitudes of the register
+        /// \param size The number of amplitudes (a power of 2)
+        /// \param lowestQubit The lowest qubit of the range
+        /// \param phases The phase of each state of the range (a power of 2 of them)
+        /// \param phaseCount The number of phases
+        /// \param level_ The variant to use
+        static void applyDiagonal(Amplitude *amplitudes, const size_t &size, const size_t &lowestQubit,
+                                  const Amplitude *phases, const size_t &phaseCount, const Level &level_ = getLevel());
+
+    private:
+        static Level level; /**< The variant used by the kernels. */
+    };
+
+}
@@ -0,0 +1,284 @@
+/// @file matrix_product_state.hpp
+/// @brief This file contains the MatrixProductState class template.
+///
+/// A MatrixProductState holds an n-qubit register as a chain of small tensors, one per qubit, linked by bonds whose
+/// dimension grows with the entanglement between the two halves of the chain they split. Wide circuits with little
+/// entanglement (e.g. shallow circuits of nearest-neighbour gates) then take memory and time polynomial in n instead
+/// of exponential.
+///
+/// @author Mario Deaconescu
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include "classic_bit.hpp"
+#include "probability.hpp"
+#include "qubit.hpp"
+#include "representable.hpp"
+#include "state_vector.hpp"
+
+namespace QPP {
+
+/// @class MatrixProductState
+/// @brief A class template representing the state of a quantum register as a matrix product state.
+///
+/// The tensor of qubit i has the shape [bond i][2][bond i + 1], with bonds 0 and n of dimension 1. The chain is kept
+/// in mixed canonical form around a center site: the tensors left of it are left-orthonormal and the ones right of
+/// it right-orthonormal, so the center holds the norm and its bonds hold the Schmidt decompositions of the state.
+///
+/// A single-qubit gate is contracted into the tensor of its qubit. An operation on several qubits first brings them
+/// next to each other with swaps of adjacent qubits, contracts their tensors into a single block, applies the
+/// operation on it and splits the block back with singular value decompositions, before the swaps are undone. Each
+/// decomposition is truncated as configured by a Truncation, and the weight of the dropped singular values is added
+/// to the discarded weight, so the state stays exact as long as getDiscardedWeight returns 0.
+///
+/// The kernels take the same arguments as the ones of StateVector, so a Program can be executed on either register,
+/// and every measurement draws one probability from the engine, with the same outcome as a StateVector would give
+/// for that draw.
+/// @tparam FloatingNumberType The type of the floating-point number used by the probability engine and the tensors.
+    template<std_floating_point FloatingNumberType>
+    class MatrixProductState : public Representable {
+    public:
+        typedef typename StateVector<FloatingNumberType>::Amplitude Amplitude;
+        typedef typename StateVector<FloatingNumberType>::Matrix Matrix;
+
+        /// @brief The limits applied to the bonds created by an operation on several qubits.
+        struct Truncation {
+            /// @brief The maximum dimension of a bond, or 0 for no maximum.
+            size_t maxBondDimension = 0;
+            /// @brief The largest weight (sum of the squared singular values, relative to the norm) dropped at a bond.
+            FloatingNumberType threshold = 0;
+        };
+
+        /// @brief The widest range of consecutive qubits whose diagonal gates are batched for this register.
+        /// @details A batched diagonal operation is applied on a block of all the qubits of its range, so only pairs of
+        /// adjacent qubits are batched.
+        static constexpr size_t MAX_DIAGONAL_SPAN = 2;
+
+    private:
+        std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine;
+        size_t qubitCount;
+        Truncation truncation;
+        /// @brief The tensor of each qubit, in row-major order.
+        std::vector<std::vector<Amplitude>> sites;
+        /// @brief The dimension of each of the n + 1 bonds.
+        std::vector<size_t> bondDimensions;
+        /// @brief The site holding the norm of the state.
+        size_t center = 0;
+        FloatingNumberType discardedWeight = 0;
+
+        /// @brief The block of contracted sites, and the matrix it is reshaped to before a decomposition.
+        std::vector<Amplitude> block;
+        std::vector<Amplitude> matrix;
+        /// @brief The kept part of the last decomposition: U, the singular values and V^H.
+        std::vector<Amplitude> leftVectors;
+        std::vector<FloatingNumberType> singularValues;
+        std::vector<Amplitude> rightVectors;
+        /// @brief The amplitudes of a block for one pair of outer bond indices.
+        std::vector<Amplitude> localAmplitudes;
+        /// @brief The columns orthogonalized by decompose, the product of its rotations, and the norms and order of
+        /// the columns.
+        std::vector<Amplitude> columnVectors;
+        std::vector<Amplitude> rotations;
+        std::vector<FloatingNumberType> columnNorms;
+        std::vector<size_t> columnOrder;
+        /// @brief The sorted qubits of the operation being applied.
+        std::vector<size_t> operationQubits;
+        /// @brief The local bits of each basis state of the targets of the operation, and the amplitudes gathered
+        /// from them.
+        std::vector<size_t> targetOffsets;
+        std::vector<Amplitude> gathered;
+
+        /// @brief Computes the singular value decomposition of a complex matrix.
+        /// @details Uses the one-sided Jacobi method, which rotates pairs of columns until they are orthogonal.
+        /// @param matrix The matrix, in row-major order.
+        /// @param rows The number of rows.
+        /// @param columns The number of columns.
+        /// @param left Set to U, a rows x k matrix in row-major order, with k = min(rows, columns).
+        /// @param values Set to the k singular values, in decreasing order.
+        /// @param right Set to V^H, a k x columns matrix in row-major order.
+        void decompose(const std::vector<Amplitude> &matrix, const size_t &rows, const size_t &columns,
+                       std::vector<Amplitude> &left, std::vector<FloatingNumberType> &values,
+                       std::vector<Amplitude> &right);
+
+        /// @brief Decomposes the matrix buffer and keeps its largest singular values.
+        /// @details Singular values that are numerically 0 are always dropped. When truncating, the values dropped by
+        /// the Truncation are added to the discarded weight and the kept ones are rescaled to keep the norm.
+        /// @param rows The number of rows of the matrix.
+        /// @param columns The number of columns of the matrix.
+        /// @param truncate Whether the Truncation is applied.
+        /// @return The number of kept singular values, the dimension of the new bond.
+        size_t split(const size_t &rows, const size_t &columns, const bool &truncate);
+
+        /// @brief Moves the center of the canonical form to a site.
+        void moveCenter(const size_t &site);
+
+        /// @brief Applies an operation on a range of consecutive sites.
+        /// @param first The first site.
+        /// @param count The number of sites.
+        /// @param transform Called with the 2^count amplitudes of the sites for every pair of outer bond indices, bit
+        /// i of a local basis state corresponding to site first + i.
+        template<class Transform>
+        void applyBlock(const size_t &first, const size_t &count, const Transform &transform);
+
+        /// @brief Applies an operation on a set of qubits, moving them next to each other if needed.
+        /// @param qubits The qubits, in increasing order. Bit i of a local basis state corresponds to qubits[i].
+        /// @param transform The operation, as for applyBlock.
+        template<class Transform>
+        void applyOperator(const std::vector<size_t> &qubits, const Transform &transform);
+
+        /// @brief Swaps the states of two adjacent qubits.
+        void swapSites(const size_t &site);
+
+        /// @brief Gets the sorted qubits of an operation.
+        /// @param targets The target qubits.
+        /// @param controls The control qubits.
+        /// @return The targets and the controls, in increasing order, held in operationQubits until the next operation.
+        [[nodiscard]] const std::vector<size_t> &getQubits(std::span<const size_t> targets, std::span<const size_t> controls);
+
+        /// @brief Gets the bits of a local basis state corresponding to the control qubits.
+        [[nodiscard]] static size_t getLocalMask(const std::vector<size_t> &qubits, std::span<const size_t> controls);
+
+        /// @brief Gets the bit of a local basis state corresponding to a qubit.
+        [[nodiscard]] static size_t getLocalBit(const std::vector<size_t> &qubits, const size_t &qubit);
+
+        /// @brief Computes the reduced density matrix of a qubit from its tensor, with the center on it.
+        /// @details The chain is copied if the center is elsewhere.
+        /// @param target The qubit.
+        /// @param zeroWeight Set to the weight of the ❘0〉 component.
+        /// @param oneWeight Set to the weight of the ❘1〉 component.
+        /// @param coherence Set to the overlap of the ❘0〉 and ❘1〉 components.
+        void getSiteWeights(const size_t &target, FloatingNumberType &zeroWeight, FloatingNumberType &oneWeight,
+                            Amplitude &coherence) const;
+
+    public:
+        /// @brief Creates a MatrixProductState for the given number of qubits. The tensors are allocated on the first
+        /// reset.
+        /// @param probabilityEngine The probability engine used for measurements.
+        /// @param qubitCount The number of qubits in the register.
+        MatrixProductState(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                           const size_t &qubitCount);
+
+        /// @brief Resets the register to ❘0...0〉 and the discarded weight to 0.
+        void reset();
+
+        /// @brief Changes the number of qubits of the register.
+        /// @details The tensors are released.
+        /// @param qubitCount The new number of qubits.
+        void resize(const size_t &qubitCount);
+
+        /// @brief Checks if the tensors have been allocated.
+        /// @return True if the register has been reset at least once, false otherwise.
+        [[nodiscard]] bool isInitialized() const;
+
+        /// @brief Gets the number of qubits in the register.
+        /// @return The number of qubits.
+        [[nodiscard]] size_t getQubitCount() const;
+
+        /// @brief Gets the probability engine used for measurements.
+        /// @return The probability engine.
+        [[nodiscard]] const std::shared_ptr<ProbabilityEngine<FloatingNumberType>> &getProbabilityEngine() const;
+
+        /// @brief Sets the limits applied to the bonds from now on.
+        void setTruncation(const Truncation &truncation_);
+
+        [[nodiscard]] const Truncation &getTruncation() const;
+
+        /// @brief Gets the weight dropped by the truncations since the last reset.
+        /// @details The sum of the relative weights dropped at every decomposition, which bounds the infidelity of the
+        /// state to first order.
+        /// @return The discarded weight.
+        [[nodiscard]] FloatingNumberType getDiscardedWeight() const;
+
+        /// @brief Gets the dimension of each of the n + 1 bonds, the first and last ones being 1.
+        [[nodiscard]] const std::vector<size_t> &getBondDimensions() const;
+
+        /// @brief Gets the largest dimension of a bond.
+        [[nodiscard]] size_t getMaxBondDimension() const;
+
+        /// @brief Applies a single-qubit unitary.
+        /// @param target The target qubit.
+        /// @param matrix The unitary matrix.
+        /// @param controls The control qubits.
+        void applyMatrix(const size_t &target, const Matrix &matrix, std::span<const size_t> controls = {});
+
+        /// @brief Applies a unitary on several qubits.
+        /// @param targets The target qubits. Bit i of a row or column index corresponds to targets[i].
+        /// @param matrix The 2^k x 2^k unitary matrix, in row-major order.
+        /// @param controls The control qubits.
+        void applyUnitary(std::span<const size_t> targets, std::span<const Amplitude> matrix,
+                          std::span<const size_t> controls = {});
+
+        /// @brief Permutes the basis states of several qubits.
+        /// @param targets The target qubits. Bit i of an entry of the table corresponds to targets[i].
+        /// @param table The image of each of the 2^k basis states of the targets.
+        /// @param controls The control qubits.
+        void applyPermutation(std::span<const size_t> targets, std::span<const size_t> table,
+                              std::span<const size_t> controls = {});
+
+        /// @brief Applies a NOT transformation.
+        /// @param target The target qubit.
+        /// @param controls The control qubits.
+        void applyX(const size_t &target, std::span<const size_t> controls = {});
+
+        /// @brief Multiplies the ❘1〉 component of the target qubit by a phase.
+        /// @param target The target qubit.
+        /// @param phase The phase factor.
+        /// @param controls The control qubits.
+        void applyPhase(const size_t &target, const Amplitude &phase, std::span<const size_t> controls = {});
+
+        /// @brief Applies a diagonal operation on a range of consecutive qubits.
+        /// @param lowestQubit The lowest qubit of the range.
+        /// @param phases The phase of each of the 2^k basis states of the k qubits of the range.
+        void applyDiagonal(const size_t &lowestQubit, std::span<const Amplitude> phases);
+
+        /// @brief Swaps the states of two qubits.
+        /// @param qubit1 The first qubit.
+        /// @param qubit2 The second qubit.
+        /// @param controls The control qubits.
+        void applySwap(const size_t &qubit1, const size_t &qubit2, std::span<const size_t> controls = {});
+
+        /// @brief Gets the amplitude of a basis state, by contracting the chain along it.
+        /// @param basisState The basis state, in which bit i corresponds to qubit i.
+        /// @return The amplitude.
+        [[nodiscard]] Amplitude getAmplitude(const size_t &basisState) const;
+
+        /// @brief Gets the probability of measuring 1 on the given qubit.
+        /// @param target The qubit.
+        /// @return The probability of measuring 1.
+        [[nodiscard]] FloatingNumberType getOneProbability(const size_t &target) const;
+
+        /// @brief Measures a qubit.
+        ///
+        /// WARNING: This function collapses the register to the measured outcome.
+        /// @param target The qubit to measure.
+        /// @return The measured state of the qubit.
+        ClassicBit measure(const size_t &target);
+
+        /// @brief Resets a qubit to ❘0〉 and then applies a unitary on it.
+        /// @param target The qubit.
+        /// @param preparation The unitary mapping ❘0〉 to the state to prepare.
+        void initialize(const size_t &target, const Matrix &preparation);
+
+        /// @brief Gets the state of a single qubit, as for StateVector::getQubitState.
+        [[nodiscard]] typename Qubit<FloatingNumberType>::State getQubitState(const size_t &target) const;
+
+        /// @brief Gets the representation of the register.
+        /// @return The dimensions of the bonds and the discarded weight.
+        [[nodiscard]] std::string getRepresentation() const override;
+    };
+
+#include "templates/matrix_product_state.tpp"
+
+}
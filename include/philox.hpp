@@ -0,0 +1,64 @@
+/**
+ * @file philox.hpp
+ * @brief This file contains the Philox class.
+ * @author Mario Deaconescu
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace QPP {
+
+/**
+ * @class Philox
+ * @brief A counter-based random number generator (Philox4x32-10).
+ *
+ * Each output block is a pure function of the key, the stream and the block counter, so generators with the same key
+ * and different streams produce independent sequences that can be created in any order, on any thread.
+ *
+ * Satisfies the UniformRandomBitGenerator requirements.
+ */
+    class Philox {
+    public:
+        typedef std::uint64_t result_type;
+
+        /// \brief Creates a Philox generator
+        /// \param key The key (seed) of the generator
+        /// \param stream The index of the stream
+        Philox(const std::uint64_t &key, const std::uint64_t &stream);
+
+        /// \brief Gets the next 64 random bits
+        result_type operator()();
+
+        /// \brief Moves the generator to the start of the given block
+        /// \param block The index of the block (each block holds two outputs)
+        void seek(const std::uint64_t &block);
+
+        /// \brief Skips outputs, in constant time
+        /// \param count The number of outputs to skip
+        void discard(const std::uint64_t &count);
+
+        /// \brief Gets the index of the stream
+        [[nodiscard]] std::uint64_t getStream() const;
+
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return UINT64_MAX;
+        }
+
+    private:
+        /// \brief Encrypts the current counter into the output buffer
+        void generateBlock();
+
+        std::array<std::uint32_t, 2> key; /**< The key of the generator. */
+        std::array<std::uint32_t, 4> counter; /**< The block counter (low words) and the stream (high words). */
+        std::array<std::uint64_t, 2> buffer; /**< The outputs of the current block. */
+        std::uint8_t bufferPosition; /**< The next output to return from the buffer. */
+    };
+
+}
@@ -7,6 +7,14 @@
 #include <random>
 #include <concepts>
 #include <type_traits>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include "philox.hpp"
 
 #if __cpp_lib_concepts >= 202002L
 #define std_floating_point std::floating_point
@@ -20,25 +28,95 @@ namespace QPP {
 
 /// @class ProbabilityEngine
 /// @brief A class template representing a probability engine.
+///
+/// The engine owns a single generator, seeded once, so that every run made with the same seed draws the same
+/// sequence of probabilities. Two generators are available:
+/// - SEQUENTIAL uses a Mersenne Twister (std::mt19937_64).
+/// - COUNTER_BASED uses Philox, which can be split into independent substreams (for example one per shot or thread).
+///
+/// The engine is not thread-safe: every thread should use its own engine, obtained with split().
 /// @tparam FloatingNumberType The type of the floating-point number used to represent the probabilities.
     template<std_floating_point FloatingNumberType>
     class ProbabilityEngine {
+    public:
+        enum Mode {
+            SEQUENTIAL = 0,
+            COUNTER_BASED = 1
+        };
+
     private:
-        std::random_device device;
-        std::uniform_real_distribution<FloatingNumberType> distribution;
         const FloatingNumberType errorMargin = 2e-10;
+        std::uint64_t seed;
+        Mode mode;
+        std::mt19937_64 sequentialGenerator;
+        Philox counterGenerator;
+        std::uint64_t drawCount = 0;
+
+        /// @brief Converts 64 random bits to a probability in [0, 1), identically on every platform.
+        static FloatingNumberType toProbability(const std::uint64_t &bits);
+
     public:
-        /// @brief Creates a ProbabilityEngine with the default error margin.
+        /// @brief Creates a ProbabilityEngine with the default error margin and a random seed.
         ProbabilityEngine();
 
-        /// @brief Creates a ProbabilityEngine with the given error margin.
+        /// @brief Creates a ProbabilityEngine with the given error margin and a random seed.
         /// @param errorMargin_ The error margin to use.
         explicit ProbabilityEngine(const FloatingNumberType &errorMargin_);
 
+        /// @brief Creates a ProbabilityEngine with the given error margin and seed.
+        /// @param errorMargin_ The error margin to use.
+        /// @param seed_ The seed of the generator.
+        /// @param mode_ The generator to use.
+        ProbabilityEngine(const FloatingNumberType &errorMargin_, const std::uint64_t &seed_, const Mode &mode_ = SEQUENTIAL);
+
         /// @brief Gets a random probability.
-        /// @return A random probability from the interval [0, 1].
+        /// @return A random probability from the interval [0, 1).
         FloatingNumberType getProbability();
 
+        /// @brief Gets 64 random bits from the active generator.
+        /// @return The random bits.
+        std::uint64_t getBits();
+
+        /// @brief Fills a range with random probabilities.
+        /// @details Produces the same values as calling getProbability() once for each element.
+        /// @param values The range to fill.
+        void fill(std::span<FloatingNumberType> values);
+
+        /// @brief Skips a number of draws.
+        /// @details The engine then draws the same values as after calling getProbability() count times. Counter-based
+        /// engines skip in constant time.
+        /// @param count The number of draws to skip.
+        void discard(const std::uint64_t &count);
+
+        /// @brief Gets the number of values drawn from the engine since it was created.
+        /// @details Used by profiled circuits to attribute draws to gates.
+        /// @return The number of draws.
+        [[nodiscard]] std::uint64_t getDrawCount() const;
+
+        /// @brief Restarts the generator from the given seed.
+        /// @param seed_ The seed of the generator.
+        void setSeed(const std::uint64_t &seed_);
+
+        /// @brief Gets the seed of the generator.
+        /// @return The seed.
+        [[nodiscard]] std::uint64_t getSeed() const;
+
+        /// @brief Gets the generator used by the engine.
+        /// @return The mode of the engine.
+        [[nodiscard]] Mode getMode() const;
+
+        /// @brief Creates an engine drawing from an independent substream of this engine's seed.
+        /// @details The substream only depends on the seed and the stream index, so splitting is reproducible
+        /// regardless of how many probabilities this engine has already drawn.
+        /// @param stream The index of the substream.
+        /// @return A counter-based engine with the same seed and error margin.
+        [[nodiscard]] std::shared_ptr<ProbabilityEngine> split(const std::uint64_t &stream) const;
+
+        /// @brief Moves the counter-based generator to the start of the given substream.
+        /// @details After this call, the engine draws the same values as split(stream) would.
+        /// @param stream The index of the substream.
+        void setStream(const std::uint64_t &stream);
+
         /// @brief Compares two numbers using an error margin.
         /// @tparam T The type of the numbers.
         /// @param number1 The first number.
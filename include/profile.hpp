@@ -0,0 +1,117 @@
+/**
+ * @file profile.hpp
+ * @brief This file contains the Profile class.
+ * @author Mario Deaconescu
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "representable.hpp"
+
+namespace QPP {
+
+/**
+ * @class Profile
+ * @brief Execution statistics of a profiled circuit, per gate class.
+ *
+ * Entries are keyed by the symbol of a gate class and form a tree: the gates of a CircuitGate and the gate wrapped by
+ * a CustomControlledGate are children of the entry of their parent gate, so the same class of gate is counted apart
+ * at every nesting path. Times, measurements and probability draws of an entry include the ones of its children.
+ *
+ * Shots sampled from a single evolution of the circuit are recorded in a root entry named SAMPLING_SYMBOL, with one
+ * measurement per shot and measured qubit.
+ */
+    class Profile : public Representable {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        /// \brief The parent of the root entries
+        static constexpr std::size_t NO_PARENT = std::numeric_limits<std::size_t>::max();
+
+        /// \brief The symbol of the entry recording the sampling of terminal measurements
+        static constexpr const char *SAMPLING_SYMBOL = "SAMPLE";
+
+        /// \brief The statistics of a gate class at a nesting path
+        struct Entry {
+            std::string symbol;
+            std::size_t parent;
+            std::vector<std::size_t> children;
+            /// \brief The number of applications
+            std::uint64_t count = 0;
+            /// \brief The cumulative wall time of the applications
+            std::chrono::nanoseconds totalTime{0};
+            /// \brief The wall time of the longest application
+            std::chrono::nanoseconds maxTime{0};
+            /// \brief The number of qubit measurements
+            std::uint64_t measurements = 0;
+            /// \brief The number of draws from the probability engine
+            std::uint64_t draws = 0;
+        };
+
+        /// \brief Gets the entry of a symbol under a parent entry, adding it if needed
+        /// \return The index of the entry
+        std::size_t getEntry(const std::string &symbol, const std::size_t &parent = NO_PARENT);
+
+        [[nodiscard]] const std::vector<Entry> &getEntries() const;
+
+        /// \brief Gets the indices of the root entries, in the order they were added
+        [[nodiscard]] const std::vector<std::size_t> &getRoots() const;
+
+        /// \brief Gets the wall time spent in an entry, but not in its children
+        [[nodiscard]] std::chrono::nanoseconds getSelfTime(const std::size_t &entry) const;
+
+        /// \brief Gets the wall time of the profiled runs or simulations
+        [[nodiscard]] std::chrono::nanoseconds getTotalTime() const;
+
+        /// \brief Gets the number of shots of the profiled runs or simulations
+        [[nodiscard]] std::uint64_t getShotCount() const;
+
+        /// \brief Records a run or simulation that started at the given time and ends now
+        void addRun(const Clock::time_point &start, const std::uint64_t &shots);
+
+        /// \brief Starts an application of an entry
+        /// \param entry The index of the entry
+        /// \param draws The number of draws of the probability engine so far
+        /// \param measurements The number of measurements so far
+        void enter(const std::size_t &entry, const std::uint64_t &draws, const std::uint64_t &measurements);
+
+        /// \brief Ends the last started application
+        /// \param draws The number of draws of the probability engine so far
+        /// \param measurements The number of measurements so far
+        void leave(const std::uint64_t &draws, const std::uint64_t &measurements);
+
+        /// \brief Adds the statistics of another profile, matching the entries by their nesting path
+        Profile &operator+=(const Profile &other);
+
+        /// \brief Gets the profile as a JSON object, with the entries nested like the gates
+        [[nodiscard]] std::string getJSON() const;
+
+        /// \brief Gets the profile as a table, with the children of each entry sorted by decreasing total time
+        [[nodiscard]] std::string getRepresentation() const override;
+
+    private:
+        struct Frame {
+            std::size_t entry;
+            Clock::time_point start;
+            std::uint64_t draws;
+            std::uint64_t measurements;
+        };
+
+        std::vector<Entry> entries;
+        std::vector<std::size_t> roots;
+        std::vector<Frame> frames;
+        std::chrono::nanoseconds totalTime{0};
+        std::uint64_t shotCount = 0;
+
+        void writeJSON(std::string &json, const std::size_t &entry) const;
+
+        void writeRow(std::string &table, const std::size_t &entry, const std::size_t &depth) const;
+    };
+
+}
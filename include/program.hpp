@@ -0,0 +1,276 @@
+/// @file program.hpp
+/// @brief This file contains the Program class template.
+///
+/// A Program is the compiled form of a Circuit: a flat array of plain instructions with their operands (qubits,
+/// controls, matrices and phases) resolved ahead of time, executed by a small interpreter.
+///
+/// @author Mario Deaconescu
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "angle.hpp"
+#include "classic_bit.hpp"
+#include "profile.hpp"
+#include "state_vector.hpp"
+#include "tableau.hpp"
+
+namespace QPP {
+
+/// @class Program
+/// @brief A class template representing a compiled circuit.
+///
+/// Every qubit index of a Program refers directly to a qubit of the register and every classic bit index to an entry
+/// of the classic bit array passed to execute. Sub-circuits are flattened: their classic bits are given a scratch
+/// range after the bits of the circuit, which is cleared every time the sub-circuit starts.
+///
+/// A Program is immutable once built, so a single one can be executed concurrently on different registers.
+///
+/// The instructions only call the kernels of the register, so a program runs on a StateVector, on a
+/// SparseStateVector, on a MatrixProductState, and on a Tableau as long as all its instructions are Clifford
+/// operations (see isClifford).
+/// The controls of an instruction are kept both as a mask, for the registers indexed by basis state, and as a list
+/// of qubits, for the registers that can hold more qubits than a mask has bits.
+/// @tparam FloatingNumberType The type of the floating-point number used to represent the amplitudes.
+    template<std_floating_point FloatingNumberType>
+    class Program {
+    public:
+        typedef typename StateVector<FloatingNumberType>::Amplitude Amplitude;
+        typedef typename StateVector<FloatingNumberType>::Matrix Matrix;
+
+        enum Opcode : std::uint8_t {
+            MATRIX,      /**< Applies matrix on target. */
+            X,           /**< Flips target. */
+            PHASE,       /**< Multiplies the ❘1〉 component of target by matrix[0]. */
+            SWAP,        /**< Swaps target and operand. */
+            UNITARY,     /**< Applies the unitary at operand in the matrix pool on the count targets at target in the target pool. */
+            PERMUTE,     /**< Applies the permutation at operand in the permutation pool on the count targets at target in the target pool. */
+            DIAGONAL,    /**< Multiplies every amplitude by the phase at operand in the phase pool indexed by the count qubits from target. */
+            MEASURE,     /**< Measures target into classic bit operand. */
+            INIT,        /**< Resets target to ❘0〉 and applies matrix on it. */
+            CLEAR,       /**< Resets count classic bits starting at operand. */
+            SKIP_UNLESS, /**< Skips the next count instructions if classic bit operand is 0. */
+            PRINT,       /**< Prints the state of target to the stream at operand in the stream pool. */
+            ENTER,       /**< Starts an application of the profile entry operand. Only in profiled programs. */
+            LEAVE        /**< Ends the last started application of a profile entry. Only in profiled programs. */
+        };
+
+        /// @brief A single instruction. The meaning of the operands depends on the opcode.
+        struct Instruction {
+            Opcode opcode;
+            size_t target;
+            size_t operand;
+            size_t count;
+            size_t controlMask;
+            size_t controlOffset;
+            size_t controlCount;
+            Matrix matrix;
+        };
+
+        static_assert(std::is_trivially_copyable_v<Instruction>);
+
+        /// @brief Creates an empty Program.
+        /// @param qubitCount The number of qubits of the register.
+        /// @param classicBitCount The number of classic bits of the circuit.
+        Program(const size_t &qubitCount, const size_t &classicBitCount);
+
+        /// @brief Marks the start of the instructions of the next top-level gate.
+        void beginGate();
+
+        /// @brief Starts the instructions of a gate in a profiled program.
+        /// @details The gate gets an entry of the profile under the entry of the gate it is nested in, if any.
+        /// @param symbol The symbol of the gate.
+        void beginProfile(const std::string &symbol);
+
+        /// @brief Ends the instructions of the gate started by the last unmatched call to beginProfile.
+        void endProfile();
+
+        /// @brief Reserves scratch classic bits, e.g. for the classic bits of a sub-circuit.
+        /// @param count The number of classic bits.
+        /// @return The index of the first reserved classic bit.
+        size_t allocateClassicBits(const size_t &count);
+
+        void addMatrix(const size_t &target, const Matrix &matrix, std::span<const size_t> controls);
+
+        void addX(const size_t &target, std::span<const size_t> controls);
+
+        void addPhase(const size_t &target, const Amplitude &phase, std::span<const size_t> controls);
+
+        /// @brief Adds a phase instruction whose angle depends on a parameter, so that it can be changed by bind.
+        /// @details Parametric phases are never batched into DIAGONAL instructions.
+        /// @param target The target qubit.
+        /// @param angle The angle of the phase.
+        /// @param values The values of the parameters the phase is computed with until the next bind.
+        /// @param controls The control qubits.
+        void addParametricPhase(const size_t &target, const Angle<FloatingNumberType> &angle,
+                                std::span<const FloatingNumberType> values, std::span<const size_t> controls);
+
+        void addSwap(const size_t &qubit1, const size_t &qubit2, std::span<const size_t> controls);
+
+        void addUnitary(std::span<const size_t> targets, std::span<const Amplitude> matrix, std::span<const size_t> controls);
+
+        /// @brief Adds an instruction permuting the basis states of some qubits.
+        /// @param targets The target qubits. Bit i of an entry of the table corresponds to targets[i].
+        /// @param table The image of each of the 2^k basis states of the targets.
+        /// @param controls The control qubits.
+        void addPermutation(std::span<const size_t> targets, std::span<const size_t> table, std::span<const size_t> controls);
+
+        void addMeasure(const size_t &target, const size_t &classicBit);
+
+        /// @brief Adds an instruction resetting a qubit to ❘0〉 and preparing it with a unitary.
+        /// @param target The qubit.
+        /// @param preparation The unitary mapping ❘0〉 to the prepared state.
+        void addInit(const size_t &target, const Matrix &preparation);
+
+        void addClear(const size_t &firstClassicBit, const size_t &count);
+
+        void addPrint(const size_t &target, std::ostream *outputStream);
+
+        /// @brief Starts a block of instructions only executed when a classic bit is 1.
+        /// @param classicBit The classic bit.
+        /// @return The index of the block, to be passed to endClassicControl.
+        size_t beginClassicControl(const size_t &classicBit);
+
+        /// @brief Ends a block started by beginClassicControl.
+        /// @param blockIndex The index returned by beginClassicControl.
+        void endClassicControl(const size_t &blockIndex);
+
+        /// @brief Merges runs of consecutive PHASE instructions into DIAGONAL instructions.
+        ///
+        /// Z, Phase, CZ and Controlled Phase gates, and quantum controlled versions of them, all compile to PHASE
+        /// instructions, which commute with each other. A run of them acting within at most maxSpan consecutive
+        /// qubits is replaced by a single DIAGONAL instruction, holding the product of their phases for every basis
+        /// state of those qubits, so that the run costs a single pass over the amplitudes. Runs do not cross the end
+        /// of a classically controlled block.
+        ///
+        /// The gates whose instructions were merged with the ones of previous gates start at the merged instruction.
+        /// @param maxSpan The maximum number of consecutive qubits of a DIAGONAL instruction.
+        void batchDiagonals(const size_t &maxSpan = MAX_DIAGONAL_SPAN);
+
+        /// @brief The default maximum number of consecutive qubits of a DIAGONAL instruction.
+        static constexpr size_t MAX_DIAGONAL_SPAN = 12;
+
+        /// @brief Recomputes the phases of the parametric instructions for new values of the parameters.
+        /// @details Nothing else is changed, so a program can be bound again and again without being recompiled.
+        /// @param values The values of the parameters.
+        void bind(std::span<const FloatingNumberType> values);
+
+        /// @brief Checks if some instructions depend on parameters.
+        [[nodiscard]] bool isParametric() const;
+
+        /// @brief Gets the number of qubits of the register.
+        [[nodiscard]] size_t getQubitCount() const;
+
+        /// @brief Gets the number of classic bits needed to execute the program, including scratch bits.
+        [[nodiscard]] size_t getClassicBitCount() const;
+
+        /// @brief Gets the instructions of the program.
+        [[nodiscard]] const std::vector<Instruction> &getInstructions() const;
+
+        /// @brief Gets the control qubits of an instruction.
+        /// @param instruction The instruction.
+        /// @return The control qubits.
+        [[nodiscard]] std::span<const size_t> getControls(const Instruction &instruction) const;
+
+        /// @brief Gets the entries of the profiled gates, without any statistics.
+        /// @details Copies of it are passed to execute to profile a run.
+        [[nodiscard]] const Profile &getProfile() const;
+
+        /// @brief Gets the index of the first instruction of a top-level gate.
+        /// @param gateIndex The index of the gate in its circuit (the gate count gives the end of the program).
+        /// @return The instruction index.
+        [[nodiscard]] size_t getGateOffset(const size_t &gateIndex) const;
+
+        /// @brief Checks if every instruction is a Clifford operation, so that the program can run on a Tableau.
+        /// @return True if the program can be executed on a Tableau, false otherwise.
+        [[nodiscard]] bool isClifford() const;
+
+        /// @brief Executes the whole program.
+        /// @tparam Register The type of the register: StateVector, SparseStateVector, MatrixProductState or Tableau.
+        /// @param state The register, with getQubitCount() qubits.
+        /// @param classicBits The classic bits, with at least getClassicBitCount() entries.
+        /// @param profile The profile recording the profiled gates, or null to skip profiling.
+        template<class Register>
+        void execute(Register &state, std::vector<ClassicBit> &classicBits, Profile *profile = nullptr) const;
+
+        /// @brief Executes a range of instructions.
+        /// @tparam Register The type of the register: StateVector, SparseStateVector, MatrixProductState or Tableau.
+        /// @param state The register, with getQubitCount() qubits.
+        /// @param classicBits The classic bits, with at least getClassicBitCount() entries.
+        /// @param begin The index of the first instruction.
+        /// @param end The index after the last instruction.
+        /// @param profile The profile recording the profiled gates, or null to skip profiling.
+        template<class Register>
+        void execute(Register &state, std::vector<ClassicBit> &classicBits, const size_t &begin,
+                     const size_t &end, Profile *profile = nullptr) const;
+
+        /// @brief Executes the instructions from the start of the program for as long as every run would do the same.
+        ///
+        /// Execution stops before the first PRINT, ENTER or LEAVE instruction, and before the first MEASURE or INIT
+        /// instruction whose outcome is not certain, so the register and classic bits it leaves can be saved and
+        /// restored at the start of every run instead of executing the prefix again. The certain measurements still
+        /// draw from the engine as they would in a full run.
+        /// @tparam Register The type of the register: StateVector, SparseStateVector, MatrixProductState or Tableau.
+        /// @param state The register, with getQubitCount() qubits.
+        /// @param classicBits The classic bits, with at least getClassicBitCount() entries.
+        /// @return The index of the first instruction that was not executed.
+        template<class Register>
+        size_t executePrefix(Register &state, std::vector<ClassicBit> &classicBits) const;
+
+        /// @brief Executes a range of instructions on every possible sequence of measurement outcomes.
+        ///
+        /// Instead of drawing an outcome, every MEASURE and INIT instruction whose two outcomes are possible splits
+        /// the execution in two: the register and the classic bits are copied and collapsed to each outcome, and the
+        /// probability of the branch is multiplied by the one of its outcome. Outcomes whose probability the engine
+        /// of the register compares equal to 0 are not followed. PRINT instructions are ignored and nothing is
+        /// profiled.
+        ///
+        /// The number of branches grows exponentially with the number of measurements whose outcome is uncertain.
+        /// @tparam Register The type of the register: StateVector or SparseStateVector.
+        /// @tparam Leaf The type of the function called at the end of every branch.
+        /// @param state The register, with getQubitCount() qubits. It is left in the state of one of the branches.
+        /// @param classicBits The classic bits, with at least getClassicBitCount() entries.
+        /// @param begin The index of the first instruction.
+        /// @param end The index after the last instruction.
+        /// @param probability The probability of reaching begin with this register and these classic bits.
+        /// @param leaf The function called with the register, the classic bits and the probability of every branch.
+        template<class Register, class Leaf>
+        void executeBranches(Register &state, std::vector<ClassicBit> &classicBits, const size_t &begin,
+                             const size_t &end, const FloatingNumberType &probability, const Leaf &leaf) const;
+
+    private:
+        /// @brief A PHASE instruction whose angle depends on a parameter.
+        struct Binding {
+            size_t instruction;
+            Angle<FloatingNumberType> angle;
+        };
+
+        size_t qubitCount;
+        size_t classicBitCount;
+        std::vector<Instruction> instructions;
+        std::vector<Binding> bindings;
+        std::vector<size_t> gateOffsets;
+        std::vector<size_t> controlQubits;
+        std::vector<size_t> unitaryTargets;
+        std::vector<Amplitude> unitaryMatrices;
+        std::vector<size_t> permutationTables;
+        std::vector<Amplitude> diagonalPhases;
+        std::vector<std::ostream*> outputStreams;
+        Profile profile;
+        /// @brief The profile entries of the gates being compiled, from the outermost one.
+        std::vector<size_t> openProfileEntries;
+
+        void addInstruction(const Opcode &opcode, const size_t &target, const size_t &operand, const size_t &count,
+                            std::span<const size_t> controls = {}, const Matrix &matrix = {});
+    };
+
+#include "templates/program.tpp"
+
+}
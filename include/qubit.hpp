@@ -14,6 +14,7 @@
 #include "classic_bit.hpp"
 #include "probability.hpp"
 #include "representable.hpp"
+#include "validation.hpp"
 
 namespace QPP {
 
@@ -36,6 +37,7 @@ namespace QPP {
         ///This class represents the quantum state of a qubit.
         ///
         ///It contains a nested InvalidStateException class representing an exception thrown when the state is invalid.
+        ///The check is only compiled in when VALIDATION_ENABLED is true.
         ///
         class State : public Representable {
         private:
@@ -0,0 +1,253 @@
+/// @file sparse_state_vector.hpp
+/// @brief This file contains the SparseStateVector class template.
+///
+/// A SparseStateVector only stores the nonzero amplitudes of a register, keyed by their basis state. Circuits that
+/// keep the register in a few basis states (e.g. the modular arithmetic of Shor's algorithm, made of X, CX and Swap
+/// gates) then take memory and time proportional to the number of populated states instead of 2^n.
+///
+/// @author Mario Deaconescu
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "classic_bit.hpp"
+#include "probability.hpp"
+#include "qubit.hpp"
+#include "representable.hpp"
+#include "state_vector.hpp"
+
+namespace QPP {
+
+/// @class SparseStateVector
+/// @brief A class template representing the state of a quantum register as a map of its nonzero amplitudes.
+///
+/// The amplitudes are stored in an open-addressing hash table with linear probing, keyed by the basis state index
+/// (with the same bit order as StateVector). A gate only visits the populated entries: the ones that only change
+/// phases are applied in place, and the others write the images of the entries into a second table, which is then
+/// swapped with the first. Amplitudes whose squared magnitude falls below the pruning threshold are dropped.
+///
+/// Once the populated entries exceed a fraction of the 2^n basis states, a hash table costs more than a dense array,
+/// so the register moves its amplitudes into a StateVector and applies the dense kernels from then on, until the
+/// next reset.
+///
+/// The kernels take the same arguments as the ones of StateVector, and every measurement draws one probability from
+/// the engine, with the same outcome as a StateVector would give for that draw.
+/// @tparam FloatingNumberType The type of the floating-point number used to represent the amplitudes.
+    template<std_floating_point FloatingNumberType>
+    class SparseStateVector : public Representable {
+    public:
+        typedef typename StateVector<FloatingNumberType>::Amplitude Amplitude;
+        typedef typename StateVector<FloatingNumberType>::Matrix Matrix;
+
+        /// @brief When amplitudes are dropped and when the register becomes dense.
+        struct Sparsity {
+            /// @brief The squared magnitude at or below which an amplitude is dropped.
+            FloatingNumberType pruningThreshold = std::numeric_limits<FloatingNumberType>::epsilon() *
+                                                  std::numeric_limits<FloatingNumberType>::epsilon();
+            /// @brief The fraction of the 2^n basis states above which the register becomes dense, or 0 to stay
+            /// sparse.
+            FloatingNumberType denseFillRatio = FloatingNumberType(1) / 8;
+        };
+
+    private:
+        class RegisterTooLargeException : public std::runtime_error {
+        public:
+            explicit RegisterTooLargeException(const size_t &qubitCount);
+
+        private:
+            const size_t qubitCount;
+        };
+
+        /// @brief The key of a free slot, which is not a basis state of any register small enough to be keyed.
+        static constexpr size_t FREE_SLOT = std::numeric_limits<size_t>::max();
+
+        /// @brief The capacity of the table after a reset.
+        static constexpr size_t INITIAL_CAPACITY = 16;
+
+        std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine;
+        size_t qubitCount;
+        Sparsity sparsity;
+        /// @brief The basis state of each slot of the table, or FREE_SLOT.
+        std::vector<size_t> keys;
+        /// @brief The amplitude of each slot of the table.
+        std::vector<Amplitude> values;
+        /// @brief The number of occupied slots.
+        size_t entryCount = 0;
+        /// @brief The table the images of the entries are written to.
+        std::vector<size_t> nextKeys;
+        std::vector<Amplitude> nextValues;
+        size_t nextEntryCount = 0;
+        /// @brief The register once it has become dense.
+        StateVector<FloatingNumberType> dense;
+        bool denseLayout = false;
+        /// @brief The buffer exchanged with the amplitudes of the dense register, so that becoming dense on every shot
+        /// does not allocate.
+        std::vector<Amplitude> denseAmplitudes;
+
+        /// @brief Empties a table, keeping its buffers and only growing them when it is larger than them.
+        static void clearTable(std::vector<size_t> &keys_, std::vector<Amplitude> &values_, const size_t &size);
+
+        /// @brief Mixes the bits of a basis state (splitmix64 finalizer).
+        [[nodiscard]] static size_t hashKey(const size_t &key);
+
+        /// @brief Finds the slot holding a basis state, or the free slot where it would be inserted.
+        [[nodiscard]] static size_t findSlot(const std::vector<size_t> &keys_, const size_t &key);
+
+        /// @brief Adds an amplitude to the one of a basis state in the next table.
+        void accumulate(const size_t &key, const Amplitude &value);
+
+        /// @brief Replaces the entries by their images.
+        /// @details The next table is cleared, the transform is called with the basis state and the amplitude of
+        /// every entry and adds their images with accumulate, and the tables are swapped. The small amplitudes are
+        /// then pruned, and the register becomes dense if it is too full.
+        /// @param transform The function mapping an entry to its images.
+        template<class Transform>
+        void transform(const Transform &transform_);
+
+        /// @brief Drops the amplitudes at or below the pruning threshold.
+        void prune();
+
+        /// @brief Moves the amplitudes into the dense register if there are more than the fill ratio allows.
+        void checkFill();
+
+        /// @brief Gets the bits of a basis state at the given qubits.
+        /// @return The local state, in which bit i corresponds to qubits[i].
+        [[nodiscard]] static size_t gatherBits(const size_t &key, std::span<const size_t> qubits);
+
+    public:
+        /// @brief Creates a SparseStateVector for the given number of qubits. The table is allocated on the first
+        /// reset.
+        /// @param probabilityEngine The probability engine used for measurements.
+        /// @param qubitCount The number of qubits in the register.
+        SparseStateVector(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                          const size_t &qubitCount);
+
+        /// @brief Resets the register to ❘0...0〉, held in a table of a single entry.
+        void reset();
+
+        /// @brief Changes the number of qubits of the register.
+        /// @details The amplitudes are released.
+        /// @param qubitCount The new number of qubits.
+        void resize(const size_t &qubitCount);
+
+        /// @brief Checks if the amplitudes have been allocated.
+        /// @return True if the register has been reset at least once, false otherwise.
+        [[nodiscard]] bool isInitialized() const;
+
+        /// @brief Gets the number of qubits in the register.
+        /// @return The number of qubits.
+        [[nodiscard]] size_t getQubitCount() const;
+
+        /// @brief Gets the probability engine used for measurements.
+        /// @return The probability engine.
+        [[nodiscard]] const std::shared_ptr<ProbabilityEngine<FloatingNumberType>> &getProbabilityEngine() const;
+
+        /// @brief Sets when amplitudes are dropped and when the register becomes dense, from now on.
+        void setSparsity(const Sparsity &sparsity_);
+
+        /// @brief Gets when amplitudes are dropped and when the register becomes dense.
+        [[nodiscard]] const Sparsity &getSparsity() const;
+
+        /// @brief Checks if the register has become dense since the last reset.
+        [[nodiscard]] bool isDense() const;
+
+        /// @brief Gets the number of stored amplitudes: the populated entries, or 2^n once dense.
+        [[nodiscard]] size_t getEntryCount() const;
+
+        /// @brief Gets the amplitude of a basis state.
+        /// @param basisState The basis state, in which bit i corresponds to qubit i.
+        /// @return The amplitude, 0 if it is not stored.
+        [[nodiscard]] Amplitude getAmplitude(const size_t &basisState) const;
+
+        /// @brief Applies a single-qubit unitary.
+        /// @param target The target qubit.
+        /// @param matrix The unitary matrix.
+        /// @param controlMask The control mask.
+        void applyMatrix(const size_t &target, const Matrix &matrix, const size_t &controlMask = 0);
+
+        /// @brief Applies a unitary on several qubits.
+        /// @param targets The target qubits. Bit i of a row or column index corresponds to targets[i].
+        /// @param matrix The 2^k x 2^k unitary matrix, in row-major order.
+        /// @param controlMask The control mask.
+        void applyUnitary(std::span<const size_t> targets, std::span<const Amplitude> matrix,
+                          const size_t &controlMask = 0);
+
+        /// @brief Permutes the basis states of several qubits.
+        /// @param targets The target qubits. Bit i of an entry of the table corresponds to targets[i].
+        /// @param table The image of each of the 2^k basis states of the targets.
+        /// @param controlMask The control mask.
+        void applyPermutation(std::span<const size_t> targets, std::span<const size_t> table,
+                              const size_t &controlMask = 0);
+
+        /// @brief Applies a NOT transformation.
+        /// @param target The target qubit.
+        /// @param controlMask The control mask.
+        void applyX(const size_t &target, const size_t &controlMask = 0);
+
+        /// @brief Multiplies the ❘1〉 component of the target qubit by a phase.
+        /// @param target The target qubit.
+        /// @param phase The phase factor.
+        /// @param controlMask The control mask.
+        void applyPhase(const size_t &target, const Amplitude &phase, const size_t &controlMask = 0);
+
+        /// @brief Applies a diagonal operation on a range of consecutive qubits.
+        /// @param lowestQubit The lowest qubit of the range.
+        /// @param phases The phase of each of the 2^k basis states of the k qubits of the range.
+        void applyDiagonal(const size_t &lowestQubit, std::span<const Amplitude> phases);
+
+        /// @brief Swaps the states of two qubits.
+        /// @param qubit1 The first qubit.
+        /// @param qubit2 The second qubit.
+        /// @param controlMask The control mask.
+        void applySwap(const size_t &qubit1, const size_t &qubit2, const size_t &controlMask = 0);
+
+        /// @brief Gets the probability of measuring 1 on the given qubit.
+        /// @param target The qubit.
+        /// @return The probability of measuring 1.
+        [[nodiscard]] FloatingNumberType getOneProbability(const size_t &target) const;
+
+        /// @brief Gets the probability of every outcome of measuring some qubits, without collapsing the register.
+        /// @param qubits The measured qubits. Bit i of an outcome corresponds to qubits[i].
+        /// @return The probability of each of the 2^k outcomes.
+        [[nodiscard]] std::vector<FloatingNumberType> getProbabilities(std::span<const size_t> qubits) const;
+
+        /// @brief Projects a qubit onto an outcome and renormalizes the register, without drawing a probability.
+        /// @param target The qubit.
+        /// @param outcome The outcome the qubit is projected onto.
+        /// @param probability The probability of the outcome, which must not be 0.
+        void collapse(const size_t &target, const bool &outcome, const FloatingNumberType &probability);
+
+        /// @brief Measures a qubit.
+        ///
+        /// WARNING: This function collapses the register to the measured outcome.
+        /// @param target The qubit to measure.
+        /// @return The measured state of the qubit.
+        ClassicBit measure(const size_t &target);
+
+        /// @brief Resets a qubit to ❘0〉 and then applies a unitary on it.
+        /// @param target The qubit.
+        /// @param preparation The unitary mapping ❘0〉 to the state to prepare.
+        void initialize(const size_t &target, const Matrix &preparation);
+
+        /// @brief Gets the state of a single qubit, as for StateVector::getQubitState.
+        [[nodiscard]] typename Qubit<FloatingNumberType>::State getQubitState(const size_t &target) const;
+
+        /// @brief Gets the representation of the register.
+        /// @return The populated basis states with their amplitudes, in increasing order.
+        [[nodiscard]] std::string getRepresentation() const override;
+    };
+
+#include "templates/sparse_state_vector.tpp"
+
+}
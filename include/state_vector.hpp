@@ -0,0 +1,205 @@
+/// @file state_vector.hpp
+/// @brief This file contains the StateVector class template.
+///
+/// A StateVector holds the full 2^n amplitude array of an n-qubit register and the unitary kernels
+/// used by the gates of a Circuit to evolve it.
+///
+/// @author Mario Deaconescu
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <memory>
+#include <span>
+#include <vector>
+#include "classic_bit.hpp"
+#include "kernels.hpp"
+#include "probability.hpp"
+#include "qubit.hpp"
+#include "representable.hpp"
+
+namespace QPP {
+
+/// @class StateVector
+/// @brief A class template representing the dense state of a quantum register.
+///
+/// Qubit i corresponds to bit i of the basis state index, so the amplitude of ❘q(n-1)...q1 q0〉 is stored at
+/// index q0 + 2 * q1 + ... + 2^(n-1) * q(n-1).
+///
+/// Every kernel takes a control mask: the operation is only applied on the basis states in which all the qubits
+/// of the mask are 1. A mask of 0 applies the operation unconditionally.
+///
+/// For double precision, the matrix and phase kernels are dispatched to the vectorized Kernels.
+///
+/// The amplitudes are allocated lazily, so that circuits that are only drawn or used as sub-circuits do not pay for
+/// a register they never use.
+/// @tparam FloatingNumberType The type of the floating-point number used to represent the amplitudes.
+    template<std_floating_point FloatingNumberType>
+    class StateVector : public Representable {
+    public:
+        typedef std::complex<FloatingNumberType> Amplitude;
+
+        /// @brief A 2x2 matrix stored in row-major order: {m00, m01, m10, m11}.
+        typedef std::array<Amplitude, 4> Matrix;
+
+    private:
+        class RegisterTooLargeException : public std::runtime_error {
+        public:
+            explicit RegisterTooLargeException(const size_t &qubitCount);
+
+        private:
+            const size_t qubitCount;
+        };
+
+        std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine;
+        size_t qubitCount;
+        std::vector<Amplitude> amplitudes;
+        /// @brief The sorted targets of the multi-qubit operation being applied, the offsets of the 2^k amplitudes of
+        /// a group relative to the one in which all the targets are 0, and the amplitudes gathered from a group.
+        /// They keep their capacity, so that applying an operation on as many targets as before does not allocate.
+        std::vector<size_t> targetPositions;
+        std::vector<size_t> targetOffsets;
+        std::vector<Amplitude> gathered;
+
+        /// @brief Fills targetPositions and targetOffsets for some targets, and sizes gathered to a group.
+        /// @param targets The target qubits. Bit i of an offset index corresponds to targets[i].
+        void prepareGroups(std::span<const size_t> targets);
+
+        /// @brief Inserts a 0 bit at the given position of an index.
+        /// @details Iterating k over [0, 2^(n-1)) yields every basis state in which the qubit is 0 exactly once.
+        [[nodiscard]] static size_t insertZeroBit(const size_t &index, const size_t &position);
+
+    public:
+        /// @brief Creates a StateVector for the given number of qubits. The amplitudes are allocated on the first reset.
+        /// @param probabilityEngine The probability engine used for measurements.
+        /// @param qubitCount The number of qubits in the register.
+        StateVector(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine, const size_t &qubitCount);
+
+        /// @brief Resets the register to ❘0...0〉, allocating the amplitudes if needed.
+        void reset();
+
+        /// @brief Changes the number of qubits of the register.
+        /// @details The amplitudes are released but keep their capacity, so resizing to at most the previous size
+        /// and resetting does not allocate.
+        /// @param qubitCount The new number of qubits.
+        void resize(const size_t &qubitCount);
+
+        /// @brief Checks if the amplitudes have been allocated.
+        /// @return True if the register has been reset at least once, false otherwise.
+        [[nodiscard]] bool isInitialized() const;
+
+        /// @brief Gets the number of qubits in the register.
+        /// @return The number of qubits.
+        [[nodiscard]] size_t getQubitCount() const;
+
+        /// @brief Gets the probability engine used for measurements.
+        /// @return The probability engine.
+        [[nodiscard]] const std::shared_ptr<ProbabilityEngine<FloatingNumberType>> &getProbabilityEngine() const;
+
+        /// @brief Gets the amplitudes of the register.
+        /// @return The amplitudes, indexed by basis state.
+        [[nodiscard]] const std::vector<Amplitude> &getAmplitudes() const;
+
+        /// @brief Replaces the amplitudes of the register.
+        /// @param amplitudes_ The 2^n amplitudes, indexed by basis state.
+        void setAmplitudes(std::vector<Amplitude> amplitudes_);
+
+        /// @brief Exchanges the amplitudes of the register with a buffer, so that both keep their memory.
+        /// @param amplitudes_ The buffer, holding 2^n amplitudes indexed by basis state or left empty.
+        void swapAmplitudes(std::vector<Amplitude> &amplitudes_);
+
+        /// @brief Applies an arbitrary single-qubit unitary.
+        /// @param target The target qubit.
+        /// @param matrix The unitary matrix.
+        /// @param controlMask The control mask.
+        void applyMatrix(const size_t &target, const Matrix &matrix, const size_t &controlMask = 0);
+
+        /// @brief Applies an arbitrary unitary on several qubits.
+        /// @param targets The target qubits. Bit i of a row or column index of the matrix corresponds to targets[i].
+        /// @param matrix The 2^k x 2^k unitary matrix, in row-major order.
+        /// @param controlMask The control mask.
+        void applyUnitary(std::span<const size_t> targets, std::span<const Amplitude> matrix,
+                          const size_t &controlMask = 0);
+
+        /// @brief Permutes the basis states of some qubits.
+        /// @details Every group of amplitudes that only differ on the targets is gathered and scattered once.
+        /// @param targets The target qubits. Bit i of an entry of the table corresponds to targets[i].
+        /// @param table The image of each of the 2^k basis states of the targets.
+        /// @param controlMask The control mask.
+        void applyPermutation(std::span<const size_t> targets, std::span<const size_t> table,
+                              const size_t &controlMask = 0);
+
+        /// @brief Applies a NOT transformation.
+        /// @param target The target qubit.
+        /// @param controlMask The control mask.
+        void applyX(const size_t &target, const size_t &controlMask = 0);
+
+        /// @brief Multiplies the ❘1〉 component of the target qubit by a phase.
+        /// @param target The target qubit.
+        /// @param phase The phase factor (e.g. -1 for a Z gate).
+        /// @param controlMask The control mask.
+        void applyPhase(const size_t &target, const Amplitude &phase, const size_t &controlMask = 0);
+
+        /// @brief Multiplies every amplitude by a phase depending on a range of consecutive qubits.
+        /// @details Applies any product of diagonal gates acting within the range in a single pass.
+        /// @param lowestQubit The lowest qubit of the range.
+        /// @param phases The phase of each of the 2^k basis states of the k qubits of the range.
+        void applyDiagonal(const size_t &lowestQubit, std::span<const Amplitude> phases);
+
+        /// @brief Swaps the states of two qubits.
+        /// @param qubit1 The first qubit.
+        /// @param qubit2 The second qubit.
+        /// @param controlMask The control mask.
+        void applySwap(const size_t &qubit1, const size_t &qubit2, const size_t &controlMask = 0);
+
+        /// @brief Gets the probability of measuring 1 on the given qubit.
+        /// @param target The qubit.
+        /// @return The probability of the qubit collapsing to ❘1〉.
+        [[nodiscard]] FloatingNumberType getOneProbability(const size_t &target) const;
+
+        /// @brief Gets the probability of every outcome of measuring some qubits, without collapsing the register.
+        /// @param qubits The measured qubits. Bit i of an outcome corresponds to qubits[i].
+        /// @return The probability of each of the 2^k outcomes.
+        [[nodiscard]] std::vector<FloatingNumberType> getProbabilities(std::span<const size_t> qubits) const;
+
+        /// @brief Projects a qubit onto an outcome and renormalizes the register, without drawing a probability.
+        /// @param target The qubit.
+        /// @param outcome The outcome the qubit is projected onto.
+        /// @param probability The probability of the outcome, which must not be 0.
+        void collapse(const size_t &target, const bool &outcome, const FloatingNumberType &probability);
+
+        /// @brief Measures a qubit.
+        ///
+        /// WARNING: This function collapses the register to the measured outcome.
+        /// @param target The qubit to measure.
+        /// @return The measured state of the qubit.
+        ClassicBit measure(const size_t &target);
+
+        /// @brief Resets a qubit to ❘0〉 and then prepares it in the given state.
+        /// @param target The qubit.
+        /// @param state The state to prepare.
+        void initialize(const size_t &target, const typename Qubit<FloatingNumberType>::State &state);
+
+        /// @brief Resets a qubit to ❘0〉 and then applies a unitary on it.
+        /// @param target The qubit.
+        /// @param preparation The unitary mapping ❘0〉 to the state to prepare.
+        void initialize(const size_t &target, const Matrix &preparation);
+
+        /// @brief Gets the state of a single qubit.
+        ///
+        /// The state is exact when the qubit is not entangled with the rest of the register. Otherwise, the magnitudes
+        /// match the measurement probabilities and the relative phase is taken from the reduced density matrix.
+        /// @param target The qubit.
+        /// @return The state of the qubit.
+        [[nodiscard]] typename Qubit<FloatingNumberType>::State getQubitState(const size_t &target) const;
+
+        /// @brief Gets the representation of the register.
+        /// @return The sum of the non-zero amplitudes multiplied with the respective kets.
+        [[nodiscard]] std::string getRepresentation() const override;
+    };
+
+#include "templates/state_vector.tpp"
+
+}
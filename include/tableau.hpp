@@ -0,0 +1,275 @@
+/// @file tableau.hpp
+/// @brief This file contains the Tableau class template.
+///
+/// A Tableau holds the stabilizer tableau of an n-qubit register, as in the CHP simulator of Aaronson and Gottesman.
+/// It only supports Clifford operations, but its memory grows with n^2 instead of 2^n, so it can run circuits of
+/// thousands of qubits.
+///
+/// @author Mario Deaconescu
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "classic_bit.hpp"
+#include "probability.hpp"
+#include "qubit.hpp"
+#include "representable.hpp"
+#include "state_vector.hpp"
+
+namespace QPP {
+
+/// @class Tableau
+/// @brief A class template representing the stabilizer state of a quantum register.
+///
+/// The state is described by n destabilizer and n stabilizer generators, each a Pauli string with a sign. A Pauli
+/// string is stored as two bit-packed rows, the X bits and the Z bits of the qubits (both bits set stand for Y), so
+/// multiplying two generators is a few word operations per 64 qubits. A Clifford gate updates one or two bits of
+/// every generator, and a measurement multiplies at most 2n pairs of generators, in O(n^2 / 64) word operations.
+/// Deterministic measurements keep a single destabilizer anticommuting with the measured Z, so measuring all the
+/// qubits of an entangled state (e.g. a GHZ state) stays within that bound instead of growing to O(n^3 / 64).
+///
+/// The kernels take the same arguments as the ones of StateVector, so a Program can be executed on either register.
+/// Operations that are not Clifford (e.g. a T gate, a controlled Hadamard or a Toffoli) throw a
+/// NonCliffordOperationException, and the static isClifford functions tell them apart ahead of time.
+///
+/// Every measurement draws one probability from the engine, with the same outcome as a StateVector would give for
+/// that draw, so a Clifford circuit yields the same results on both registers for a given seed.
+/// @tparam FloatingNumberType The type of the floating-point number used by the probability engine and the matrices.
+    template<std_floating_point FloatingNumberType>
+    class Tableau : public Representable {
+    public:
+        typedef typename StateVector<FloatingNumberType>::Amplitude Amplitude;
+        typedef typename StateVector<FloatingNumberType>::Matrix Matrix;
+
+        class NonCliffordOperationException : public std::runtime_error {
+        public:
+            explicit NonCliffordOperationException(const std::string &operation);
+        };
+
+    private:
+        /// @brief The image of a single-qubit Pauli (X, Y or Z) under a Clifford operation.
+        struct PauliImage {
+            bool x;
+            bool z;
+            bool negative;
+        };
+
+        /// @brief A product of S gates and CZ gates equal to a diagonal operation, up to a global phase.
+        struct DiagonalDecomposition {
+            /// @brief The number of S gates applied on each qubit, modulo 4.
+            std::vector<std::uint8_t> sPowers;
+            /// @brief The pairs of qubits with a CZ gate, as indices in the range.
+            std::vector<std::pair<size_t, size_t>> controlledZPairs;
+        };
+
+        std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine;
+        size_t qubitCount;
+        /// @brief The number of 64-bit words of the X bits (and of the Z bits) of a generator.
+        size_t wordCount = 0;
+        /// @brief The generators: destabilizer i is row i and stabilizer i is row n + i. A row is made of wordCount
+        /// words of X bits followed by wordCount words of Z bits.
+        std::vector<std::uint64_t> rows;
+        /// @brief Whether each generator has a -1 sign.
+        std::vector<std::uint8_t> signs;
+
+        [[nodiscard]] std::uint64_t *getRow(const size_t &row);
+
+        [[nodiscard]] const std::uint64_t *getRow(const size_t &row) const;
+
+        [[nodiscard]] bool getX(const size_t &row, const size_t &qubit) const;
+
+        [[nodiscard]] bool getZ(const size_t &row, const size_t &qubit) const;
+
+        /// @brief Multiplies a Pauli string by another one, in place.
+        /// @details Implements the rowsum of Aaronson and Gottesman, counting the powers of i of every qubit in
+        /// parallel over the 64 qubits of a word.
+        /// @param target The X and Z words of the string multiplied in place.
+        /// @param targetSign The sign of the target string.
+        /// @param source The X and Z words of the other string.
+        /// @param sourceSign The sign of the other string.
+        /// @return The sign of the product.
+        [[nodiscard]] bool multiply(std::uint64_t *target, const bool &targetSign, const std::uint64_t *source,
+                                    const bool &sourceSign) const;
+
+        /// @brief Computes the outcome of measuring a qubit that no stabilizer anticommutes with.
+        /// @param target The qubit.
+        /// @param product The buffer the product of the stabilizers is computed in, with 2 * wordCount words.
+        /// @return True if the outcome is 1, false otherwise.
+        [[nodiscard]] bool getDeterministicOutcome(const size_t &target, std::vector<std::uint64_t> &product) const;
+
+        /// @brief Measures a qubit that no stabilizer anticommutes with, turning a stabilizer into ±Z on the qubit.
+        /// @details Only one destabilizer anticommutes with Z on the qubit afterwards, like after a random measurement,
+        /// so the destabilizers do not pile up X bits that later measurements would have to multiply out again.
+        /// @param target The qubit.
+        /// @return True if the outcome is 1, false otherwise.
+        bool measureDeterministic(const size_t &target);
+
+        /// @brief Checks if a stabilizer anticommutes with Z on a qubit, i.e. if measuring the qubit is random.
+        [[nodiscard]] bool isRandom(const size_t &target) const;
+
+        /// @brief Applies a single-qubit Clifford operation given by the images of X, Y and Z.
+        void applyImages(const size_t &target, const std::array<PauliImage, 3> &images);
+
+        /// @brief Tolerance used to recognize Clifford matrices and phases.
+        [[nodiscard]] static FloatingNumberType getTolerance();
+
+        /// @brief Gets the power of i equal to a phase.
+        /// @return The power in [0, 4), or -1 if the phase is not a power of i.
+        [[nodiscard]] static int getPowerOfI(const Amplitude &phase);
+
+        /// @brief Computes the images of X, Y and Z under a single-qubit unitary.
+        /// @return False if one of the images is not a Pauli matrix, i.e. if the unitary is not Clifford.
+        [[nodiscard]] static bool getImages(const Matrix &matrix, std::array<PauliImage, 3> &images);
+
+        /// @brief Recognizes a Pauli matrix multiplied by a power of i.
+        /// @param pauli Set to 0 for I, 1 for X, 2 for Y and 3 for Z.
+        /// @param power Set to the power of i.
+        /// @return False if the matrix is not a multiple of a Pauli matrix by a power of i.
+        [[nodiscard]] static bool getPauli(const Matrix &matrix, int &pauli, int &power);
+
+        /// @brief Decomposes a diagonal operation into S and CZ gates.
+        /// @details The phases of a product of S and CZ gates are powers of i forming a quadratic form of the bits of
+        /// the basis state, so the form is read from the phases of the states with one and two bits set, and
+        /// checked against all the others.
+        /// @return False if the operation is not Clifford.
+        [[nodiscard]] static bool decomposeDiagonal(std::span<const Amplitude> phases,
+                                                    DiagonalDecomposition &decomposition);
+
+        /// @brief Gets the image of each target of a qubit permutation.
+        /// @param positions Set to the index of the target each target is moved to.
+        /// @return False if the table does not only reorder the targets.
+        [[nodiscard]] static bool getQubitPermutation(std::span<const size_t> table, std::vector<size_t> &positions);
+
+        [[noreturn]] static void throwNonClifford(const std::string &operation);
+
+    public:
+        /// @brief Creates a Tableau for the given number of qubits. The generators are allocated on the first reset.
+        /// @param probabilityEngine The probability engine used for measurements.
+        /// @param qubitCount The number of qubits in the register.
+        Tableau(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine, const size_t &qubitCount);
+
+        /// @brief Resets the register to ❘0...0〉, allocating the generators if needed.
+        void reset();
+
+        /// @brief Changes the number of qubits of the register.
+        /// @details The generators are released but keep their capacity.
+        /// @param qubitCount The new number of qubits.
+        void resize(const size_t &qubitCount);
+
+        /// @brief Checks if the generators have been allocated.
+        /// @return True if the register has been reset at least once, false otherwise.
+        [[nodiscard]] bool isInitialized() const;
+
+        /// @brief Gets the number of qubits in the register.
+        /// @return The number of qubits.
+        [[nodiscard]] size_t getQubitCount() const;
+
+        /// @brief Gets the probability engine used for measurements.
+        /// @return The probability engine.
+        [[nodiscard]] const std::shared_ptr<ProbabilityEngine<FloatingNumberType>> &getProbabilityEngine() const;
+
+        /// @brief Gets a stabilizer generator as a string of I, X, Y and Z, qubit 0 first, preceded by its sign.
+        /// @param index The index of the generator, in [0, n).
+        /// @return The generator.
+        [[nodiscard]] std::string getStabilizer(const size_t &index) const;
+
+        void applyHadamard(const size_t &target);
+
+        /// @brief Applies the phase gate diag(1, i).
+        void applyS(const size_t &target);
+
+        void applyCX(const size_t &control, const size_t &target);
+
+        void applyCZ(const size_t &qubit1, const size_t &qubit2);
+
+        /// @brief Applies a single-qubit unitary, Clifford up to a global phase.
+        /// @details With a single control, the unitary must be a Pauli matrix times a power of i.
+        /// @param target The target qubit.
+        /// @param matrix The unitary matrix.
+        /// @param controls The control qubits, at most one.
+        void applyMatrix(const size_t &target, const Matrix &matrix, std::span<const size_t> controls = {});
+
+        /// @brief Always throws, as general unitaries are not supported.
+        void applyUnitary(std::span<const size_t> targets, std::span<const Amplitude> matrix,
+                          std::span<const size_t> controls = {});
+
+        /// @brief Reorders qubits.
+        /// @param targets The target qubits. Bit i of an entry of the table corresponds to targets[i].
+        /// @param table The image of each of the 2^k basis states of the targets, which must only move their bits.
+        /// @param controls The control qubits, which must be empty.
+        void applyPermutation(std::span<const size_t> targets, std::span<const size_t> table,
+                              std::span<const size_t> controls = {});
+
+        /// @brief Applies a NOT transformation.
+        /// @param target The target qubit.
+        /// @param controls The control qubits, at most one.
+        void applyX(const size_t &target, std::span<const size_t> controls = {});
+
+        /// @brief Multiplies the ❘1〉 component of the target qubit by a phase.
+        /// @param target The target qubit.
+        /// @param phase The phase factor: a power of i, or ±1 with a control.
+        /// @param controls The control qubits, at most one.
+        void applyPhase(const size_t &target, const Amplitude &phase, std::span<const size_t> controls = {});
+
+        /// @brief Applies a diagonal operation on a range of consecutive qubits.
+        /// @param lowestQubit The lowest qubit of the range.
+        /// @param phases The phase of each of the 2^k basis states of the k qubits of the range.
+        void applyDiagonal(const size_t &lowestQubit, std::span<const Amplitude> phases);
+
+        /// @brief Swaps the states of two qubits.
+        /// @param qubit1 The first qubit.
+        /// @param qubit2 The second qubit.
+        /// @param controls The control qubits, which must be empty.
+        void applySwap(const size_t &qubit1, const size_t &qubit2, std::span<const size_t> controls = {});
+
+        /// @brief Gets the probability of measuring 1 on the given qubit.
+        /// @param target The qubit.
+        /// @return 0, 1/2 or 1, as stabilizer states only have these outcome probabilities.
+        [[nodiscard]] FloatingNumberType getOneProbability(const size_t &target) const;
+
+        /// @brief Measures a qubit.
+        ///
+        /// WARNING: This function collapses the register to the measured outcome.
+        /// @param target The qubit to measure.
+        /// @return The measured state of the qubit.
+        ClassicBit measure(const size_t &target);
+
+        /// @brief Resets a qubit to ❘0〉 and then applies a Clifford unitary on it.
+        /// @param target The qubit.
+        /// @param preparation The unitary mapping ❘0〉 to the state to prepare.
+        void initialize(const size_t &target, const Matrix &preparation);
+
+        /// @brief Always throws, as the state of a single qubit is not kept by the tableau.
+        [[nodiscard]] typename Qubit<FloatingNumberType>::State getQubitState(const size_t &target) const;
+
+        /// @brief Checks if a single-qubit unitary, with the given number of controls, is a Clifford operation.
+        [[nodiscard]] static bool isClifford(const Matrix &matrix, const size_t &controlCount);
+
+        /// @brief Checks if multiplying the ❘1〉 component of a qubit by a phase, with the given number of controls, is
+        /// a Clifford operation.
+        [[nodiscard]] static bool isClifford(const Amplitude &phase, const size_t &controlCount);
+
+        /// @brief Checks if a permutation of basis states, with the given number of controls, only reorders qubits.
+        [[nodiscard]] static bool isClifford(std::span<const size_t> table, const size_t &controlCount);
+
+        /// @brief Checks if a diagonal operation is a Clifford operation.
+        [[nodiscard]] static bool isClifford(std::span<const Amplitude> phases);
+
+        /// @brief Gets the representation of the register.
+        /// @return The stabilizer generators, one per line.
+        [[nodiscard]] std::string getRepresentation() const override;
+    };
+
+#include "templates/tableau.tpp"
+
+}
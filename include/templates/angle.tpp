@@ -0,0 +1,86 @@
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType>::UnboundParameterException::UnboundParameterException(const size_t &parameter,
+                                                                                const size_t &valueCount):
+        std::runtime_error("Parameter " + std::to_string(parameter) + " is not bound (" + std::to_string(valueCount) +
+                           " values bound)"),
+        parameter(parameter),
+        valueCount(valueCount) {}
+
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType>::Angle(const size_t &parameter, const FloatingNumberType &coefficient,
+                                 const FloatingNumberType &offset):
+        parameter(parameter),
+        coefficient(coefficient),
+        offset(offset) {}
+
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType>::Angle(const FloatingNumberType &value): offset(value) {}
+
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType> Angle<FloatingNumberType>::Parameter(const size_t &index) {
+    return Angle(index, 1, 0);
+}
+
+template<std_floating_point FloatingNumberType>
+bool Angle<FloatingNumberType>::isParametric() const {
+    return parameter != NO_PARAMETER;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Angle<FloatingNumberType>::getParameter() const {
+    return parameter;
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType Angle<FloatingNumberType>::getCoefficient() const {
+    return coefficient;
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType Angle<FloatingNumberType>::getOffset() const {
+    return offset;
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType Angle<FloatingNumberType>::evaluate(std::span<const FloatingNumberType> values) const {
+    if(!isParametric()){
+        return offset;
+    }
+    if(parameter >= values.size()){
+        throw UnboundParameterException(parameter, values.size());
+    }
+    return offset + coefficient * values[parameter];
+}
+
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType> Angle<FloatingNumberType>::operator-() const {
+    return Angle(parameter, -coefficient, -offset);
+}
+
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType> Angle<FloatingNumberType>::operator+(const FloatingNumberType &value) const {
+    return Angle(parameter, coefficient, offset + value);
+}
+
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType> Angle<FloatingNumberType>::operator-(const FloatingNumberType &value) const {
+    return Angle(parameter, coefficient, offset - value);
+}
+
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType> Angle<FloatingNumberType>::operator*(const FloatingNumberType &factor) const {
+    return Angle(parameter, coefficient * factor, offset * factor);
+}
+
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType> Angle<FloatingNumberType>::operator/(const FloatingNumberType &divisor) const {
+    return Angle(parameter, coefficient / divisor, offset / divisor);
+}
+
+template<std_floating_point FloatingNumberType>
+std::string Angle<FloatingNumberType>::getRepresentation() const {
+    if(!isParametric()){
+        return std::to_string(offset);
+    }
+    return std::to_string(offset) + " + " + std::to_string(coefficient) + "×θ[" + std::to_string(parameter) + "]";
+}
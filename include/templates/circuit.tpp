@@ -2,139 +2,262 @@ template<std_floating_point FloatingNumberType>
 Circuit<FloatingNumberType>::Circuit(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
                                      const size_t &qubitCount, const size_t &classicBitCount):
                                         probabilityEngine(probabilityEngine),
-                                        qubits(std::vector<Qubit<FloatingNumberType>>(qubitCount, Qubit<FloatingNumberType>(probabilityEngine))),
-                                        classicBits(std::vector<ClassicBit>(classicBitCount)) {}
+                                        state(probabilityEngine, qubitCount),
+                                        tableau(probabilityEngine, qubitCount),
+                                        matrixProductState(probabilityEngine, qubitCount),
+                                        sparseState(probabilityEngine, qubitCount),
+                                        classicBits(std::vector<ClassicBit>(classicBitCount)),
+                                        classicBitCount(classicBitCount),
+                                        qubitMap(qubitCount),
+                                        layout(qubitCount) {
+    for(size_t i = 0; i < qubitCount; i++){
+        qubitMap[i] = i;
+        layout[i] = i;
+    }
+}
 
 template<std_floating_point FloatingNumberType>
 Circuit<FloatingNumberType>::Circuit(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
                                      const size_t &qubitCount):
-        probabilityEngine(probabilityEngine),
-        qubits(std::vector<Qubit<FloatingNumberType>>(qubitCount, Qubit<FloatingNumberType>(probabilityEngine))) {}
-
-template<std_floating_point FloatingNumberType>
-typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::Gate::getStandardDrawing(const Circuit<FloatingNumberType>* circuit, const std::string& identifier, const size_t& qubitIndex){
-    std::array<std::string, 3> drawing = {"    ", "────", "    "};
-    std::array<std::string, 3> targetDrawing = {"┌──┐", "┤  ├", "└──┘"};
-    std::array<std::string, 3> measureDrawing = {"    ", "════", "    "};
-    targetDrawing[1].insert(targetDrawing[1].length() / 2, identifier);
-    for(size_t i = 0; i < identifier.length(); i++){
-        drawing[0].insert(1, " ");
-        drawing[1].insert(std::string("─").length(), "─");
-        drawing[2].insert(1, " ");
-        targetDrawing[0].insert(std::string("─").length(), "─");
-        targetDrawing[2].insert(std::string("─").length(), "─");
-        measureDrawing[0].insert(1, " ");
-        measureDrawing[1].insert(std::string("═").length(), "═");
-        measureDrawing[2].insert(1, " ");
-    }
-    std::vector<std::array<std::string, 3>> drawings(circuit->qubits.size() + 1, drawing);
-    drawings[qubitIndex] = targetDrawing;
-    drawings[circuit->qubits.size()] = measureDrawing;
-    return drawings;
+        Circuit(probabilityEngine, qubitCount, 0) {}
+
+template<std_floating_point FloatingNumberType>
+std::string Circuit<FloatingNumberType>::Gate::repeatGlyph(const std::string &glyph, const size_t &count) {
+    std::string repeated;
+    repeated.reserve(glyph.size() * count);
+    for(size_t i = 0; i < count; i++){
+        repeated += glyph;
+    }
+    return repeated;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::Gate::getDisplayWidth(const std::string &line) {
+    // Continuation bytes of UTF-8 code points have the form 10xxxxxx
+    return std::count_if(line.begin(), line.end(), [](const char &byte){
+        return (static_cast<unsigned char>(byte) & 0xC0) != 0x80;
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Gate::extendDrawings(Drawings &drawings, const size_t &row, const size_t &classicRow) {
+    const size_t width = getDisplayWidth(drawings.rows.front()[1]);
+    const auto wireDrawing = [&](const size_t &wireRow){
+        return std::array<std::string, 3>{std::string(width, ' '), repeatGlyph(wireRow == classicRow ? "═" : "─", width),
+                                          std::string(width, ' ')};
+    };
+    if(row < drawings.firstRow){
+        std::vector<std::array<std::string, 3>> rows;
+        rows.reserve(drawings.firstRow - row + drawings.rows.size());
+        for(size_t i = row; i < drawings.firstRow; i++){
+            rows.push_back(wireDrawing(i));
+        }
+        rows.insert(rows.end(), std::make_move_iterator(drawings.rows.begin()), std::make_move_iterator(drawings.rows.end()));
+        drawings.rows = std::move(rows);
+        drawings.firstRow = row;
+    }
+    while(drawings.firstRow + drawings.rows.size() <= row){
+        drawings.rows.push_back(wireDrawing(drawings.firstRow + drawings.rows.size()));
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::Gate::getStandardDrawing(const Circuit<FloatingNumberType>*, const std::string& identifier, const size_t& qubitIndex){
+    const std::string border = repeatGlyph("─", identifier.length() + 2);
+    return {qubitIndex, {{"┌" + border + "┐", "┤ " + identifier + " ├", "└" + border + "┘"}}};
 }
 
 template<std_floating_point FloatingNumberType>
-typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::ControlledGate::getStandardDrawing(const Circuit<FloatingNumberType>* circuit, const std::string& identifier, const size_t& qubitIndex) const{
+typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::ControlledGate::getStandardDrawing(const Circuit<FloatingNumberType>*, const std::string& identifier, const size_t& qubitIndex) const{
     const bool controlBeforeTarget = controlIndex < qubitIndex;
-    std::array<std::string, 3> outsideDrawing = {"    ", "────", "    "};
-    std::array<std::string, 3> insideDrawing = {" │  ", "─┼──", " │  "};
-    std::array<std::string, 3> controlDrawing = {"    ", "─▉──", "    "};
-    controlDrawing[controlBeforeTarget ? 2 : 0] = " │  ";
-    std::array<std::string, 3> targetDrawing = {"┌──┐", "┤  ├", "└──┘"};
-    if(controlBeforeTarget){
-        targetDrawing[0] = "┌┴─┐";
-    } else {
-        targetDrawing[2] = "└┬─┘";
-    }
-    std::array<std::string, 3> measureDrawing = {"    ", "════", "    "};
-    targetDrawing[1].insert(targetDrawing[1].length() / 2, identifier);
-    for(size_t i = 0; i < identifier.length(); i++){
-        const auto insertionLambda = [i](const std::string& string, const std::string& singleCharacter){
-            return i % 2 == 0 ? singleCharacter.length() : string.length() - singleCharacter.length();
-        };
-        outsideDrawing[0].insert(insertionLambda(outsideDrawing[0], " "), " ");
-        outsideDrawing[1].insert(insertionLambda(outsideDrawing[1], "─"), "─");
-        outsideDrawing[2].insert(insertionLambda(outsideDrawing[2], " "), " ");
-        insideDrawing[0].insert(insertionLambda(insideDrawing[0], " "), " ");
-        insideDrawing[1].insert(insertionLambda(insideDrawing[1], "─"), "─");
-        insideDrawing[2].insert(insertionLambda(insideDrawing[2], " "), " ");
-        controlDrawing[0].insert(insertionLambda(controlDrawing[0], " "), " ");
-        controlDrawing[1].insert(insertionLambda(controlDrawing[1], "─"), "─");
-        controlDrawing[2].insert(insertionLambda(controlDrawing[2], " "), " ");
-        targetDrawing[0].insert(insertionLambda(targetDrawing[0], "─"), "─");
-        targetDrawing[2].insert(insertionLambda(targetDrawing[2], "─"), "─");
-        measureDrawing[0].insert(insertionLambda(measureDrawing[0], " "), " ");
-        measureDrawing[1].insert(insertionLambda(measureDrawing[1], "═"), "═");
-        measureDrawing[2].insert(insertionLambda(measureDrawing[2], " "), " ");
-    }
-    std::vector<std::array<std::string, 3>> drawings(circuit->qubits.size() + 1);
-    size_t i;
-    for(i = 0; i < std::min(controlIndex, qubitIndex); i++){
-        drawings[i] = outsideDrawing;
-    }
-    drawings[i] = controlBeforeTarget ? controlDrawing : targetDrawing;
-    for(i++; i < std::max(controlIndex, qubitIndex); i++){
-        drawings[i] = insideDrawing;
-    }
-    drawings[i] = controlBeforeTarget ? targetDrawing : controlDrawing;
-    for(i++; i < circuit->qubits.size(); i++){
-        drawings[i] = outsideDrawing;
-    }
-    drawings[i] = measureDrawing;
+    // The vertical line joining the control to the target runs through the middle of the box
+    const size_t left = 1 + (identifier.length() + 1) / 2;
+    const size_t right = 2 + identifier.length() / 2;
+    const std::string blank = std::string(left + 1 + right, ' ');
+    const std::string vertical = std::string(left, ' ') + "│" + std::string(right, ' ');
+    const std::array<std::string, 3> insideDrawing = {vertical, Gate::repeatGlyph("─", left) + "┼" + Gate::repeatGlyph("─", right), vertical};
+    std::array<std::string, 3> controlDrawing = {blank, Gate::repeatGlyph("─", left) + "▉" + Gate::repeatGlyph("─", right), blank};
+    controlDrawing[controlBeforeTarget ? 2 : 0] = vertical;
+    const std::string border = Gate::repeatGlyph("─", left + right - 1);
+    const std::string joint = Gate::repeatGlyph("─", left - 1) + (controlBeforeTarget ? "┴" : "┬") + Gate::repeatGlyph("─", right - 1);
+    const std::array<std::string, 3> targetDrawing = {"┌" + (controlBeforeTarget ? joint : border) + "┐",
+                                                      "┤ " + identifier + " ├",
+                                                      "└" + (controlBeforeTarget ? border : joint) + "┘"};
+    typename Gate::Drawings drawings;
+    drawings.firstRow = std::min(controlIndex, qubitIndex);
+    drawings.rows.reserve(std::max(controlIndex, qubitIndex) - drawings.firstRow + 1);
+    drawings.rows.push_back(controlBeforeTarget ? controlDrawing : targetDrawing);
+    for(size_t i = drawings.firstRow + 1; i < std::max(controlIndex, qubitIndex); i++){
+        drawings.rows.push_back(insideDrawing);
+    }
+    drawings.rows.push_back(controlBeforeTarget ? targetDrawing : controlDrawing);
     return drawings;
 }
 
 template<std_floating_point FloatingNumberType>
 std::string Circuit<FloatingNumberType>::getRepresentation() const {
-    std::vector<std::array<std::string, 3>> drawings(qubits.size() + 1, {"", "", ""});
-    size_t maxQubitNameLength = std::to_string(qubits.size() - 1).length();
-    for(size_t i = 0; i < qubits.size(); i++){
-        for(size_t j = 0; j < maxQubitNameLength + 4; j++) {
-            drawings[i][0] += " ";
-            drawings[i][2] += " ";
-        }
-        std::string qubitName = std::to_string(i);
-        for(size_t j = 0; j < maxQubitNameLength - qubitName.length(); j++){
-            drawings[i][1] += " ";
-        }
-        drawings[i][1] += "Q#" + qubitName + " >";
-    }
-    for(size_t i = 0; i < maxQubitNameLength + 1; i++) {
-        drawings[qubits.size()][0] += " ";
-        drawings[qubits.size()][1] += " ";
-        drawings[qubits.size()][2] += " ";
-    }
-    drawings[qubits.size()][0] += "   ";
-    drawings[qubits.size()][1] += "C >";
-    drawings[qubits.size()][2] += "   ";
-    for(const auto& gate : gates){
-        const auto& gateDrawings = gate->getDrawings(this);
-        for(size_t i = 0; i < gateDrawings.size(); i++){
-            drawings[i][0] += gateDrawings[i][0];
-            drawings[i][1] += gateDrawings[i][1];
-            drawings[i][2] += gateDrawings[i][2];
-        }
-    }
-    std::string representation;
-    for(const auto& drawing : drawings) {
-        representation += drawing[0] + "\n" + drawing[1] + "\n" + drawing[2] + "\n";
+    std::ostringstream stream;
+    draw(stream);
+    return stream.str();
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::draw(std::ostream &stream) const {
+    draw(stream, DrawingWindow());
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::draw(std::ostream &stream, const DrawingWindow &window) const {
+    // The three lines a gate draws on one of the rows of the window
+    struct Cell {
+        size_t column;
+        size_t width;
+        std::array<std::string, 3> drawing;
+    };
+    const size_t qubitCount = getQubitCount();
+    const size_t classicRow = qubitCount;
+    const size_t firstGate = std::min(window.firstGate, gates->size());
+    const size_t lastGate = firstGate + std::min(window.gateCount, gates->size() - firstGate);
+    const size_t firstQubit = std::min(window.firstQubit, qubitCount);
+    const size_t lastQubit = firstQubit + std::min(window.qubitCount, qubitCount - firstQubit);
+    const auto isVisible = [&](const size_t &row){
+        return row == classicRow || (row >= firstQubit && row < lastQubit);
+    };
+
+    // Every gate goes in the first column after the ones used by the rows it spans
+    std::vector<size_t> nextColumns(qubitCount + 1, 0);
+    std::vector<size_t> columnWidths;
+    std::vector<std::vector<Cell>> cells(qubitCount + 1);
+    for(size_t gateIndex = firstGate; gateIndex < lastGate; gateIndex++){
+        auto drawings = (*gates)[gateIndex]->getDrawings(this);
+        const size_t lastRow = drawings.firstRow + drawings.rows.size();
+        size_t column = 0;
+        for(size_t row = drawings.firstRow; row < lastRow; row++){
+            column = std::max(column, nextColumns[row]);
+        }
+        for(size_t row = drawings.firstRow; row < lastRow; row++){
+            nextColumns[row] = column + 1;
+        }
+        if(column == columnWidths.size()){
+            columnWidths.push_back(0);
+        }
+        const size_t width = Gate::getDisplayWidth(drawings.rows.front()[1]);
+        for(size_t row = drawings.firstRow; row < lastRow; row++){
+            if(isVisible(row)){
+                columnWidths[column] = std::max(columnWidths[column], width);
+                cells[row].push_back({column, width, std::move(drawings.rows[row - drawings.firstRow])});
+            }
+        }
     }
-    return representation;
+
+    // The wires are written from strings long enough for the widest column, built once
+    const size_t maxWidth = columnWidths.empty() ? 0 : *std::max_element(columnWidths.begin(), columnWidths.end());
+    const std::string spaces(maxWidth, ' ');
+    const std::string wire = Gate::repeatGlyph("─", maxWidth);
+    const std::string classicWire = Gate::repeatGlyph("═", maxWidth);
+    const size_t glyphSize = std::string("─").size();
+    const auto writeWire = [&](const size_t &row, const size_t &line, const size_t &width){
+        if(line != 1){
+            stream.write(spaces.data(), static_cast<std::streamsize>(width));
+        } else {
+            stream.write((row == classicRow ? classicWire : wire).data(), static_cast<std::streamsize>(width * glyphSize));
+        }
+    };
+
+    const size_t maxQubitNameLength = qubitCount == 0 ? 1 : std::to_string(qubitCount - 1).length();
+    const auto writeRow = [&](const size_t &row){
+        for(size_t line = 0; line < 3; line++){
+            if(row == classicRow){
+                stream << std::string(maxQubitNameLength + 1, ' ') << (line == 1 ? "C >" : "   ");
+            } else if(line == 1){
+                const std::string qubitName = std::to_string(row);
+                stream << std::string(maxQubitNameLength - qubitName.length(), ' ') << "Q#" << qubitName << " >";
+            } else {
+                stream << std::string(maxQubitNameLength + 4, ' ');
+            }
+            auto cell = cells[row].begin();
+            for(size_t column = 0; column < columnWidths.size(); column++){
+                if(cell != cells[row].end() && cell->column == column){
+                    stream << cell->drawing[line];
+                    writeWire(row, line, columnWidths[column] - cell->width);
+                    ++cell;
+                } else {
+                    writeWire(row, line, columnWidths[column]);
+                }
+            }
+            stream << '\n';
+        }
+    };
+    for(size_t row = firstQubit; row < lastQubit; row++){
+        writeRow(row);
+    }
+    writeRow(classicRow);
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::Result::Result(const size_t &bitCount): bitCount(bitCount),
+                                                                  words(std::max<size_t>((bitCount + 63) / 64, 1), 0) {}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::Result::Result(const std::vector<ClassicBit> &classicBits): Result(classicBits, classicBits.size()) {}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::Result::Result(const std::vector<ClassicBit> &classicBits, const size_t &bitCount): Result(bitCount) {
+    load(classicBits, bitCount);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Result::load(const std::vector<ClassicBit> &classicBits, const size_t &bitCount) {
+    this->bitCount = bitCount;
+    words.assign(std::max<size_t>((bitCount + 63) / 64, 1), 0);
+    for(size_t i = 0; i < bitCount; i++){
+        words[i / 64] |= std::uint64_t(classicBits[i].getState() == ClassicBit::State::ONE) << (i % 64);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::Result::Result(const size_t &bitCount, std::span<const std::uint64_t> words): Result(bitCount) {
+    std::copy_n(words.begin(), std::min(words.size(), this->words.size()), this->words.begin());
 }
 
 template<std_floating_point FloatingNumberType>
-Circuit<FloatingNumberType>::Result::Result(const std::vector<ClassicBit> &classicBits): classicBits(classicBits) {}
+size_t Circuit<FloatingNumberType>::Result::getBitCount() const {
+    return bitCount;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::Result::getBit(const size_t &index) const {
+    return (words[index / 64] >> (index % 64)) & 1;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Result::setBit(const size_t &index, const bool &value) {
+    const std::uint64_t mask = std::uint64_t(1) << (index % 64);
+    words[index / 64] = value ? words[index / 64] | mask : words[index / 64] & ~mask;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<std::uint64_t> &Circuit<FloatingNumberType>::Result::getWords() const {
+    return words;
+}
 
 template<std_floating_point FloatingNumberType>
 std::string Circuit<FloatingNumberType>::Result::getRepresentation() const {
-    std::string representation;
-    for(auto& classicBit : classicBits){
-        representation += classicBit.getRepresentation();
+    std::string representation(bitCount, '0');
+    for(size_t i = 0; i < bitCount; i++){
+        if(getBit(i)){
+            representation[bitCount - 1 - i] = '1';
+        }
     }
-    std::reverse(representation.begin(), representation.end());
     return representation;
 }
 
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::CompoundResult::ResultWidthMismatchException::ResultWidthMismatchException(const size_t &expected, const size_t &actual):
+std::runtime_error("Cannot add a result of " + std::to_string(actual) + " classic bits to results of " + std::to_string(expected) + " classic bits"),
+expected(expected),
+actual(actual) {}
+
 template<std_floating_point FloatingNumberType>
 Circuit<FloatingNumberType>::CompoundResult::CompoundResult() = default;
 
@@ -145,24 +268,115 @@ Circuit<FloatingNumberType>::CompoundResult::CompoundResult(const std::vector<Re
     }
 }
 
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CompoundResult::checkWidth(const size_t &bitCount) {
+    if(histogram.getBitCount() == bitCount){
+        return;
+    }
+    // The width is fixed by the first result
+    if(histogram.getTotal() != 0){
+        throw ResultWidthMismatchException(histogram.getBitCount(), bitCount);
+    }
+    histogram = Histogram(bitCount);
+}
+
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::CompoundResult::addResult(const Circuit::Result &result) {
-    const auto& representation = result.getRepresentation();
-    if(resultMap.find(representation) == resultMap.end()){
-        resultMap[representation] = 1;
-    } else {
-        resultMap[representation]++; 
+    addResult(result, 1);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CompoundResult::addResult(const Circuit::Result &result, const size_t &count) {
+    checkWidth(result.getBitCount());
+    histogram.add(result.getWords(), count);
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::CompoundResult::getCount(const Result &result) const {
+    return histogram.getBitCount() == result.getBitCount() ? histogram.getCount(result.getWords()) : 0;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::CompoundResult::getShotCount() const {
+    return histogram.getTotal();
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<std::pair<typename Circuit<FloatingNumberType>::Result, size_t>> Circuit<FloatingNumberType>::CompoundResult::getResults() const {
+    std::vector<std::pair<Result, size_t>> results;
+    for (const auto& [words, count] : histogram.getEntries()){
+        results.emplace_back(Result(histogram.getBitCount(), words), count);
+    }
+    return results;
+}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::CompoundResult &Circuit<FloatingNumberType>::CompoundResult::operator+=(const CompoundResult &other) {
+    if(other.histogram.getTotal() == 0){
+        return *this;
     }
+    checkWidth(other.histogram.getBitCount());
+    histogram += other.histogram;
+    return *this;
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::Workspace::Workspace(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine):
+        probabilityEngine(probabilityEngine),
+        state(probabilityEngine, 0),
+        tableau(probabilityEngine, 0),
+        matrixProductState(probabilityEngine, 0),
+        sparseState(probabilityEngine, 0) {}
+
+template<std_floating_point FloatingNumberType>
+template<class Function>
+void Circuit<FloatingNumberType>::Workspace::visitRegister(const Backend &backend, const Function &function) {
+    switch(backend){
+        case STABILIZER:
+            function(tableau);
+            break;
+        case MATRIX_PRODUCT_STATE:
+            function(matrixProductState);
+            break;
+        case SPARSE:
+            function(sparseState);
+            break;
+        default:
+            function(state);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+const typename Circuit<FloatingNumberType>::Result &Circuit<FloatingNumberType>::Workspace::getResult() const {
+    return result;
+}
+
+template<std_floating_point FloatingNumberType>
+const StateVector<FloatingNumberType> &Circuit<FloatingNumberType>::Workspace::getState() const {
+    return state;
+}
+
+template<std_floating_point FloatingNumberType>
+const Tableau<FloatingNumberType> &Circuit<FloatingNumberType>::Workspace::getTableau() const {
+    return tableau;
+}
+
+template<std_floating_point FloatingNumberType>
+const MatrixProductState<FloatingNumberType> &Circuit<FloatingNumberType>::Workspace::getMatrixProductState() const {
+    return matrixProductState;
+}
+
+template<std_floating_point FloatingNumberType>
+const SparseStateVector<FloatingNumberType> &Circuit<FloatingNumberType>::Workspace::getSparseState() const {
+    return sparseState;
 }
 
 template<std_floating_point FloatingNumberType>
 std::string Circuit<FloatingNumberType>::CompoundResult::getRepresentation() const {
-    std::string representation = "{\n";
-    for (const auto& [key, value] : resultMap){
-        representation += "\t❘" + key + "〉 : " + std::to_string(value) + ",\n";
+    std::string representation = "{";
+    for (const auto& [result, count] : getResults()){
+        representation += (representation.size() == 1 ? "\n\t❘" : ",\n\t❘") + result.getRepresentation() + "〉 : " + std::to_string(count);
     }
-    representation.pop_back();
-    representation.pop_back();
     representation += "\n}";
     return representation;
 }
@@ -179,28 +393,76 @@ void Circuit<FloatingNumberType>::addGate(std::unique_ptr<Gate> gate){
         }
         circuitGate->setQubitIndices(qubitIndices);
     }
-    gate->verify(this);
-    // Transfer ownership of the gate to the circuitPointer
-    gates.emplace_back(std::move(gate));
+    if constexpr (VALIDATION_ENABLED) {
+        gate->verify(this);
+    }
+    appendGate(std::move(gate));
 }
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::addGate(std::unique_ptr<CircuitGate> gate, const std::vector<size_t>& qubitIndices){
     gate->setQubitIndices(qubitIndices);
-    gate->verify(this);
+    if constexpr (VALIDATION_ENABLED) {
+        gate->verify(this);
+    }
+    appendGate(std::move(gate));
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::appendGate(std::unique_ptr<Gate> gate) {
     // Transfer ownership of the gate to the circuitPointer
-    gates.emplace_back(std::move(gate));
+    GateList &mutableGates = getMutableGates();
+    if(circuitGateInlining){
+        for(auto& flattenedGate : gate->flatten()){
+            mutableGates.emplace_back(std::move(flattenedGate));
+        }
+    } else {
+        mutableGates.emplace_back(std::move(gate));
+    }
+    program.reset();
+    flattenedGates.reset();
+}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::GateList &Circuit<FloatingNumberType>::getMutableGates() {
+    if(gates.use_count() > 1){
+        gates = std::make_shared<GateList>(*gates);
+    }
+    return *gates;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<std::unique_ptr<typename Circuit<FloatingNumberType>::Gate>> &Circuit<FloatingNumberType>::getFlattenedGates() {
+    if(!flattenedGates){
+        auto flattened = std::make_shared<std::vector<std::unique_ptr<Gate>>>();
+        for(const auto& gate : *gates){
+            for(auto& flattenedGate : gate->flatten()){
+                flattened->emplace_back(std::move(flattenedGate));
+            }
+        }
+        flattenedGates = flattened;
+    }
+    return *flattenedGates;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::setCircuitGateInlining(const bool &enabled) {
+    circuitGateInlining = enabled;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::isCircuitGateInlining() const {
+    return circuitGateInlining;
 }
 
 template<std_floating_point FloatingNumberType>
 bool Circuit<FloatingNumberType>::ControlledGate::getControlState(Circuit<FloatingNumberType> *circuit) const {
-    auto& controlQubit = circuit->qubits[controlIndex];
-    return controlQubit.measure().getState() == ClassicBit::State::ONE;
+    return circuit->state.measure(circuit->resolveQubit(controlIndex)).getState() == ClassicBit::State::ONE;
 }
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::ControlledGate::verify(const Circuit* circuit) const {
-    if(controlIndex >= circuit->qubits.size()){
+    if(controlIndex >= circuit->getQubitCount()){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(controlIndex);
     }
 }
@@ -208,12 +470,206 @@ void Circuit<FloatingNumberType>::ControlledGate::verify(const Circuit* circuit)
 template<std_floating_point FloatingNumberType>
 Circuit<FloatingNumberType>::ControlledGate::ControlledGate(const size_t& controlIndex): controlIndex(controlIndex) {}
 
+template<std_floating_point FloatingNumberType>
+std::shared_ptr<const Program<FloatingNumberType>> Circuit<FloatingNumberType>::compile() {
+    if(program){
+        return program;
+    }
+    auto compiled = std::make_shared<Program<FloatingNumberType>>(getQubitCount(), classicBitCount);
+    // The state is read by the caller at the end and before the terminal measurements, when they are sampled
+    const size_t measurementsStart = getTerminalMeasurementsStart();
+    for(size_t i = 0; i < gates->size(); i++){
+        if(i == measurementsStart){
+            restoreLayout(*compiled);
+        }
+        compiled->beginGate();
+        compileGate(*(*gates)[i], *compiled);
+    }
+    restoreLayout(*compiled);
+    compiled->batchDiagonals(backend == MATRIX_PRODUCT_STATE ? MatrixProductState<FloatingNumberType>::MAX_DIAGONAL_SPAN
+                                                             : Program<FloatingNumberType>::MAX_DIAGONAL_SPAN);
+    program = compiled;
+    return program;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::compileGate(const Gate &gate, Program<FloatingNumberType> &program_) {
+    if(profiling){
+        program_.beginProfile(gate.getSymbol());
+    }
+    gate.compile(this, program_);
+    if(profiling){
+        program_.endProfile();
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::setProfiling(const bool &enabled) {
+    if(profiling != enabled){
+        profiling = enabled;
+        program.reset();
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::isProfiling() const {
+    return profiling;
+}
+
+template<std_floating_point FloatingNumberType>
+const Profile &Circuit<FloatingNumberType>::getProfile() const {
+    return profile;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::setBackend(const Backend &backend_) {
+    // Programs compiled for a matrix product state restore the layout and batch the diagonal gates differently
+    if((backend == MATRIX_PRODUCT_STATE) != (backend_ == MATRIX_PRODUCT_STATE)){
+        program.reset();
+    }
+    backend = backend_;
+}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::Backend Circuit<FloatingNumberType>::getBackend() const {
+    return backend;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::isClifford() {
+    return getProgram().isClifford();
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::setTruncation(const typename MatrixProductState<FloatingNumberType>::Truncation &truncation) {
+    matrixProductState.setTruncation(truncation);
+}
+
+template<std_floating_point FloatingNumberType>
+const typename MatrixProductState<FloatingNumberType>::Truncation &Circuit<FloatingNumberType>::getTruncation() const {
+    return matrixProductState.getTruncation();
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType Circuit<FloatingNumberType>::getDiscardedWeight() const {
+    return discardedWeight;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::setSparsity(const typename SparseStateVector<FloatingNumberType>::Sparsity &sparsity) {
+    sparseState.setSparsity(sparsity);
+}
+
+template<std_floating_point FloatingNumberType>
+const typename SparseStateVector<FloatingNumberType>::Sparsity &Circuit<FloatingNumberType>::getSparsity() const {
+    return sparseState.getSparsity();
+}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::Backend Circuit<FloatingNumberType>::getRunBackend() {
+    if(backend == AUTOMATIC){
+        return isClifford() ? STABILIZER : STATE_VECTOR;
+    }
+    return backend;
+}
+
 template<std_floating_point FloatingNumberType>
 typename Circuit<FloatingNumberType>::Result Circuit<FloatingNumberType>::run() {
-    for(auto& gate : gates){
-        gate->apply(this);
+    const Program<FloatingNumberType>& compiled = getProgram();
+    const Backend backend_ = getRunBackend();
+    if(backend_ == STABILIZER && !tableau.isInitialized()){
+        tableau.reset();
+    }
+    if(backend_ == MATRIX_PRODUCT_STATE && !matrixProductState.isInitialized()){
+        matrixProductState.reset();
+    }
+    if(backend_ == SPARSE && !sparseState.isInitialized()){
+        sparseState.reset();
+    }
+    if(backend_ == STATE_VECTOR && !state.isInitialized()){
+        state.reset();
+    }
+    if(classicBits.size() < compiled.getClassicBitCount()){
+        classicBits.resize(compiled.getClassicBitCount());
+    }
+    Profile *profile_ = profiling ? &profile : nullptr;
+    if(profile_ != nullptr){
+        profile = compiled.getProfile();
     }
-    return Result(classicBits);
+    const auto start = Profile::Clock::now();
+    if(backend_ == STABILIZER){
+        compiled.execute(tableau, classicBits, profile_);
+    } else if(backend_ == MATRIX_PRODUCT_STATE){
+        compiled.execute(matrixProductState, classicBits, profile_);
+        discardedWeight = matrixProductState.getDiscardedWeight();
+    } else if(backend_ == SPARSE){
+        compiled.execute(sparseState, classicBits, profile_);
+    } else {
+        compiled.execute(state, classicBits, profile_);
+    }
+    if(profile_ != nullptr){
+        profile.addRun(start, 1);
+    }
+    return getResult();
+}
+
+template<std_floating_point FloatingNumberType>
+const typename Circuit<FloatingNumberType>::Result &Circuit<FloatingNumberType>::run(Workspace &workspace) {
+    const Program<FloatingNumberType>& compiled = getProgram();
+    const Backend backend_ = getRunBackend();
+    prepareWorkspace(compiled, workspace, backend_);
+    if(profiling){
+        profile = compiled.getProfile();
+        const auto start = Profile::Clock::now();
+        runShot(compiled, workspace, backend_, &profile);
+        profile.addRun(start, 1);
+    } else {
+        runShot(compiled, workspace, backend_);
+    }
+    if(backend_ == MATRIX_PRODUCT_STATE){
+        discardedWeight = workspace.matrixProductState.getDiscardedWeight();
+    }
+    return workspace.result;
+}
+
+template<std_floating_point FloatingNumberType>
+const Program<FloatingNumberType> &Circuit<FloatingNumberType>::getProgram() {
+    if(!program){
+        compile();
+    }
+    return *program;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::prepareWorkspace(const Program<FloatingNumberType> &compiled, Workspace &workspace,
+                                                   const Backend &backend_) const {
+    // Only the register used by the shots is sized, so a stabilizer run never allocates a state vector
+    workspace.visitRegister(backend_, [&](auto &register_){
+        if(register_.getQubitCount() != getQubitCount()){
+            register_.resize(getQubitCount());
+        }
+    });
+    workspace.matrixProductState.setTruncation(matrixProductState.getTruncation());
+    workspace.sparseState.setSparsity(sparseState.getSparsity());
+    if(workspace.classicBits.size() < compiled.getClassicBitCount()){
+        workspace.classicBits.resize(compiled.getClassicBitCount());
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::runShot(const Program<FloatingNumberType> &compiled, Workspace &workspace,
+                                          const Backend &backend_, Profile *profile_) const {
+    std::fill(workspace.classicBits.begin(), workspace.classicBits.end(), ClassicBit());
+    workspace.visitRegister(backend_, [&](auto &register_){
+        register_.reset();
+        compiled.execute(register_, workspace.classicBits, profile_);
+    });
+    workspace.result.load(workspace.classicBits, classicBitCount);
+}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::Result Circuit<FloatingNumberType>::getResult() const {
+    return Result(classicBits, classicBitCount);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -269,18 +725,18 @@ void Circuit<FloatingNumberType>::addSwapGate(const size_t &qubitIndex1, const s
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::addCircuitGate(const Circuit<FloatingNumberType>& circuit, const std::vector<size_t> &qubitIndices) {
-    addGate(std::make_unique<CircuitGate>(circuit, qubitIndices));
+    addGate(std::make_unique<CircuitGate>(circuit), qubitIndices);
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::addPhaseGate(const size_t &qubitIndex, const FloatingNumberType &angle) {
+void Circuit<FloatingNumberType>::addPhaseGate(const size_t &qubitIndex, const Angle<FloatingNumberType> &angle) {
     addGate(std::make_unique<PhaseGate>(qubitIndex, angle));
 }
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::addControlledPhaseGate(const size_t &controlQubitIndex,
                                                          const size_t &targetQubitIndex,
-                                                         const FloatingNumberType &angle) {
+                                                         const Angle<FloatingNumberType> &angle) {
     addGate(static_cast<std::unique_ptr<PhaseGate>>(std::make_unique<ControlledPhaseGate>(controlQubitIndex, targetQubitIndex, angle)));
 }
 
@@ -297,8 +753,18 @@ void Circuit<FloatingNumberType>::addPrintGate(const size_t &qubitIndex) {
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::reset() {
-    for(auto& qubit : qubits){
-        qubit = Qubit<FloatingNumberType>(probabilityEngine);
+    switch(getRunBackend()){
+        case STABILIZER:
+            tableau.reset();
+            break;
+        case MATRIX_PRODUCT_STATE:
+            matrixProductState.reset();
+            break;
+        case SPARSE:
+            sparseState.reset();
+            break;
+        default:
+            state.reset();
     }
     for(auto& classicBit : classicBits){
         classicBit = ClassicBit();
@@ -306,11 +772,304 @@ void Circuit<FloatingNumberType>::reset() {
 }
 
 template<std_floating_point FloatingNumberType>
-typename Circuit<FloatingNumberType>::CompoundResult Circuit<FloatingNumberType>::simulate(const size_t &count) {
+typename Circuit<FloatingNumberType>::CompoundResult Circuit<FloatingNumberType>::simulate(const size_t &count, const size_t &threadCount) {
+    Profile *profile_ = profiling ? &profile : nullptr;
+    if(profile_ != nullptr){
+        profile = Profile();
+    }
+    const auto start = Profile::Clock::now();
+    // Sampling needs the amplitudes, so the other backends always run the shots
+    const Backend backend_ = getRunBackend();
+    discardedWeight = 0;
+    CompoundResult result = backend_ == STATE_VECTOR && hasOnlyTerminalMeasurements() ? sampleTerminalMeasurements(count, profile_)
+                                                                                      : runShots(count, threadCount, compile(), backend_, profile_);
+    if(profile_ != nullptr){
+        profile.addRun(start, count);
+    }
+    return result;
+}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::CompoundResult Circuit<FloatingNumberType>::runShots(const size_t &count, const size_t &threadCount,
+                                                                                                   const std::shared_ptr<const Program<FloatingNumberType>> &compiled,
+                                                                                                   const Backend &backend_, Profile *profile_) {
+    const size_t blockCount = (count + SHOT_BLOCK_SIZE - 1) / SHOT_BLOCK_SIZE;
+    const size_t hardwareThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t workerCount = std::min(threadCount == 0 ? hardwareThreads : threadCount, blockCount);
+    // Drawing the first substream from the engine makes consecutive simulations differ, while staying reproducible
+    const std::uint64_t firstStream = probabilityEngine->getBits();
+
+    std::atomic<size_t> nextBlock = 0;
+    std::vector<CompoundResult> workerResults(workerCount);
+    std::vector<std::exception_ptr> workerExceptions(workerCount);
+    std::vector<Profile> workerProfiles(profile_ != nullptr ? workerCount : 0, compiled->getProfile());
+    std::vector<FloatingNumberType> workerDiscardedWeights(workerCount, 0);
+    const auto worker = [&](const size_t &workerIndex){
+        try {
+            // Workers share the program, but each one has its own register and classic bits
+            Workspace workspace(probabilityEngine->split(firstStream));
+            prepareWorkspace(*compiled, workspace, backend_);
+            workspace.visitRegister(backend_, [&](auto &register_){
+                // The instructions before the first uncertain measurement have the same effect on every shot, so a
+                // register evolved through them once starts every shot, after skipping the draws they made. Only the
+                // register of the backend and the classic bits are kept, and copied back before every shot. Profiled
+                // runs apply them on every shot, so that the gate counts stay per shot.
+                auto prefix = register_;
+                std::vector<ClassicBit> prefixClassicBits = workspace.classicBits;
+                size_t prefixEnd = 0;
+                std::uint64_t prefixDrawCount = 0;
+                if(profile_ == nullptr){
+                    prefix.reset();
+                    const std::uint64_t drawCount = workspace.probabilityEngine->getDrawCount();
+                    prefixEnd = compiled->executePrefix(prefix, prefixClassicBits);
+                    prefixDrawCount = workspace.probabilityEngine->getDrawCount() - drawCount;
+                }
+                for(size_t block = nextBlock++; block < blockCount; block = nextBlock++){
+                    workspace.probabilityEngine->setStream(firstStream + block);
+                    const size_t blockEnd = std::min(count, (block + 1) * SHOT_BLOCK_SIZE);
+                    for(size_t shot = block * SHOT_BLOCK_SIZE; shot < blockEnd; shot++){
+                        if(prefixEnd > 0){
+                            register_ = prefix;
+                            std::copy(prefixClassicBits.begin(), prefixClassicBits.end(), workspace.classicBits.begin());
+                            workspace.probabilityEngine->discard(prefixDrawCount);
+                            compiled->execute(register_, workspace.classicBits, prefixEnd, compiled->getInstructions().size());
+                            workspace.result.load(workspace.classicBits, classicBitCount);
+                        } else {
+                            runShot(*compiled, workspace, backend_, profile_ != nullptr ? &workerProfiles[workerIndex] : nullptr);
+                        }
+                        workerResults[workerIndex].addResult(workspace.result);
+                        workerDiscardedWeights[workerIndex] = std::max(workerDiscardedWeights[workerIndex],
+                                                                       workspace.matrixProductState.getDiscardedWeight());
+                    }
+                }
+            });
+        } catch (...) {
+            workerExceptions[workerIndex] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t i = 1; i < workerCount; i++){
+        threads.emplace_back(worker, i);
+    }
+    if(workerCount > 0){
+        worker(0);
+    }
+    for(auto& thread : threads){
+        thread.join();
+    }
+
     CompoundResult result;
+    for(size_t i = 0; i < workerCount; i++){
+        if(workerExceptions[i]){
+            std::rethrow_exception(workerExceptions[i]);
+        }
+        result += workerResults[i];
+        discardedWeight = std::max(discardedWeight, workerDiscardedWeights[i]);
+        if(profile_ != nullptr){
+            *profile_ += workerProfiles[i];
+        }
+    }
+    return result;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::getTerminalMeasurementsStart() const {
+    size_t start = gates->size();
+    while(start > 0 && dynamic_cast<const MeasureGate*>((*gates)[start - 1].get()) != nullptr){
+        start--;
+    }
+    return start;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::hasOnlyTerminalMeasurements() const {
+    const size_t measurementsStart = getTerminalMeasurementsStart();
+    for(size_t i = 0; i < measurementsStart; i++){
+        if(!(*gates)[i]->isDeterministic()){
+            return false;
+        }
+    }
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+template<class Leaf>
+void Circuit<FloatingNumberType>::visitBranches(const Leaf &leaf) {
+    const auto compiled = compile();
+    const Backend backend_ = backend == SPARSE ? SPARSE : STATE_VECTOR;
+    // The branches collapse the register without drawing, so the engine is only used to compare probabilities
+    Workspace workspace(probabilityEngine);
+    prepareWorkspace(*compiled, workspace, backend_);
+    const size_t measurementsOffset = compiled->getGateOffset(getTerminalMeasurementsStart());
+    if(backend_ == SPARSE){
+        workspace.sparseState.reset();
+        compiled->executeBranches(workspace.sparseState, workspace.classicBits, 0, measurementsOffset, FloatingNumberType(1), leaf);
+    } else {
+        workspace.state.reset();
+        compiled->executeBranches(workspace.state, workspace.classicBits, 0, measurementsOffset, FloatingNumberType(1), leaf);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+std::map<size_t, FloatingNumberType> Circuit<FloatingNumberType>::probabilities() {
+    if(classicBitCount > size_t(std::numeric_limits<size_t>::digits)){
+        throw TooManyClassicBitsException(classicBitCount);
+    }
+    // The qubit read by every classic bit of the terminal measurements, the last measurement of a bit winning
+    std::vector<size_t> measuredQubits;
+    std::vector<std::pair<size_t, size_t>> terminalBits;
+    size_t terminalMask = 0;
+    for(size_t i = getTerminalMeasurementsStart(); i < gates->size(); i++){
+        for(const auto& [qubitIndex, classicBitIndex] : dynamic_cast<const MeasureGate*>((*gates)[i].get())->getQubitClassicBitPairs()){
+            const size_t position = std::find(measuredQubits.begin(), measuredQubits.end(), qubitIndex) - measuredQubits.begin();
+            if(position == measuredQubits.size()){
+                measuredQubits.push_back(qubitIndex);
+            }
+            std::erase_if(terminalBits, [&](const auto &terminalBit){ return terminalBit.first == classicBitIndex; });
+            terminalBits.emplace_back(classicBitIndex, position);
+            terminalMask |= size_t(1) << classicBitIndex;
+        }
+    }
+
+    std::map<size_t, FloatingNumberType> distribution;
+    visitBranches([&](const auto &register_, const std::vector<ClassicBit> &classicBits_, const FloatingNumberType &probability){
+        size_t branchOutcome = 0;
+        for(size_t i = 0; i < classicBitCount; i++){
+            if(classicBits_[i].getState() == ClassicBit::State::ONE){
+                branchOutcome |= size_t(1) << i;
+            }
+        }
+        branchOutcome &= ~terminalMask;
+        const std::vector<FloatingNumberType> measuredProbabilities = register_.getProbabilities(measuredQubits);
+        for(size_t measured = 0; measured < measuredProbabilities.size(); measured++){
+            if(probabilityEngine->compare(measuredProbabilities[measured], FloatingNumberType(0))){
+                continue;
+            }
+            size_t outcome = branchOutcome;
+            for(const auto& [classicBitIndex, position] : terminalBits){
+                outcome |= ((measured >> position) & 1) << classicBitIndex;
+            }
+            distribution[outcome] += probability * measuredProbabilities[measured];
+        }
+    });
+    return distribution;
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<FloatingNumberType> Circuit<FloatingNumberType>::probabilities(const std::vector<size_t> &qubitIndices) {
+    for(const auto& qubitIndex : qubitIndices){
+        if(qubitIndex >= getQubitCount()){
+            throw InvalidQubitIndexException(qubitIndex);
+        }
+    }
+    // Measuring the qubits at the end does not change their distribution, so the terminal measurements are skipped
+    std::vector<FloatingNumberType> distribution(size_t(1) << qubitIndices.size(), 0);
+    visitBranches([&](const auto &register_, const std::vector<ClassicBit> &, const FloatingNumberType &probability){
+        const std::vector<FloatingNumberType> branchDistribution = register_.getProbabilities(qubitIndices);
+        for(size_t outcome = 0; outcome < distribution.size(); outcome++){
+            distribution[outcome] += probability * branchDistribution[outcome];
+        }
+    });
+    return distribution;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::bind(const std::vector<FloatingNumberType> &values) {
+    parameterValues = values;
+    if(!program || !program->isParametric()){
+        return;
+    }
+    // The program is shared with the copies of the circuit, which keep their own values
+    if(program.use_count() > 1){
+        program = std::make_shared<Program<FloatingNumberType>>(*program);
+    }
+    program->bind(parameterValues);
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<FloatingNumberType> &Circuit<FloatingNumberType>::getParameterValues() const {
+    return parameterValues;
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<typename Circuit<FloatingNumberType>::CompoundResult>
+Circuit<FloatingNumberType>::sweep(const std::vector<std::vector<FloatingNumberType>> &points, const size_t &count,
+                                   const size_t &threadCount) {
+    std::vector<CompoundResult> results;
+    results.reserve(points.size());
+    for(const auto& point : points){
+        bind(point);
+        results.push_back(simulate(count, threadCount));
+    }
+    return results;
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<std::map<size_t, FloatingNumberType>>
+Circuit<FloatingNumberType>::sweepProbabilities(const std::vector<std::vector<FloatingNumberType>> &points) {
+    std::vector<std::map<size_t, FloatingNumberType>> distributions;
+    distributions.reserve(points.size());
+    for(const auto& point : points){
+        bind(point);
+        distributions.push_back(probabilities());
+    }
+    return distributions;
+}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::CompoundResult Circuit<FloatingNumberType>::sampleTerminalMeasurements(const size_t &count, Profile *profile_) {
+    const auto compiled = compile();
+    reset();
+    const size_t measurementsStart = getTerminalMeasurementsStart();
+    classicBits.resize(std::max(classicBits.size(), compiled->getClassicBitCount()));
+    if(profile_ != nullptr){
+        *profile_ += compiled->getProfile();
+    }
+    compiled->execute(state, classicBits, 0, compiled->getGateOffset(measurementsStart), profile_);
+    if(profile_ != nullptr){
+        profile_->enter(profile_->getEntry(Profile::SAMPLING_SYMBOL), probabilityEngine->getDrawCount(), 0);
+    }
+
+    // Bit positions of the measured qubits in a sampled outcome
+    std::vector<size_t> measuredQubits;
+    std::vector<size_t> outcomePositions(getQubitCount(), 0);
+    for(size_t i = measurementsStart; i < gates->size(); i++){
+        for(const auto& [qubitIndex, classicBitIndex] : dynamic_cast<const MeasureGate*>((*gates)[i].get())->getQubitClassicBitPairs()){
+            if(std::find(measuredQubits.begin(), measuredQubits.end(), qubitIndex) == measuredQubits.end()){
+                outcomePositions[qubitIndex] = measuredQubits.size();
+                measuredQubits.push_back(qubitIndex);
+            }
+        }
+    }
+
+    // Cumulative distribution of the measured qubits, marginalized over the others
+    std::vector<FloatingNumberType> cumulativeProbabilities = state.getProbabilities(measuredQubits);
+    std::partial_sum(cumulativeProbabilities.begin(), cumulativeProbabilities.end(), cumulativeProbabilities.begin());
+
+    // Sorting the samples groups equal outcomes, so that each one is added to the result only once
+    std::vector<FloatingNumberType> values(count);
+    probabilityEngine->fill(values);
+    std::vector<size_t> samples(count);
     for(size_t i = 0; i < count; i++){
-        reset();
-        result.addResult(run());
+        const FloatingNumberType value = values[i] * cumulativeProbabilities.back();
+        samples[i] = std::upper_bound(cumulativeProbabilities.begin(), cumulativeProbabilities.end(), value) - cumulativeProbabilities.begin();
+        samples[i] = std::min(samples[i], cumulativeProbabilities.size() - 1);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    CompoundResult result;
+    for(size_t i = 0, j; i < samples.size(); i = j){
+        for(j = i; j < samples.size() && samples[j] == samples[i]; j++);
+        for(size_t gateIndex = measurementsStart; gateIndex < gates->size(); gateIndex++){
+            for(const auto& [qubitIndex, classicBitIndex] : dynamic_cast<const MeasureGate*>((*gates)[gateIndex].get())->getQubitClassicBitPairs()){
+                classicBits[classicBitIndex] = ClassicBit(((samples[i] >> outcomePositions[qubitIndex]) & 1) == 1);
+            }
+        }
+        result.addResult(getResult(), j - i);
+    }
+    if(profile_ != nullptr){
+        profile_->leave(probabilityEngine->getDrawCount(), count * measuredQubits.size());
     }
     return result;
 }
@@ -326,10 +1085,31 @@ std::runtime_error("Invalid classic bit index: " + std::to_string(classicIndex))
 index(classicIndex) {}
 
 template<std_floating_point FloatingNumberType>
-Circuit<FloatingNumberType>::Circuit(const Circuit &other): Circuit(other.probabilityEngine, other.qubits.size(), other.classicBits.size()) {
-    for(const auto& gate : other.gates){
-        addGate(gate->clone());
-    }
+Circuit<FloatingNumberType>::InvalidFusionWidthException::InvalidFusionWidthException(const size_t &width):
+std::runtime_error("Invalid fused block width: " + std::to_string(width)),
+width(width) {}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::TooManyClassicBitsException::TooManyClassicBitsException(const size_t &classicBitCount):
+std::runtime_error("Cannot key the outcomes of " + std::to_string(classicBitCount) + " classic bits"),
+classicBitCount(classicBitCount) {}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::Circuit(const Circuit &other): Circuit(other, other.probabilityEngine) {}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::Circuit(const Circuit &other, std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine):
+        Circuit(probabilityEngine, other.getQubitCount(), other.getClassicBitCount()) {
+    // The gates are shared until one of the circuits adds a gate, and so are the program and the flattened gates
+    gates = other.gates;
+    program = other.program;
+    flattenedGates = other.flattenedGates;
+    circuitGateInlining = other.circuitGateInlining;
+    profiling = other.profiling;
+    backend = other.backend;
+    matrixProductState.setTruncation(other.matrixProductState.getTruncation());
+    sparseState.setSparsity(other.sparseState.getSparsity());
+    parameterValues = other.parameterValues;
 }
 
 template<std_floating_point FloatingNumberType>
@@ -337,17 +1117,260 @@ typename Circuit<FloatingNumberType>::CircuitGate Circuit<FloatingNumberType>::t
     return CircuitGate(*this);
 }
 
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType> Circuit<FloatingNumberType>::fuseGates(const size_t &maxFusedWidth) const {
+    if(maxFusedWidth == 0){
+        throw InvalidFusionWidthException(maxFusedWidth);
+    }
+    struct Block {
+        std::vector<size_t> qubitIndices;
+        GateList gates;
+        bool open = true;
+    };
+    constexpr size_t noBlock = std::numeric_limits<size_t>::max();
+    Circuit<FloatingNumberType> fused(probabilityEngine, getQubitCount(), classicBitCount);
+    std::vector<Block> blocks;
+    // The open block acting on each qubit
+    std::vector<size_t> openBlocks(getQubitCount(), noBlock);
+
+    const auto flush = [&](const size_t &blockIndex){
+        Block& block = blocks[blockIndex];
+        block.open = false;
+        for(const auto& qubitIndex : block.qubitIndices){
+            openBlocks[qubitIndex] = noBlock;
+        }
+        if(block.gates.size() == 1){
+            fused.gates->push_back(block.gates[0]);
+        } else {
+            fused.gates->emplace_back(std::make_unique<FusedGate>(block.qubitIndices, getBlockUnitary(block.qubitIndices, block.gates)));
+        }
+    };
+
+    for(const auto& gate : *gates){
+        const std::vector<size_t> gateQubits = gate->getQubitIndices();
+        std::vector<size_t> touchedBlocks;
+        for(const auto& qubitIndex : gateQubits){
+            if(openBlocks[qubitIndex] != noBlock &&
+               std::find(touchedBlocks.begin(), touchedBlocks.end(), openBlocks[qubitIndex]) == touchedBlocks.end()){
+                touchedBlocks.push_back(openBlocks[qubitIndex]);
+            }
+        }
+        std::sort(touchedBlocks.begin(), touchedBlocks.end());
+
+        if(!gate->isDeterministic() || gate->isParametric() || gateQubits.size() > maxFusedWidth){
+            for(const auto& blockIndex : touchedBlocks){
+                flush(blockIndex);
+            }
+            fused.gates->push_back(gate);
+            continue;
+        }
+
+        // The blocks acting on the qubits of the gate are on disjoint qubits, so their gates can be concatenated
+        Block block;
+        for(const auto& blockIndex : touchedBlocks){
+            block.qubitIndices.insert(block.qubitIndices.end(), blocks[blockIndex].qubitIndices.begin(), blocks[blockIndex].qubitIndices.end());
+            block.gates.insert(block.gates.end(), blocks[blockIndex].gates.begin(), blocks[blockIndex].gates.end());
+        }
+        for(const auto& qubitIndex : gateQubits){
+            if(std::find(block.qubitIndices.begin(), block.qubitIndices.end(), qubitIndex) == block.qubitIndices.end()){
+                block.qubitIndices.push_back(qubitIndex);
+            }
+        }
+        if(block.qubitIndices.size() > maxFusedWidth){
+            for(const auto& blockIndex : touchedBlocks){
+                flush(blockIndex);
+            }
+            block = Block();
+            for(const auto& qubitIndex : gateQubits){
+                if(std::find(block.qubitIndices.begin(), block.qubitIndices.end(), qubitIndex) == block.qubitIndices.end()){
+                    block.qubitIndices.push_back(qubitIndex);
+                }
+            }
+        } else {
+            for(const auto& blockIndex : touchedBlocks){
+                blocks[blockIndex].open = false;
+            }
+        }
+        block.gates.push_back(gate);
+        for(const auto& qubitIndex : block.qubitIndices){
+            openBlocks[qubitIndex] = blocks.size();
+        }
+        blocks.push_back(std::move(block));
+    }
+    for(size_t i = 0; i < blocks.size(); i++){
+        if(blocks[i].open){
+            flush(i);
+        }
+    }
+    return fused;
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType> Circuit<FloatingNumberType>::collapsePermutations(const size_t &maxPermutationWidth) const {
+    Circuit<FloatingNumberType> collapsed(probabilityEngine, getQubitCount(), classicBitCount);
+    GateList runGates;
+    std::vector<size_t> runQubits;
+
+    const auto flush = [&](){
+        if(runGates.empty()){
+            return;
+        }
+        if(runGates.size() == 1 && runGates[0]->flatten().size() == 1){
+            collapsed.gates->push_back(runGates[0]);
+        } else {
+            // The gates are applied to every basis state of the qubits of the run, deposited on the register
+            std::vector<size_t> table(size_t(1) << runQubits.size());
+            for(size_t localState = 0; localState < table.size(); localState++){
+                size_t basisState = 0;
+                for(size_t i = 0; i < runQubits.size(); i++){
+                    basisState |= ((localState >> i) & 1) << runQubits[i];
+                }
+                for(const auto& gate : runGates){
+                    basisState = gate->permuteBasisState(basisState);
+                }
+                for(size_t i = 0; i < runQubits.size(); i++){
+                    table[localState] |= ((basisState >> runQubits[i]) & 1) << i;
+                }
+            }
+            collapsed.gates->emplace_back(std::make_unique<PermutationGate>(runQubits, table));
+        }
+        runGates.clear();
+        runQubits.clear();
+    };
+
+    for(const auto& gate : *gates){
+        if(!gate->isPermutation()){
+            flush();
+            collapsed.gates->push_back(gate);
+            continue;
+        }
+        std::vector<size_t> qubits = runQubits;
+        for(const auto& qubitIndex : gate->getQubitIndices()){
+            if(std::find(qubits.begin(), qubits.end(), qubitIndex) == qubits.end()){
+                qubits.push_back(qubitIndex);
+            }
+        }
+        if(qubits.size() > maxPermutationWidth){
+            flush();
+            qubits = gate->getQubitIndices();
+            if(qubits.size() > maxPermutationWidth){
+                collapsed.gates->push_back(gate);
+                continue;
+            }
+        }
+        runGates.push_back(gate);
+        runQubits = std::move(qubits);
+    }
+    flush();
+    return collapsed;
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<typename StateVector<FloatingNumberType>::Amplitude>
+Circuit<FloatingNumberType>::getBlockUnitary(const std::vector<size_t> &qubitIndices, const GateList &blockGates) const {
+    Circuit<FloatingNumberType> block(probabilityEngine, qubitIndices.size());
+    block.qubitMap.assign(getQubitCount(), 0);
+    for(size_t i = 0; i < qubitIndices.size(); i++){
+        block.qubitMap[qubitIndices[i]] = i;
+    }
+    Program<FloatingNumberType> blockProgram(qubitIndices.size(), 0);
+    for(const auto& gate : blockGates){
+        gate->compile(&block, blockProgram);
+    }
+    block.restoreLayout(blockProgram);
+    block.classicBits.resize(blockProgram.getClassicBitCount());
+    const size_t dimension = size_t(1) << qubitIndices.size();
+    std::vector<typename StateVector<FloatingNumberType>::Amplitude> matrix(dimension * dimension);
+    for(size_t column = 0; column < dimension; column++){
+        block.state.reset();
+        for(size_t i = 0; i < qubitIndices.size(); i++){
+            if((column >> i) & 1){
+                block.state.applyX(i);
+            }
+        }
+        blockProgram.execute(block.state, block.classicBits);
+        const auto& amplitudes = block.state.getAmplitudes();
+        for(size_t row = 0; row < dimension; row++){
+            matrix[row * dimension + column] = amplitudes[row];
+        }
+    }
+    return matrix;
+}
+
 template<std_floating_point FloatingNumberType>
 std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumberType>::Gate::makeControlled(const size_t& controlIndex, const bool& classic) const {
     return std::make_unique<CustomControlledGate>(controlIndex, clone(), classic);
 }
 
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Gate::apply(Circuit<FloatingNumberType> *circuit) {
+    Program<FloatingNumberType> gateProgram(circuit->getQubitCount(), circuit->classicBits.size());
+    compile(circuit, gateProgram);
+    circuit->restoreLayout(gateProgram);
+    if(!circuit->state.isInitialized()){
+        circuit->state.reset();
+    }
+    circuit->classicBits.resize(gateProgram.getClassicBitCount());
+    gateProgram.execute(circuit->state, circuit->classicBits);
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<std::unique_ptr<typename Circuit<FloatingNumberType>::Gate>> Circuit<FloatingNumberType>::Gate::flatten() const {
+    std::vector<std::unique_ptr<Gate>> flattened;
+    flattened.emplace_back(clone());
+    return flattened;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::Gate::isDeterministic() const {
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::Gate::isParametric() const {
+    return false;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::Gate::isPermutation() const {
+    return false;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::Gate::permuteBasisState(const size_t &basisState) const {
+    return basisState;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Gate::encode(Encoder &) const {
+    throw CircuitFormatException(std::string(getSymbol()) + " gates cannot be saved");
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Gate::writeQASM(QASMWriter &) const {
+    throw UnsupportedGateException(std::string(getSymbol()) + " gates have no OpenQASM 2 equivalent");
+}
+
 template<std_floating_point FloatingNumberType>
 Circuit<FloatingNumberType>& Circuit<FloatingNumberType>::operator+=(const Circuit &other) {
-    // TODO check if other has the same number of qubits and classic bits
-    for(const auto& gate : other.gates){
-        addGate(gate->clone());
+    // Holding the other gates makes the list shared, so appending a circuit to itself copies it first
+    const std::shared_ptr<const GateList> otherGates = other.gates;
+    if constexpr (VALIDATION_ENABLED) {
+        // The gates were verified against the other circuit, so they only need to be checked if it is larger
+        if(other.getQubitCount() > getQubitCount() || other.classicBitCount > classicBitCount){
+            for(const auto& gate : *otherGates){
+                gate->verify(this);
+            }
+        }
+    }
+    if(gates->empty()){
+        gates = other.gates;
+    } else {
+        GateList &mutableGates = getMutableGates();
+        mutableGates.insert(mutableGates.end(), otherGates->begin(), otherGates->end());
     }
+    program.reset();
+    flattenedGates.reset();
     return *this;
 }
 
@@ -356,26 +1379,137 @@ Circuit<FloatingNumberType> &Circuit<FloatingNumberType>::operator=(const Circui
     if(this != &other){
         Circuit<FloatingNumberType> temp(other);
         std::swap(temp.probabilityEngine, probabilityEngine);
-        std::swap(temp.qubits, qubits);
+        std::swap(temp.state, state);
+        std::swap(temp.tableau, tableau);
+        std::swap(temp.matrixProductState, matrixProductState);
+        std::swap(temp.sparseState, sparseState);
         std::swap(temp.classicBits, classicBits);
         std::swap(temp.gates, gates);
+        std::swap(temp.classicBitCount, classicBitCount);
+        std::swap(temp.program, program);
+        std::swap(temp.parameterValues, parameterValues);
+        std::swap(temp.flattenedGates, flattenedGates);
+        std::swap(temp.circuitGateInlining, circuitGateInlining);
+        std::swap(temp.profiling, profiling);
+        std::swap(temp.profile, profile);
+        std::swap(temp.backend, backend);
+        std::swap(temp.discardedWeight, discardedWeight);
+        std::swap(temp.qubitMap, qubitMap);
+        std::swap(temp.layout, layout);
     }
     return *this;
 }
 
 template<std_floating_point FloatingNumberType>
 size_t Circuit<FloatingNumberType>::getQubitCount() const {
-    return qubits.size();
+    return state.getQubitCount();
 }
 
 template<std_floating_point FloatingNumberType>
 size_t Circuit<FloatingNumberType>::getClassicBitCount() const {
-    return classicBits.size();
+    return classicBitCount;
+}
+
+template<std_floating_point FloatingNumberType>
+const typename Circuit<FloatingNumberType>::GateList &Circuit<FloatingNumberType>::getGates() const{
+    return *gates;
+}
+
+template<std_floating_point FloatingNumberType>
+const StateVector<FloatingNumberType> &Circuit<FloatingNumberType>::getState() const {
+    return state;
+}
+
+template<std_floating_point FloatingNumberType>
+const Tableau<FloatingNumberType> &Circuit<FloatingNumberType>::getTableau() const {
+    return tableau;
+}
+
+template<std_floating_point FloatingNumberType>
+const MatrixProductState<FloatingNumberType> &Circuit<FloatingNumberType>::getMatrixProductState() const {
+    return matrixProductState;
+}
+
+template<std_floating_point FloatingNumberType>
+const SparseStateVector<FloatingNumberType> &Circuit<FloatingNumberType>::getSparseState() const {
+    return sparseState;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::resolveQubit(const size_t &qubitIndex) const {
+    return layout[qubitMap[qubitIndex]];
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::swapLayout(const size_t &qubitIndex1, const size_t &qubitIndex2) {
+    std::swap(layout[qubitMap[qubitIndex1]], layout[qubitMap[qubitIndex2]]);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::restoreLayout(Program<FloatingNumberType> &program) {
+    std::vector<size_t> displaced;
+    for(size_t i = 0; i < layout.size(); i++){
+        if(layout[i] != i){
+            displaced.push_back(i);
+        }
+    }
+    if(displaced.empty()){
+        return;
+    }
+    if(displaced.size() == 2){
+        program.addSwap(displaced[0], displaced[1], {});
+    } else if(displaced.size() <= MAX_LAYOUT_PERMUTATION_WIDTH && backend != MATRIX_PRODUCT_STATE){
+        // The displaced qubits occupy the positions of each other, so the permutation only acts on them
+        std::vector<size_t> localIndices(layout.size());
+        for(size_t i = 0; i < displaced.size(); i++){
+            localIndices[displaced[i]] = i;
+        }
+        std::vector<size_t> table(size_t(1) << displaced.size(), 0);
+        for(size_t localState = 0; localState < table.size(); localState++){
+            for(size_t i = 0; i < displaced.size(); i++){
+                table[localState] |= ((localState >> localIndices[layout[displaced[i]]]) & 1) << i;
+            }
+        }
+        program.addPermutation(displaced, table, {});
+    } else {
+        // The qubit at each position, so that every swap puts one qubit back in place
+        std::vector<size_t> occupants(layout.size());
+        for(size_t i = 0; i < layout.size(); i++){
+            occupants[layout[i]] = i;
+        }
+        for(const auto& qubit : displaced){
+            if(layout[qubit] == qubit){
+                continue;
+            }
+            const size_t position = layout[qubit];
+            const size_t occupant = occupants[qubit];
+            program.addSwap(position, qubit, {});
+            layout[occupant] = position;
+            occupants[position] = occupant;
+            layout[qubit] = qubit;
+            occupants[qubit] = qubit;
+        }
+    }
+    for(size_t i = 0; i < layout.size(); i++){
+        layout[i] = i;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::resolveClassicBit(const size_t &classicBitIndex) const {
+    return classicBitOffset + classicBitIndex;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::pushControl(const size_t &qubitIndex) {
+    const size_t previousControlCount = controls.size();
+    controls.push_back(resolveQubit(qubitIndex));
+    return previousControlCount;
 }
 
 template<std_floating_point FloatingNumberType>
-const std::vector<std::unique_ptr<typename Circuit<FloatingNumberType>::Gate>> &Circuit<FloatingNumberType>::getGates() const{
-    return gates;
+void Circuit<FloatingNumberType>::popControl(const size_t &previousControlCount) {
+    controls.resize(previousControlCount);
 }
 
 template<std_floating_point FloatingNumberType>
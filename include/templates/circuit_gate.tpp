@@ -4,59 +4,39 @@
 template<std_floating_point FloatingNumberType>
 typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::CircuitGate::getDrawings(
         const Circuit<FloatingNumberType> *circuit) const {
-    typename Gate::Drawings drawings(circuit->qubits.size() + 1);
     const size_t minQubitIndex = *std::min_element(qubitIndices.begin(), qubitIndices.end());
     const size_t maxQubitIndex = *std::max_element(qubitIndices.begin(), qubitIndices.end());
-    const size_t maxIndexLength = std::to_string(circuit->qubits.size() - 1).length();
+    const size_t maxIndexLength = std::to_string(circuit->getQubitCount() - 1).length();
     const size_t gateHeight = maxQubitIndex - minQubitIndex + 1;
     const size_t gateWidth = 4 + maxIndexLength + name.length();
-    std::array<std::string, 3> outsideDrawing = {std::string(gateWidth, ' '), "", std::string(gateWidth, ' ')};
-    std::array<std::string, 3> measureDrawing = {std::string(gateWidth, ' '), "", std::string(gateWidth, ' ')};
+    typename Gate::Drawings drawings;
+    drawings.firstRow = minQubitIndex;
+    drawings.rows.resize(gateHeight);
     std::map<size_t, std::string> qubitIndexToGateIndex;
     for(size_t i = 0; i < qubitIndices.size(); i++){
         qubitIndexToGateIndex[qubitIndices[i]] = std::to_string(i);
     }
-    for(size_t i = 0; i < gateWidth; i++){
-        outsideDrawing[1] += "─";
-        measureDrawing[1] += "═";
-    }
-    for(size_t i = 0; i < minQubitIndex; i++){
-        drawings[i] = outsideDrawing;
-    }
-    for(size_t i = minQubitIndex, qubitCount = 0; i <= maxQubitIndex; i++, qubitCount++){
-        drawings[i][0] = "│";
-        drawings[i][0] += std::string(gateWidth - 2, ' ');
-        drawings[i][0] += "│";
-        drawings[i][1] = "┤";
+    const std::string side = "│" + std::string(gateWidth - 2, ' ') + "│";
+    for(size_t i = minQubitIndex; i <= maxQubitIndex; i++){
+        auto& drawing = drawings.rows[i - minQubitIndex];
+        drawing[0] = side;
+        drawing[1] = "┤";
         const std::string qubitCountString = qubitIndexToGateIndex.find(i) != qubitIndexToGateIndex.end() ? qubitIndexToGateIndex[i] : "";
-        drawings[i][1] += qubitCountString;
-        drawings[i][1] += std::string(gateWidth - 2 - qubitCountString.length(), ' ');
-        drawings[i][1] += "├";
-        drawings[i][2] = "│";
-        drawings[i][2] += std::string(gateWidth - 2, ' ');
-        drawings[i][2] += "│";
-    }
-    drawings[minQubitIndex][0] = "┌";
-    for(size_t i = 1; i < gateWidth - 1; i++){
-        drawings[minQubitIndex][0] += "─";
+        drawing[1] += qubitCountString;
+        drawing[1] += std::string(gateWidth - 2 - qubitCountString.length(), ' ');
+        drawing[1] += "├";
+        drawing[2] = side;
     }
-    drawings[minQubitIndex][0] += "┐";
-    drawings[maxQubitIndex][2] = "└";
-    for(size_t i = 1; i < gateWidth - 1; i++){
-        drawings[maxQubitIndex][2] += "─";
-    }
-    drawings[maxQubitIndex][2] += "┘";
+    const std::string border = Gate::repeatGlyph("─", gateWidth - 2);
+    drawings.rows.front()[0] = "┌" + border + "┐";
+    drawings.rows.back()[2] = "└" + border + "┘";
     // Insert name in the middle
-    const size_t middleIndex = (gateHeight - 1) / 2 + minQubitIndex;
+    const size_t middleIndex = (gateHeight - 1) / 2;
     const size_t drawingRow = gateHeight % 2 == 1 ? 1 : 2;
     for(size_t drawingColumn = std::to_string(minQubitIndex - minQubitIndex).length() + 1 + std::string("┤").length(),
             nameColumn = 0; nameColumn < name.length(); drawingColumn++, nameColumn++) {
-        drawings[middleIndex][drawingRow][drawingColumn] = name[nameColumn];
-    }
-    for(size_t i = maxQubitIndex + 1; i < circuit->qubits.size(); i++){
-        drawings[i] = outsideDrawing;
+        drawings.rows[middleIndex][drawingRow][drawingColumn] = name[nameColumn];
     }
-    drawings[circuit->qubits.size()] = measureDrawing;
     return drawings;
 }
 
@@ -84,14 +64,27 @@ std::string Circuit<FloatingNumberType>::CircuitGate::getRepresentation() const
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::CircuitGate::apply(Circuit<FloatingNumberType> *circuit) {
-    for (size_t i = 0; i < circuitPointer->qubits.size(); i++) {
-        circuitPointer->qubits[i].setState(circuit->qubits[qubitIndices[i]].getState());
+void Circuit<FloatingNumberType>::CircuitGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    // The inner gates are compiled directly on the register of the parent circuit, through a qubit map
+    // composed with the one of the parent (so nested CircuitGates resolve to the right qubits).
+    // The layout is shared, so swaps inside the sub-circuit stay visible to the gates after it.
+    std::vector<size_t> innerQubitMap(qubitIndices.size());
+    for (size_t i = 0; i < qubitIndices.size(); i++) {
+        innerQubitMap[i] = circuit->qubitMap[qubitIndices[i]];
+    }
+    // The classic bits of the inner circuit are scratch bits, starting from 0 every time the gate is applied
+    const size_t innerClassicBitCount = circuitPointer->getClassicBitCount();
+    size_t innerClassicBitOffset = program.allocateClassicBits(innerClassicBitCount);
+    if (innerClassicBitCount > 0) {
+        program.addClear(innerClassicBitOffset, innerClassicBitCount);
     }
-    circuitPointer->run();
-    for (size_t i = 0; i < circuitPointer->qubits.size(); i++) {
-        circuit->qubits[qubitIndices[i]].setState(circuitPointer->qubits[i].getState());
+    std::swap(circuit->qubitMap, innerQubitMap);
+    std::swap(circuit->classicBitOffset, innerClassicBitOffset);
+    for (const auto &gate: *circuitPointer->gates) {
+        circuit->compileGate(*gate, program);
     }
+    std::swap(circuit->qubitMap, innerQubitMap);
+    std::swap(circuit->classicBitOffset, innerClassicBitOffset);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -105,7 +98,7 @@ Circuit<FloatingNumberType>::CircuitGate::InvalidQubitIndicesException::InvalidQ
 
 template<std_floating_point FloatingNumberType>
 size_t Circuit<FloatingNumberType>::CircuitGate::getQubitCount() const {
-    return circuitPointer->qubits.size();
+    return circuitPointer->getQubitCount();
 }
 
 template<std_floating_point FloatingNumberType>
@@ -131,8 +124,94 @@ std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumb
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::CircuitGate::verify(const Circuit *circuit) const {
     for (unsigned long qubitIndex: qubitIndices) {
-        if (qubitIndex >= circuit->qubits.size()) {
+        if (qubitIndex >= circuit->getQubitCount()) {
             throw InvalidQubitIndexException(qubitIndex);
         }
     }
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::CircuitGate::isDeterministic() const {
+    return std::all_of(circuitPointer->gates->begin(), circuitPointer->gates->end(), [](const auto& gate){
+        return gate->isDeterministic();
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::CircuitGate::isParametric() const {
+    return std::any_of(circuitPointer->gates->begin(), circuitPointer->gates->end(), [](const auto& gate){
+        return gate->isParametric();
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::CircuitGate::getQubitIndices() const {
+    return qubitIndices;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CircuitGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    for (auto &qubitIndex: qubitIndices) {
+        qubitIndex = qubitMap[qubitIndex];
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<std::unique_ptr<typename Circuit<FloatingNumberType>::Gate>> Circuit<FloatingNumberType>::CircuitGate::flatten() const {
+    if (circuitPointer->getClassicBitCount() > 0) {
+        return Gate::flatten();
+    }
+    // The flattened gates are cached in the circuit, so only the remapping is done for every use
+    const auto &innerGates = circuitPointer->getFlattenedGates();
+    std::vector<std::unique_ptr<Gate>> flattened;
+    flattened.reserve(innerGates.size());
+    for (const auto &gate: innerGates) {
+        auto remapped = gate->clone();
+        remapped->remapQubits(qubitIndices);
+        flattened.emplace_back(std::move(remapped));
+    }
+    return flattened;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::CircuitGate::isPermutation() const {
+    return circuitPointer->getClassicBitCount() == 0 &&
+           std::all_of(circuitPointer->gates->begin(), circuitPointer->gates->end(), [](const auto& gate){
+               return gate->isPermutation();
+           });
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::CircuitGate::permuteBasisState(const size_t &basisState) const {
+    // The inner gates permute the basis state of the inner circuit, gathered from the qubits of the gate
+    size_t innerState = 0;
+    size_t outerMask = 0;
+    for (size_t i = 0; i < qubitIndices.size(); i++) {
+        innerState |= ((basisState >> qubitIndices[i]) & 1) << i;
+        outerMask |= size_t(1) << qubitIndices[i];
+    }
+    for (const auto &gate: *circuitPointer->gates) {
+        innerState = gate->permuteBasisState(innerState);
+    }
+    size_t permutedState = basisState & ~outerMask;
+    for (size_t i = 0; i < qubitIndices.size(); i++) {
+        permutedState |= ((innerState >> i) & 1) << qubitIndices[i];
+    }
+    return permutedState;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CircuitGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::CIRCUIT);
+    encoder.writeCircuit(*circuitPointer);
+    encoder.writeString(name);
+    encoder.writeWord(qubitIndices.size());
+    for(const auto &qubitIndex: qubitIndices){
+        encoder.writeWord(qubitIndex);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CircuitGate::writeQASM(QASMWriter &writer) const {
+    writer.writeCircuit(*circuitPointer, qubitIndices);
+}
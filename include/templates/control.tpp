@@ -1,14 +1,15 @@
 template<std_floating_point FloatingNumberType>
 typename Circuit<FloatingNumberType>::Gate::Drawings
 Circuit<FloatingNumberType>::CustomControlledGate::getDrawings(const Circuit<FloatingNumberType> *circuit) const {
-    // TODO: Drawing for classic controlled gates
+    // The control is marked on the wire of the control qubit, or on the row of the classic bits
     typename Gate::Drawings drawings = gatePointer->getDrawings(circuit);
-    const size_t drawingWidth = drawings[controlIndex][1].length();
+    const size_t controlRow = classic ? circuit->getQubitCount() : controlIndex;
+    Gate::extendDrawings(drawings, controlRow, circuit->getQubitCount());
+    std::string &controlLine = drawings.rows[controlRow - drawings.firstRow][1];
     const size_t lineLength = std::string("─").length();
-    const size_t insertIndex = drawingWidth / lineLength / 2 * lineLength;
-    const std::string replacementString = std::string("▓");
-    drawings[controlIndex][1].erase(insertIndex, lineLength);
-    drawings[controlIndex][1].insert(insertIndex, "▓");
+    const size_t insertIndex = controlLine.length() / lineLength / 2 * lineLength;
+    controlLine.erase(insertIndex, lineLength);
+    controlLine.insert(insertIndex, "▓");
     return drawings;
 }
 
@@ -18,7 +19,7 @@ Circuit<FloatingNumberType>::CustomControlledGate::CustomControlledGate(const si
                                                                         const bool& classic):
                                                                         controlIndex(controlQubitIndex),
                                                                         classic(classic),
-                                                                        gatePointer(gate->clone()){}
+                                                                        gatePointer(std::move(gate)){}
 
 
 template<std_floating_point FloatingNumberType>
@@ -33,23 +34,24 @@ std::string Circuit<FloatingNumberType>::CustomControlledGate::getRepresentation
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::CustomControlledGate::apply(Circuit<FloatingNumberType> *circuit) {
+void Circuit<FloatingNumberType>::CustomControlledGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
     if(classic){
-        auto& controlQubit = circuit->classicBits[controlIndex];
-        if(controlQubit.getState() == ClassicBit::State::ONE){
-            gatePointer->apply(circuit);
-        }
+        const size_t blockIndex = program.beginClassicControl(circuit->resolveClassicBit(controlIndex));
+        const bool previouslyControlled = circuit->classicallyControlled;
+        circuit->classicallyControlled = true;
+        circuit->compileGate(*gatePointer, program);
+        circuit->classicallyControlled = previouslyControlled;
+        program.endClassicControl(blockIndex);
     } else {
-        auto& controlQubit = circuit->qubits[controlIndex];
-        if(controlQubit.measure().getState() == ClassicBit::State::ONE){
-            gatePointer->apply(circuit);
-        }
+        const size_t previousControlCount = circuit->pushControl(controlIndex);
+        circuit->compileGate(*gatePointer, program);
+        circuit->popControl(previousControlCount);
     }
 }
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::CustomControlledGate::verify(const Circuit* circuit) const {
-    if(controlIndex >= (classic ? circuit->classicBits.size() : circuit->qubits.size())){
+    if(controlIndex >= (classic ? circuit->getClassicBitCount() : circuit->getQubitCount())){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(controlIndex);
     }
     gatePointer->verify(circuit);
@@ -58,4 +60,71 @@ void Circuit<FloatingNumberType>::CustomControlledGate::verify(const Circuit* ci
 template<std_floating_point FloatingNumberType>
 std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumberType>::CustomControlledGate::clone() const {
     return std::make_unique<Circuit<FloatingNumberType>::CustomControlledGate>(*this);
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::CustomControlledGate::isDeterministic() const {
+    return !classic && gatePointer->isDeterministic();
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::CustomControlledGate::isParametric() const {
+    return gatePointer->isParametric();
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::CustomControlledGate::getQubitIndices() const {
+    std::vector<size_t> qubitIndices = gatePointer->getQubitIndices();
+    if(!classic){
+        qubitIndices.insert(qubitIndices.begin(), controlIndex);
+    }
+    return qubitIndices;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CustomControlledGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    if(!classic){
+        controlIndex = qubitMap[controlIndex];
+    }
+    gatePointer->remapQubits(qubitMap);
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<std::unique_ptr<typename Circuit<FloatingNumberType>::Gate>> Circuit<FloatingNumberType>::CustomControlledGate::flatten() const {
+    std::vector<std::unique_ptr<Gate>> flattened;
+    for(auto& gate : gatePointer->flatten()){
+        flattened.emplace_back(std::make_unique<CustomControlledGate>(controlIndex, std::move(gate), classic));
+    }
+    return flattened;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::CustomControlledGate::isPermutation() const {
+    return !classic && gatePointer->isPermutation();
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::CustomControlledGate::permuteBasisState(const size_t &basisState) const {
+    if(((basisState >> controlIndex) & 1) == 0){
+        return basisState;
+    }
+    return gatePointer->permuteBasisState(basisState);
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::CustomControlledGate::isClassic() const {
+    return classic;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CustomControlledGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::CUSTOM_CONTROLLED);
+    encoder.writeWord(controlIndex);
+    encoder.writeWord(classic ? 1 : 0);
+    encoder.writeGate(*gatePointer);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CustomControlledGate::writeQASM(QASMWriter &writer) const {
+    writer.writeControlled(controlIndex, classic, *gatePointer);
+}
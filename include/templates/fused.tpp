@@ -0,0 +1,107 @@
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::FusedGate::getDrawings(
+        const Circuit<FloatingNumberType> *circuit) const {
+    if(qubitIndices.size() == 1){
+        return Circuit<FloatingNumberType>::Gate::getStandardDrawing(circuit, "U", qubitIndices[0]);
+    }
+    // Blocks on several qubits are drawn like a CircuitGate spanning them
+    CircuitGate block(std::make_shared<Circuit<FloatingNumberType>>(circuit->probabilityEngine, qubitIndices.size()),
+                      qubitIndices);
+    block.name = "U";
+    return static_cast<const Gate&>(block).getDrawings(circuit);
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::FusedGate::FusedGate(const std::vector<size_t> &qubitIndices,
+                                                  const std::vector<Amplitude> &matrix): qubitIndices(qubitIndices),
+                                                                                         matrix(matrix) {}
+
+template<std_floating_point FloatingNumberType>
+std::string Circuit<FloatingNumberType>::FusedGate::getRepresentation() const {
+    std::string representation = "U[";
+    for(size_t i = 0; i < qubitIndices.size(); i++){
+        representation += (i == 0 ? "Q#" : ", Q#") + std::to_string(qubitIndices[i]);
+    }
+    return representation + "]";
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::FusedGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    if(qubitIndices.size() == 1){
+        program.addMatrix(circuit->resolveQubit(qubitIndices[0]), {matrix[0], matrix[1], matrix[2], matrix[3]},
+                          circuit->controls);
+        return;
+    }
+    std::vector<size_t> targets(qubitIndices.size());
+    for(size_t i = 0; i < qubitIndices.size(); i++){
+        targets[i] = circuit->resolveQubit(qubitIndices[i]);
+    }
+    program.addUnitary(targets, matrix, circuit->controls);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::FusedGate::verify(const Circuit *circuit) const {
+    for(const auto& qubitIndex : qubitIndices){
+        if(qubitIndex >= circuit->getQubitCount()){
+            throw Circuit<FloatingNumberType>::InvalidQubitIndexException(qubitIndex);
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumberType>::FusedGate::clone() const {
+    return std::make_unique<FusedGate>(*this);
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::FusedGate::getQubitIndices() const {
+    return qubitIndices;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::FusedGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    for(auto& qubitIndex : qubitIndices){
+        qubitIndex = qubitMap[qubitIndex];
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<typename Circuit<FloatingNumberType>::FusedGate::Amplitude> &Circuit<FloatingNumberType>::FusedGate::getMatrix() const {
+    return matrix;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::FusedGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::FUSED);
+    encoder.writeWord(qubitIndices.size());
+    for(const auto &qubitIndex: qubitIndices){
+        encoder.writeWord(qubitIndex);
+    }
+    for(const auto &amplitude: matrix){
+        encoder.writeComplex(amplitude);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::FusedGate::writeQASM(QASMWriter &writer) const {
+    if(qubitIndices.size() != 1){
+        throw UnsupportedGateException("OpenQASM 2 can only write fused gates acting on a single qubit");
+    }
+    // U = e^(iγ) u3(θ, φ, λ), where u3(θ, φ, λ) = [[cos(θ/2), -e^(iλ) sin(θ/2)], [e^(iφ) sin(θ/2), e^(i(φ+λ)) cos(θ/2)]].
+    // The global phase γ is the phase of the first entry, unless it vanishes and any phase will do.
+    const Amplitude &topLeft = matrix[0];
+    const Amplitude &topRight = matrix[1];
+    const Amplitude &bottomLeft = matrix[2];
+    const Amplitude &bottomRight = matrix[3];
+    const FloatingNumberType tolerance = std::sqrt(std::numeric_limits<FloatingNumberType>::epsilon());
+    const bool diagonal = std::abs(bottomLeft) <= std::numeric_limits<FloatingNumberType>::epsilon();
+    const FloatingNumberType globalPhase = std::abs(topLeft) > std::numeric_limits<FloatingNumberType>::epsilon() ?
+                                           std::arg(topLeft) : 0;
+    if(writer.isControlled() && std::abs(globalPhase) > tolerance){
+        throw UnsupportedGateException("OpenQASM 2 cannot write the global phase of a controlled fused gate");
+    }
+    const FloatingNumberType theta = 2 * std::atan2(std::abs(bottomLeft), std::abs(topLeft));
+    const FloatingNumberType phi = diagonal ? 0 : std::arg(bottomLeft) - globalPhase;
+    const FloatingNumberType lambda = diagonal ? std::arg(bottomRight) - globalPhase : std::arg(-topRight) - globalPhase;
+    writer.writeOperation("u3", {qubitIndices[0]}, {theta, phi, lambda});
+}
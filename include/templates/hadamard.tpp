@@ -14,7 +14,8 @@ template<std_floating_point FloatingNumberType>
 Circuit<FloatingNumberType>::HadamardGate::HadamardGate(const size_t &qubitIndex): SingleTargetGate(qubitIndex) {}
 
 template<std_floating_point FloatingNumberType>
-Circuit<FloatingNumberType>::ControlledHadamardGate::ControlledHadamardGate(const size_t &controlIndex, const size_t &targetIndex): ControlledGate(controlIndex),
+Circuit<FloatingNumberType>::ControlledHadamardGate::ControlledHadamardGate(const size_t &controlIndex, const size_t &targetIndex): SingleTargetGate(targetIndex),
+                                                                                                                                    ControlledGate(controlIndex),
                                                                                                                                     HadamardGate(targetIndex) {}
 
 template<std_floating_point FloatingNumberType>
@@ -28,21 +29,17 @@ std::string Circuit<FloatingNumberType>::ControlledHadamardGate::getRepresentati
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::HadamardGate::apply(Circuit<FloatingNumberType> *circuit) {
-    auto& qubit = circuit->qubits[SingleTargetGate::qubitIndex];
-    const auto alpha = qubit.getState().getAlpha();
-    const auto beta = qubit.getState().getBeta();
-    const auto newAlpha = (alpha + beta) / (FloatingNumberType)std::sqrt(2);
-    const auto newBeta = (alpha - beta) / (FloatingNumberType)std::sqrt(2);
-    qubit.setState(newAlpha, newBeta);
+void Circuit<FloatingNumberType>::HadamardGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    const FloatingNumberType factor = 1 / std::sqrt(FloatingNumberType(2));
+    program.addMatrix(circuit->resolveQubit(SingleTargetGate::qubitIndex), {factor, factor, factor, -factor},
+                               circuit->controls);
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::ControlledHadamardGate::apply(Circuit<FloatingNumberType> *circuit) {
-    auto& qubit = circuit->qubits[Circuit<FloatingNumberType>::ControlledGate::controlIndex];
-    if(qubit.measure().getState() == ClassicBit::State::ONE){
-        HadamardGate::apply(circuit);
-    }
+void Circuit<FloatingNumberType>::ControlledHadamardGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    const size_t previousControlCount = circuit->pushControl(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    HadamardGate::compile(circuit, program);
+    circuit->popControl(previousControlCount);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -57,7 +54,7 @@ std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumb
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::HadamardGate::verify(const Circuit* circuit) const {
-    if(SingleTargetGate::qubitIndex >= circuit->qubits.size()){
+    if(SingleTargetGate::qubitIndex >= circuit->getQubitCount()){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(SingleTargetGate::qubitIndex);
     }
 }
@@ -66,4 +63,39 @@ template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::ControlledHadamardGate::verify(const Circuit* circuit) const {
     Circuit<FloatingNumberType>::ControlledGate::verify(circuit);
     HadamardGate::verify(circuit);
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::ControlledHadamardGate::getQubitIndices() const {
+    return {Circuit<FloatingNumberType>::ControlledGate::controlIndex, Circuit<FloatingNumberType>::HadamardGate::qubitIndex};
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::ControlledHadamardGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    Circuit<FloatingNumberType>::ControlledGate::controlIndex = qubitMap[Circuit<FloatingNumberType>::ControlledGate::controlIndex];
+    Circuit<FloatingNumberType>::SingleTargetGate::remapQubits(qubitMap);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::HadamardGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::HADAMARD);
+    encoder.writeWord(SingleTargetGate::qubitIndex);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::HadamardGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("h", {SingleTargetGate::qubitIndex});
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::ControlledHadamardGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::CONTROLLED_HADAMARD);
+    encoder.writeWord(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    encoder.writeWord(Circuit<FloatingNumberType>::HadamardGate::qubitIndex);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::ControlledHadamardGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("ch", {Circuit<FloatingNumberType>::ControlledGate::controlIndex,
+                                 Circuit<FloatingNumberType>::HadamardGate::qubitIndex});
+}
@@ -10,8 +10,11 @@ Circuit<FloatingNumberType>::InitGate::InitGate(const Circuit::InitGate &other):
         state(other.state) {}
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::InitGate::apply(Circuit<FloatingNumberType> *circuit) {
-    circuit->qubits[SingleTargetGate::qubitIndex].setState(state);
+void Circuit<FloatingNumberType>::InitGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    // Unitary mapping ❘0〉 to α❘0〉 + β❘1〉
+    const std::complex<FloatingNumberType> alpha = state.getAlpha();
+    const std::complex<FloatingNumberType> beta = state.getBeta();
+    program.addInit(circuit->resolveQubit(SingleTargetGate::qubitIndex), {alpha, -std::conj(beta), beta, std::conj(alpha)});
 }
 
 template<std_floating_point FloatingNumberType>
@@ -33,4 +36,31 @@ typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>
 template<std_floating_point FloatingNumberType>
 std::string Circuit<FloatingNumberType>::InitGate::getRepresentation() const {
     return "INIT[Q#" + std::to_string(SingleTargetGate::qubitIndex) + "]";
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::InitGate::isDeterministic() const {
+    // Resetting the qubit measures it
+    return false;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::InitGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::INIT);
+    encoder.writeWord(SingleTargetGate::qubitIndex);
+    encoder.writeComplex(state.getAlpha());
+    encoder.writeComplex(state.getBeta());
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::InitGate::writeQASM(QASMWriter &writer) const {
+    writer.writeReset(SingleTargetGate::qubitIndex);
+    const std::complex<FloatingNumberType> alpha = state.getAlpha();
+    const std::complex<FloatingNumberType> beta = state.getBeta();
+    if(beta == FloatingNumberType(0)){
+        return;
+    }
+    // u3(θ, φ, 0) maps ❘0〉 to cos(θ/2)❘0〉 + e^(iφ) sin(θ/2)❘1〉, the state up to its global phase
+    writer.writeOperation("u3", {SingleTargetGate::qubitIndex},
+                          {2 * std::atan2(std::abs(beta), std::abs(alpha)), std::arg(beta) - std::arg(alpha), 0});
+}
@@ -0,0 +1,638 @@
+template<std_floating_point FloatingNumberType>
+MatrixProductState<FloatingNumberType>::MatrixProductState(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                                           const size_t &qubitCount):
+        probabilityEngine(probabilityEngine),
+        qubitCount(qubitCount) {}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::reset() {
+    sites.resize(qubitCount);
+    for(auto& site : sites){
+        site.assign({1, 0});
+    }
+    bondDimensions.assign(qubitCount + 1, 1);
+    center = 0;
+    discardedWeight = 0;
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::resize(const size_t &qubitCount) {
+    this->qubitCount = qubitCount;
+    sites.clear();
+    bondDimensions.clear();
+}
+
+template<std_floating_point FloatingNumberType>
+bool MatrixProductState<FloatingNumberType>::isInitialized() const {
+    return !bondDimensions.empty();
+}
+
+template<std_floating_point FloatingNumberType>
+size_t MatrixProductState<FloatingNumberType>::getQubitCount() const {
+    return qubitCount;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::shared_ptr<ProbabilityEngine<FloatingNumberType>> &MatrixProductState<FloatingNumberType>::getProbabilityEngine() const {
+    return probabilityEngine;
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::setTruncation(const Truncation &truncation_) {
+    truncation = truncation_;
+}
+
+template<std_floating_point FloatingNumberType>
+const typename MatrixProductState<FloatingNumberType>::Truncation &MatrixProductState<FloatingNumberType>::getTruncation() const {
+    return truncation;
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType MatrixProductState<FloatingNumberType>::getDiscardedWeight() const {
+    return discardedWeight;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<size_t> &MatrixProductState<FloatingNumberType>::getBondDimensions() const {
+    return bondDimensions;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t MatrixProductState<FloatingNumberType>::getMaxBondDimension() const {
+    return bondDimensions.empty() ? 0 : *std::max_element(bondDimensions.begin(), bondDimensions.end());
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::decompose(const std::vector<Amplitude> &matrix, const size_t &rows,
+                                                       const size_t &columns, std::vector<Amplitude> &left,
+                                                       std::vector<FloatingNumberType> &values,
+                                                       std::vector<Amplitude> &right) {
+    // The columns of the matrix, or of its conjugate transpose if it is wider than tall, are orthogonalized, so that
+    // the rotations act on the shorter dimension
+    const bool transposed = rows < columns;
+    const size_t height = transposed ? columns : rows;
+    const size_t width = transposed ? rows : columns;
+    // The buffers are members, so that decompositions only allocate when they grow
+    columnVectors.resize(height * width);
+    for(size_t r = 0; r < rows; r++){
+        for(size_t c = 0; c < columns; c++){
+            if(transposed){
+                columnVectors[r * height + c] = std::conj(matrix[r * columns + c]);
+            } else {
+                columnVectors[c * height + r] = matrix[r * columns + c];
+            }
+        }
+    }
+    // The product of the rotations, so that the columns are the original ones times rotations
+    rotations.assign(width * width, 0);
+    for(size_t i = 0; i < width; i++){
+        rotations[i * width + i] = 1;
+    }
+    const auto rotate = [](Amplitude *first, Amplitude *second, const size_t &length, const FloatingNumberType &cosine,
+                           const FloatingNumberType &sine, const Amplitude &phase){
+        for(size_t i = 0; i < length; i++){
+            const Amplitude a = first[i];
+            const Amplitude b = phase * second[i];
+            first[i] = cosine * a - sine * b;
+            second[i] = sine * a + cosine * b;
+        }
+    };
+
+    const FloatingNumberType epsilon = std::numeric_limits<FloatingNumberType>::epsilon();
+    // Columns whose weight is below the roundoff of the whole matrix are numerically zero, and rotating them against
+    // the others would only shuffle roundoff until it underflows
+    FloatingNumberType negligible = 0;
+    for(const Amplitude &value : columnVectors){
+        negligible += std::norm(value);
+    }
+    negligible *= epsilon * epsilon;
+    constexpr size_t MAX_SWEEPS = 64;
+    for(size_t sweep = 0; sweep < MAX_SWEEPS; sweep++){
+        bool rotated = false;
+        for(size_t p = 0; p + 1 < width; p++){
+            for(size_t q = p + 1; q < width; q++){
+                Amplitude *first = columnVectors.data() + p * height;
+                Amplitude *second = columnVectors.data() + q * height;
+                FloatingNumberType alpha = 0;
+                FloatingNumberType beta = 0;
+                Amplitude gamma = 0;
+                for(size_t i = 0; i < height; i++){
+                    alpha += std::norm(first[i]);
+                    beta += std::norm(second[i]);
+                    gamma += std::conj(first[i]) * second[i];
+                }
+                const FloatingNumberType magnitude = std::abs(gamma);
+                if(alpha <= negligible || beta <= negligible || magnitude <= epsilon * std::sqrt(alpha) * std::sqrt(beta)){
+                    continue;
+                }
+                rotated = true;
+                // Rotating the first column and the second one, with the phase of their overlap removed, by the angle
+                // that makes them orthogonal
+                const FloatingNumberType zeta = (beta - alpha) / (2 * magnitude);
+                const FloatingNumberType tangent = (zeta < 0 ? -1 : 1) / (std::abs(zeta) + std::hypot(FloatingNumberType(1), zeta));
+                const FloatingNumberType cosine = 1 / std::hypot(FloatingNumberType(1), tangent);
+                const FloatingNumberType sine = cosine * tangent;
+                const Amplitude phase = std::polar(FloatingNumberType(1), -std::arg(gamma));
+                rotate(first, second, height, cosine, sine, phase);
+                rotate(rotations.data() + p * width, rotations.data() + q * width, width, cosine, sine, phase);
+            }
+        }
+        if(!rotated){
+            break;
+        }
+    }
+
+    columnNorms.resize(width);
+    for(size_t j = 0; j < width; j++){
+        FloatingNumberType weight = 0;
+        for(size_t i = 0; i < height; i++){
+            weight += std::norm(columnVectors[j * height + i]);
+        }
+        columnNorms[j] = std::sqrt(weight);
+    }
+    columnOrder.resize(width);
+    std::iota(columnOrder.begin(), columnOrder.end(), 0);
+    std::sort(columnOrder.begin(), columnOrder.end(), [&](const size_t &a, const size_t &b){
+        return columnNorms[a] > columnNorms[b];
+    });
+
+    // A = U S V^H gives the columns U S and the rotations V. For the conjugate transpose, the roles are exchanged
+    values.resize(width);
+    left.assign(rows * width, 0);
+    right.assign(width * columns, 0);
+    for(size_t k = 0; k < width; k++){
+        const size_t j = columnOrder[k];
+        values[k] = columnNorms[j];
+        const FloatingNumberType inverse = columnNorms[j] > 0 ? 1 / columnNorms[j] : 0;
+        for(size_t r = 0; r < rows; r++){
+            left[r * width + k] = transposed ? rotations[j * width + r] : columnVectors[j * height + r] * inverse;
+        }
+        for(size_t c = 0; c < columns; c++){
+            right[k * columns + c] = transposed ? std::conj(columnVectors[j * height + c]) * inverse
+                                                : std::conj(rotations[j * width + c]);
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+size_t MatrixProductState<FloatingNumberType>::split(const size_t &rows, const size_t &columns, const bool &truncate) {
+    decompose(matrix, rows, columns, leftVectors, singularValues, rightVectors);
+    const size_t rank = singularValues.size();
+    FloatingNumberType total = 0;
+    for(const auto& value : singularValues){
+        total += value * value;
+    }
+    size_t kept = rank;
+    // Singular values that are numerically 0 carry no weight, and their vectors are not orthonormal
+    while(kept > 1 && singularValues[kept - 1] * singularValues[kept - 1] <= total * std::numeric_limits<FloatingNumberType>::epsilon()){
+        kept--;
+    }
+    if(truncate){
+        FloatingNumberType dropped = 0;
+        while(kept > 1 && dropped + singularValues[kept - 1] * singularValues[kept - 1] <= truncation.threshold * total){
+            dropped += singularValues[kept - 1] * singularValues[kept - 1];
+            kept--;
+        }
+        while(truncation.maxBondDimension > 0 && kept > truncation.maxBondDimension){
+            dropped += singularValues[kept - 1] * singularValues[kept - 1];
+            kept--;
+        }
+        if(total > 0){
+            discardedWeight += dropped / total;
+        }
+    }
+
+    FloatingNumberType keptWeight = 0;
+    for(size_t k = 0; k < kept; k++){
+        keptWeight += singularValues[k] * singularValues[k];
+    }
+    const FloatingNumberType scale = keptWeight > 0 ? std::sqrt(total / keptWeight) : 1;
+    singularValues.resize(kept);
+    for(auto& value : singularValues){
+        value *= scale;
+    }
+    if(kept < rank){
+        for(size_t r = 0; r < rows; r++){
+            std::copy_n(leftVectors.begin() + r * rank, kept, leftVectors.begin() + r * kept);
+        }
+        leftVectors.resize(rows * kept);
+        rightVectors.resize(kept * columns);
+    }
+    return kept;
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::moveCenter(const size_t &site) {
+    while(center < site){
+        // A = U (S V^H): U stays on the center and S V^H is absorbed by the next site
+        const size_t left = bondDimensions[center];
+        const size_t right = bondDimensions[center + 1];
+        const size_t next = bondDimensions[center + 2];
+        matrix.assign(sites[center].begin(), sites[center].end());
+        const size_t kept = split(left * 2, right, false);
+        sites[center].assign(leftVectors.begin(), leftVectors.end());
+        block.assign(kept * 2 * next, 0);
+        for(size_t k = 0; k < kept; k++){
+            for(size_t r = 0; r < right; r++){
+                const Amplitude factor = singularValues[k] * rightVectors[k * right + r];
+                for(size_t i = 0; i < 2 * next; i++){
+                    block[k * 2 * next + i] += factor * sites[center + 1][r * 2 * next + i];
+                }
+            }
+        }
+        sites[center + 1].swap(block);
+        bondDimensions[center + 1] = kept;
+        center++;
+    }
+    while(center > site){
+        // A = (U S) V^H: V^H stays on the center and U S is absorbed by the previous site
+        const size_t previous = bondDimensions[center - 1];
+        const size_t left = bondDimensions[center];
+        const size_t right = bondDimensions[center + 1];
+        matrix.assign(sites[center].begin(), sites[center].end());
+        const size_t kept = split(left, 2 * right, false);
+        sites[center].assign(rightVectors.begin(), rightVectors.end());
+        block.assign(previous * 2 * kept, 0);
+        for(size_t i = 0; i < previous * 2; i++){
+            for(size_t l = 0; l < left; l++){
+                const Amplitude factor = sites[center - 1][i * left + l];
+                for(size_t k = 0; k < kept; k++){
+                    block[i * kept + k] += factor * leftVectors[l * kept + k] * singularValues[k];
+                }
+            }
+        }
+        sites[center - 1].swap(block);
+        bondDimensions[center] = kept;
+        center--;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+template<class Transform>
+void MatrixProductState<FloatingNumberType>::applyBlock(const size_t &first, const size_t &count, const Transform &transform) {
+    const size_t states = size_t(1) << count;
+    localAmplitudes.resize(states);
+    if(count == 1){
+        // A unitary on a single site keeps the canonical form, wherever the center is
+        auto& site = sites[first];
+        const size_t left = bondDimensions[first];
+        const size_t right = bondDimensions[first + 1];
+        for(size_t l = 0; l < left; l++){
+            for(size_t r = 0; r < right; r++){
+                localAmplitudes[0] = site[l * 2 * right + r];
+                localAmplitudes[1] = site[(l * 2 + 1) * right + r];
+                transform(std::span<Amplitude>(localAmplitudes));
+                site[l * 2 * right + r] = localAmplitudes[0];
+                site[(l * 2 + 1) * right + r] = localAmplitudes[1];
+            }
+        }
+        return;
+    }
+
+    // With the center on the first site, the singular values of the splits are the Schmidt coefficients of the state
+    moveCenter(first);
+    const size_t left = bondDimensions[first];
+    size_t right = bondDimensions[first + 1];
+    block.assign(sites[first].begin(), sites[first].end());
+    for(size_t j = 1; j < count; j++){
+        const auto& site = sites[first + j];
+        const size_t contracted = size_t(1) << j;
+        const size_t next = bondDimensions[first + j + 1];
+        matrix.assign(left * contracted * 2 * next, 0);
+        for(size_t l = 0; l < left; l++){
+            for(size_t p = 0; p < contracted; p++){
+                for(size_t r = 0; r < right; r++){
+                    const Amplitude amplitude = block[(l * contracted + p) * right + r];
+                    if(amplitude == Amplitude(0)){
+                        continue;
+                    }
+                    for(size_t s = 0; s < 2; s++){
+                        Amplitude *target = matrix.data() + (l * 2 * contracted + (p | (s << j))) * next;
+                        const Amplitude *source = site.data() + (r * 2 + s) * next;
+                        for(size_t n = 0; n < next; n++){
+                            target[n] += amplitude * source[n];
+                        }
+                    }
+                }
+            }
+        }
+        block.swap(matrix);
+        right = next;
+    }
+
+    for(size_t l = 0; l < left; l++){
+        for(size_t r = 0; r < right; r++){
+            for(size_t p = 0; p < states; p++){
+                localAmplitudes[p] = block[(l * states + p) * right + r];
+            }
+            transform(std::span<Amplitude>(localAmplitudes));
+            for(size_t p = 0; p < states; p++){
+                block[(l * states + p) * right + r] = localAmplitudes[p];
+            }
+        }
+    }
+
+    // Splitting off one site at a time, from the left, leaves the center on the last site
+    size_t bond = left;
+    for(size_t j = 0; j + 1 < count; j++){
+        const size_t remaining = states >> (j + 1);
+        const size_t columns = remaining * right;
+        matrix.resize(bond * 2 * columns);
+        for(size_t l = 0; l < bond; l++){
+            for(size_t p = 0; p < 2 * remaining; p++){
+                std::copy_n(block.begin() + (l * 2 * remaining + p) * right, right,
+                            matrix.begin() + (l * 2 + (p & 1)) * columns + (p >> 1) * right);
+            }
+        }
+        const size_t kept = split(bond * 2, columns, true);
+        sites[first + j].assign(leftVectors.begin(), leftVectors.end());
+        bondDimensions[first + j + 1] = kept;
+        block.resize(kept * columns);
+        for(size_t k = 0; k < kept; k++){
+            for(size_t i = 0; i < columns; i++){
+                block[k * columns + i] = singularValues[k] * rightVectors[k * columns + i];
+            }
+        }
+        bond = kept;
+    }
+    sites[first + count - 1].assign(block.begin(), block.end());
+    center = first + count - 1;
+}
+
+template<std_floating_point FloatingNumberType>
+template<class Transform>
+void MatrixProductState<FloatingNumberType>::applyOperator(const std::vector<size_t> &qubits, const Transform &transform) {
+    const size_t first = qubits.front();
+    for(size_t j = 1; j < qubits.size(); j++){
+        for(size_t site = qubits[j]; site > first + j; site--){
+            swapSites(site - 1);
+        }
+    }
+    applyBlock(first, qubits.size(), transform);
+    for(size_t j = qubits.size() - 1; j > 0; j--){
+        for(size_t site = first + j; site < qubits[j]; site++){
+            swapSites(site);
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::swapSites(const size_t &site) {
+    applyBlock(site, 2, [](std::span<Amplitude> local){
+        std::swap(local[1], local[2]);
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<size_t> &MatrixProductState<FloatingNumberType>::getQubits(std::span<const size_t> targets,
+                                                                             std::span<const size_t> controls) {
+    operationQubits.assign(targets.begin(), targets.end());
+    operationQubits.insert(operationQubits.end(), controls.begin(), controls.end());
+    std::sort(operationQubits.begin(), operationQubits.end());
+    return operationQubits;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t MatrixProductState<FloatingNumberType>::getLocalMask(const std::vector<size_t> &qubits,
+                                                            std::span<const size_t> controls) {
+    size_t localMask = 0;
+    for(const size_t &control : controls){
+        localMask |= getLocalBit(qubits, control);
+    }
+    return localMask;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t MatrixProductState<FloatingNumberType>::getLocalBit(const std::vector<size_t> &qubits, const size_t &qubit) {
+    return size_t(1) << (std::lower_bound(qubits.begin(), qubits.end(), qubit) - qubits.begin());
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::applyMatrix(const size_t &target, const Matrix &matrix_,
+                                                         std::span<const size_t> controls) {
+    const std::vector<size_t> &qubits = getQubits(std::span<const size_t>(&target, 1), controls);
+    const size_t targetBit = getLocalBit(qubits, target);
+    const size_t localMask = getLocalMask(qubits, controls);
+    applyOperator(qubits, [&](std::span<Amplitude> local){
+        for(size_t i = 0; i < local.size(); i++){
+            if((i & targetBit) == 0 && (i & localMask) == localMask){
+                const Amplitude zero = local[i];
+                const Amplitude one = local[i | targetBit];
+                local[i] = matrix_[0] * zero + matrix_[1] * one;
+                local[i | targetBit] = matrix_[2] * zero + matrix_[3] * one;
+            }
+        }
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::applyUnitary(std::span<const size_t> targets,
+                                                          std::span<const Amplitude> matrix_,
+                                                          std::span<const size_t> controls) {
+    const std::vector<size_t> &qubits = getQubits(targets, controls);
+    const size_t localMask = getLocalMask(qubits, controls);
+    // The local bits of each basis state of the targets
+    const size_t dimension = size_t(1) << targets.size();
+    targetOffsets.assign(dimension, 0);
+    for(size_t state = 0; state < dimension; state++){
+        for(size_t i = 0; i < targets.size(); i++){
+            if((state >> i) & 1){
+                targetOffsets[state] |= getLocalBit(qubits, targets[i]);
+            }
+        }
+    }
+    gathered.resize(dimension);
+    applyOperator(qubits, [&](std::span<Amplitude> local){
+        for(size_t i = 0; i < local.size(); i++){
+            if((i & targetOffsets.back()) == 0 && (i & localMask) == localMask){
+                for(size_t column = 0; column < dimension; column++){
+                    gathered[column] = local[i | targetOffsets[column]];
+                }
+                for(size_t row = 0; row < dimension; row++){
+                    Amplitude sum = 0;
+                    for(size_t column = 0; column < dimension; column++){
+                        sum += matrix_[row * dimension + column] * gathered[column];
+                    }
+                    local[i | targetOffsets[row]] = sum;
+                }
+            }
+        }
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::applyPermutation(std::span<const size_t> targets,
+                                                              std::span<const size_t> table,
+                                                              std::span<const size_t> controls) {
+    const std::vector<size_t> &qubits = getQubits(targets, controls);
+    const size_t localMask = getLocalMask(qubits, controls);
+    targetOffsets.assign(table.size(), 0);
+    for(size_t state = 0; state < table.size(); state++){
+        for(size_t i = 0; i < targets.size(); i++){
+            if((state >> i) & 1){
+                targetOffsets[state] |= getLocalBit(qubits, targets[i]);
+            }
+        }
+    }
+    gathered.resize(table.size());
+    applyOperator(qubits, [&](std::span<Amplitude> local){
+        for(size_t i = 0; i < local.size(); i++){
+            if((i & targetOffsets.back()) == 0 && (i & localMask) == localMask){
+                for(size_t state = 0; state < table.size(); state++){
+                    gathered[state] = local[i | targetOffsets[state]];
+                }
+                for(size_t state = 0; state < table.size(); state++){
+                    local[i | targetOffsets[table[state]]] = gathered[state];
+                }
+            }
+        }
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::applyX(const size_t &target, std::span<const size_t> controls) {
+    applyMatrix(target, Matrix{0, 1, 1, 0}, controls);
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::applyPhase(const size_t &target, const Amplitude &phase,
+                                                        std::span<const size_t> controls) {
+    applyMatrix(target, Matrix{1, 0, 0, phase}, controls);
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::applyDiagonal(const size_t &lowestQubit, std::span<const Amplitude> phases) {
+    operationQubits.resize(std::countr_zero(phases.size()));
+    std::iota(operationQubits.begin(), operationQubits.end(), lowestQubit);
+    applyOperator(operationQubits, [&](std::span<Amplitude> local){
+        for(size_t i = 0; i < local.size(); i++){
+            local[i] *= phases[i];
+        }
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::applySwap(const size_t &qubit1, const size_t &qubit2,
+                                                       std::span<const size_t> controls) {
+    const std::array<size_t, 2> targets{qubit1, qubit2};
+    const std::vector<size_t> &qubits = getQubits(targets, controls);
+    const size_t bit1 = getLocalBit(qubits, qubit1);
+    const size_t bit2 = getLocalBit(qubits, qubit2);
+    const size_t localMask = getLocalMask(qubits, controls);
+    applyOperator(qubits, [&](std::span<Amplitude> local){
+        for(size_t i = 0; i < local.size(); i++){
+            if((i & bit1) != 0 && (i & bit2) == 0 && (i & localMask) == localMask){
+                std::swap(local[i], local[i ^ bit1 ^ bit2]);
+            }
+        }
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::getSiteWeights(const size_t &target, FloatingNumberType &zeroWeight,
+                                                            FloatingNumberType &oneWeight, Amplitude &coherence) const {
+    const MatrixProductState *centered = this;
+    std::optional<MatrixProductState> copy;
+    if(center != target){
+        copy.emplace(*this);
+        copy->moveCenter(target);
+        centered = &*copy;
+    }
+    const auto& site = centered->sites[target];
+    const size_t left = centered->bondDimensions[target];
+    const size_t right = centered->bondDimensions[target + 1];
+    zeroWeight = 0;
+    oneWeight = 0;
+    coherence = 0;
+    for(size_t l = 0; l < left; l++){
+        for(size_t r = 0; r < right; r++){
+            const Amplitude zero = site[l * 2 * right + r];
+            const Amplitude one = site[(l * 2 + 1) * right + r];
+            zeroWeight += std::norm(zero);
+            oneWeight += std::norm(one);
+            coherence += std::conj(zero) * one;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+typename MatrixProductState<FloatingNumberType>::Amplitude
+MatrixProductState<FloatingNumberType>::getAmplitude(const size_t &basisState) const {
+    // The row vector of the contraction of the sites so far, indexed by the right bond of the last one
+    std::vector<Amplitude> vector{1};
+    std::vector<Amplitude> next;
+    for(size_t i = 0; i < qubitCount; i++){
+        const size_t bit = (basisState >> i) & 1;
+        const size_t right = bondDimensions[i + 1];
+        next.assign(right, 0);
+        for(size_t l = 0; l < vector.size(); l++){
+            for(size_t r = 0; r < right; r++){
+                next[r] += vector[l] * sites[i][(l * 2 + bit) * right + r];
+            }
+        }
+        vector.swap(next);
+    }
+    return vector[0];
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType MatrixProductState<FloatingNumberType>::getOneProbability(const size_t &target) const {
+    FloatingNumberType zeroWeight;
+    FloatingNumberType oneWeight;
+    Amplitude coherence;
+    getSiteWeights(target, zeroWeight, oneWeight, coherence);
+    return oneWeight / (zeroWeight + oneWeight);
+}
+
+template<std_floating_point FloatingNumberType>
+ClassicBit MatrixProductState<FloatingNumberType>::measure(const size_t &target) {
+    moveCenter(target);
+    FloatingNumberType zeroWeight;
+    FloatingNumberType oneWeight;
+    Amplitude coherence;
+    getSiteWeights(target, zeroWeight, oneWeight, coherence);
+    const FloatingNumberType oneProbability = oneWeight / (zeroWeight + oneWeight);
+    const FloatingNumberType zeroProbability = 1 - oneProbability;
+    const bool outcome = !(probabilityEngine->getProbability() < zeroProbability);
+    // Projecting the center keeps the canonical form, and the scale normalizes the state
+    const FloatingNumberType scale = 1 / std::sqrt(outcome ? oneWeight : zeroWeight);
+    auto& site = sites[target];
+    const size_t right = bondDimensions[target + 1];
+    for(size_t l = 0; l < bondDimensions[target]; l++){
+        for(size_t r = 0; r < right; r++){
+            site[(l * 2 + outcome) * right + r] *= scale;
+            site[(l * 2 + !outcome) * right + r] = 0;
+        }
+    }
+    return ClassicBit(outcome);
+}
+
+template<std_floating_point FloatingNumberType>
+void MatrixProductState<FloatingNumberType>::initialize(const size_t &target, const Matrix &preparation) {
+    if(measure(target).getState() == ClassicBit::State::ONE){
+        applyX(target);
+    }
+    applyMatrix(target, preparation);
+}
+
+template<std_floating_point FloatingNumberType>
+typename Qubit<FloatingNumberType>::State MatrixProductState<FloatingNumberType>::getQubitState(const size_t &target) const {
+    FloatingNumberType zeroWeight;
+    FloatingNumberType oneWeight;
+    Amplitude coherence;
+    getSiteWeights(target, zeroWeight, oneWeight, coherence);
+    const FloatingNumberType total = zeroWeight + oneWeight;
+    const FloatingNumberType relativePhase = std::abs(coherence) > 0 ? std::arg(coherence) : 0;
+    return typename Qubit<FloatingNumberType>::State(probabilityEngine, std::sqrt(zeroWeight / total),
+                                                     std::polar(std::sqrt(oneWeight / total), relativePhase));
+}
+
+template<std_floating_point FloatingNumberType>
+std::string MatrixProductState<FloatingNumberType>::getRepresentation() const {
+    std::string representation = "Bond dimensions:";
+    for(const auto& dimension : bondDimensions){
+        representation += " ";
+        representation += std::to_string(dimension);
+    }
+    return representation + "\nDiscarded weight: " + std::to_string(discardedWeight);
+}
@@ -2,11 +2,9 @@ template<std_floating_point FloatingNumberType>
 Circuit<FloatingNumberType>::MeasureGate::MeasureGate(const std::vector<std::pair<size_t, size_t>>& qubitClassicBitPairs) : qubitClassicBitPairs(qubitClassicBitPairs) {}
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::MeasureGate::apply(Circuit<FloatingNumberType> *circuit) {
+void Circuit<FloatingNumberType>::MeasureGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
     for (auto& qubitClassicBitPair : qubitClassicBitPairs){
-        auto& qubit = circuit->qubits[qubitClassicBitPair.first];
-        auto& classicBit = circuit->classicBits[qubitClassicBitPair.second];
-        classicBit = qubit.measure();
+        program.addMeasure(circuit->resolveQubit(qubitClassicBitPair.first), circuit->resolveClassicBit(qubitClassicBitPair.second));
     }
 }
 
@@ -26,7 +24,13 @@ std::string Circuit<FloatingNumberType>::MeasureGate::getRepresentation() const
 template<std_floating_point FloatingNumberType>
 typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::MeasureGate::getDrawings(
         const Circuit<FloatingNumberType> *circuit) const {
-    std::vector<std::array<std::string, 3>> drawings(circuit->qubits.size() + 1);
+    // Every measurement runs from its qubit down to the row of the classic bits
+    typename Gate::Drawings drawings;
+    drawings.firstRow = circuit->getQubitCount();
+    for(auto& [qubitIndex, classicBitIndex] : qubitClassicBitPairs){
+        drawings.firstRow = std::min(drawings.firstRow, qubitIndex);
+    }
+    drawings.rows.resize(circuit->getQubitCount() + 1 - drawings.firstRow);
     for(auto& [qubitIndex, classicBitIndex] : qubitClassicBitPairs){
         std::string indexString = std::to_string(classicBitIndex);
         size_t indexStringLength = indexString.size() % 2 == 0 ? indexString.size() + 1 : indexString.size();
@@ -68,21 +72,21 @@ typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>
         std::array<std::string, 3> targetDrawing = {boxTop, boxMiddle, boxBottom};
         std::array<std::string, 3> measureDrawing = {measureTop, measureMiddle, measureBottom};
         size_t i;
-        for(i = 0; i < qubitIndex; i++){
+        for(i = 0; i < qubitIndex - drawings.firstRow; i++){
             for(size_t j = 0; j < 3; j++){
-                drawings[i][j] += outsideDrawing[j];
+                drawings.rows[i][j] += outsideDrawing[j];
             }
         }
         for(size_t j = 0; j < 3; j++){
-            drawings[i][j] += targetDrawing[j];
+            drawings.rows[i][j] += targetDrawing[j];
         }
-        for(i++; i < drawings.size() - 1; i++){
+        for(i++; i < drawings.rows.size() - 1; i++){
             for(size_t j = 0; j < 3; j++){
-                drawings[i][j] += insideDrawing[j];
+                drawings.rows[i][j] += insideDrawing[j];
             }
         }
         for(size_t j = 0; j < 3; j++){
-            drawings[i][j] += measureDrawing[j];
+            drawings.rows[i][j] += measureDrawing[j];
         }
     }
     return drawings;
@@ -96,10 +100,53 @@ std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumb
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::MeasureGate::verify(const Circuit* circuit) const {
     for(auto& [qubitIndex, classicBitIndex] : qubitClassicBitPairs){
-        if(qubitIndex >= circuit->qubits.size()){
+        if(qubitIndex >= circuit->getQubitCount()){
             throw Circuit<FloatingNumberType>::InvalidQubitIndexException(qubitIndex);
-        } else if(classicBitIndex >= circuit->classicBits.size()){
+        } else if(classicBitIndex >= circuit->getClassicBitCount()){
             throw Circuit<FloatingNumberType>::InvalidClassicBitIndexException(classicBitIndex);
         }
     }
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::MeasureGate::isDeterministic() const {
+    return false;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<std::pair<size_t, size_t>> &Circuit<FloatingNumberType>::MeasureGate::getQubitClassicBitPairs() const {
+    return qubitClassicBitPairs;
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::MeasureGate::getQubitIndices() const {
+    std::vector<size_t> qubitIndices;
+    for(const auto& [qubitIndex, classicBitIndex] : qubitClassicBitPairs){
+        qubitIndices.push_back(qubitIndex);
+    }
+    return qubitIndices;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::MeasureGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    for(auto& [qubitIndex, classicBitIndex] : qubitClassicBitPairs){
+        qubitIndex = qubitMap[qubitIndex];
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::MeasureGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::MEASURE);
+    encoder.writeWord(qubitClassicBitPairs.size());
+    for(const auto &[qubitIndex, classicBitIndex]: qubitClassicBitPairs){
+        encoder.writeWord(qubitIndex);
+        encoder.writeWord(classicBitIndex);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::MeasureGate::writeQASM(QASMWriter &writer) const {
+    for(const auto &[qubitIndex, classicBitIndex]: qubitClassicBitPairs){
+        writer.writeMeasure(qubitIndex, classicBitIndex);
+    }
+}
@@ -0,0 +1,115 @@
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::PermutationGate::InvalidPermutationException::InvalidPermutationException(const size_t &qubitCount):
+        std::runtime_error("Invalid permutation table for " + std::to_string(qubitCount) + " qubits"),
+        qubitCount(qubitCount) {}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::PermutationGate::getDrawings(
+        const Circuit<FloatingNumberType> *circuit) const {
+    if(qubitIndices.size() == 1){
+        return Circuit<FloatingNumberType>::Gate::getStandardDrawing(circuit, "P", qubitIndices[0]);
+    }
+    // Permutations on several qubits are drawn like a CircuitGate spanning them
+    CircuitGate block(std::make_shared<Circuit<FloatingNumberType>>(circuit->probabilityEngine, qubitIndices.size()),
+                      qubitIndices);
+    block.name = "PERM";
+    return static_cast<const Gate&>(block).getDrawings(circuit);
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::PermutationGate::PermutationGate(const std::vector<size_t> &qubitIndices,
+                                                              const std::vector<size_t> &table): qubitIndices(qubitIndices),
+                                                                                                 table(table) {}
+
+template<std_floating_point FloatingNumberType>
+std::string Circuit<FloatingNumberType>::PermutationGate::getRepresentation() const {
+    std::string representation = "PERM[";
+    for(size_t i = 0; i < qubitIndices.size(); i++){
+        representation += (i == 0 ? "Q#" : ", Q#") + std::to_string(qubitIndices[i]);
+    }
+    return representation + "]";
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::PermutationGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    std::vector<size_t> targets(qubitIndices.size());
+    for(size_t i = 0; i < qubitIndices.size(); i++){
+        targets[i] = circuit->resolveQubit(qubitIndices[i]);
+    }
+    program.addPermutation(targets, table, circuit->controls);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::PermutationGate::verify(const Circuit *circuit) const {
+    for(const auto& qubitIndex : qubitIndices){
+        if(qubitIndex >= circuit->getQubitCount()){
+            throw Circuit<FloatingNumberType>::InvalidQubitIndexException(qubitIndex);
+        }
+    }
+    const size_t dimension = size_t(1) << qubitIndices.size();
+    if(table.size() != dimension){
+        throw InvalidPermutationException(qubitIndices.size());
+    }
+    std::vector<bool> reached(dimension, false);
+    for(const auto& image : table){
+        if(image >= dimension || reached[image]){
+            throw InvalidPermutationException(qubitIndices.size());
+        }
+        reached[image] = true;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumberType>::PermutationGate::clone() const {
+    return std::make_unique<PermutationGate>(*this);
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::PermutationGate::getQubitIndices() const {
+    return qubitIndices;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::PermutationGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    for(auto& qubitIndex : qubitIndices){
+        qubitIndex = qubitMap[qubitIndex];
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::PermutationGate::isPermutation() const {
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::PermutationGate::permuteBasisState(const size_t &basisState) const {
+    size_t localState = 0;
+    size_t mask = 0;
+    for(size_t i = 0; i < qubitIndices.size(); i++){
+        localState |= ((basisState >> qubitIndices[i]) & 1) << i;
+        mask |= size_t(1) << qubitIndices[i];
+    }
+    const size_t image = table[localState];
+    size_t permutedState = basisState & ~mask;
+    for(size_t i = 0; i < qubitIndices.size(); i++){
+        permutedState |= ((image >> i) & 1) << qubitIndices[i];
+    }
+    return permutedState;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<size_t> &Circuit<FloatingNumberType>::PermutationGate::getTable() const {
+    return table;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::PermutationGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::PERMUTATION);
+    encoder.writeWord(qubitIndices.size());
+    for(const auto &qubitIndex: qubitIndices){
+        encoder.writeWord(qubitIndex);
+    }
+    for(const auto &image: table){
+        encoder.writeWord(image);
+    }
+}
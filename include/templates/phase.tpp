@@ -11,10 +11,10 @@ typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>
 }
 
 template<std_floating_point FloatingNumberType>
-Circuit<FloatingNumberType>::PhaseGate::PhaseGate(const size_t &qubitIndex, const double& angle): SingleTargetGate(qubitIndex), angle(angle) {}
+Circuit<FloatingNumberType>::PhaseGate::PhaseGate(const size_t &qubitIndex, const Angle<FloatingNumberType> &angle): SingleTargetGate(qubitIndex), angle(angle) {}
 
 template<std_floating_point FloatingNumberType>
-Circuit<FloatingNumberType>::ControlledPhaseGate::ControlledPhaseGate(const size_t &controlQubitIndex, const size_t &qubitIndex, const double& angle):
+Circuit<FloatingNumberType>::ControlledPhaseGate::ControlledPhaseGate(const size_t &controlQubitIndex, const size_t &qubitIndex, const Angle<FloatingNumberType> &angle):
 Circuit<FloatingNumberType>::SingleTargetGate(qubitIndex),
 Circuit<FloatingNumberType>::ControlledGate(controlQubitIndex),
 Circuit<FloatingNumberType>::PhaseGate(qubitIndex, angle) {}
@@ -30,18 +30,26 @@ std::string Circuit<FloatingNumberType>::ControlledPhaseGate::getRepresentation(
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::PhaseGate::apply(Circuit<FloatingNumberType> *circuit) {
-    auto& targetQubit = circuit->qubits[SingleTargetGate::qubitIndex];
-    const auto newAlpha = targetQubit.getState().getAlpha();
-    const auto newBeta = targetQubit.getState().getBeta() * std::exp(std::complex<FloatingNumberType>(0, angle));
-    targetQubit.setState(newAlpha, newBeta);
+void Circuit<FloatingNumberType>::PhaseGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    if(angle.isParametric()){
+        program.addParametricPhase(circuit->resolveQubit(SingleTargetGate::qubitIndex), angle, circuit->parameterValues,
+                                   circuit->controls);
+        return;
+    }
+    program.addPhase(circuit->resolveQubit(SingleTargetGate::qubitIndex),
+                     std::exp(std::complex<FloatingNumberType>(0, angle.getOffset())), circuit->controls);
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::ControlledPhaseGate::apply(Circuit<FloatingNumberType> *circuit) {
-    if(Circuit<FloatingNumberType>::ControlledGate::getControlState(circuit)) {
-        Circuit<FloatingNumberType>::PhaseGate::apply(circuit);
-    }
+bool Circuit<FloatingNumberType>::PhaseGate::isParametric() const {
+    return angle.isParametric();
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::ControlledPhaseGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    const size_t previousControlCount = circuit->pushControl(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    Circuit<FloatingNumberType>::PhaseGate::compile(circuit, program);
+    circuit->popControl(previousControlCount);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -56,7 +64,7 @@ std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumb
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::PhaseGate::verify(const Circuit* circuit) const {
-    if(SingleTargetGate::qubitIndex >= circuit->qubits.size()){
+    if(SingleTargetGate::qubitIndex >= circuit->getQubitCount()){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(SingleTargetGate::qubitIndex);
     }
 }
@@ -65,4 +73,42 @@ template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::ControlledPhaseGate::verify(const Circuit* circuit) const {
     Circuit<FloatingNumberType>::ControlledGate::verify(circuit);
     Circuit<FloatingNumberType>::PhaseGate::verify(circuit);
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::ControlledPhaseGate::getQubitIndices() const {
+    return {Circuit<FloatingNumberType>::ControlledGate::controlIndex, Circuit<FloatingNumberType>::PhaseGate::qubitIndex};
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::ControlledPhaseGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    Circuit<FloatingNumberType>::ControlledGate::controlIndex = qubitMap[Circuit<FloatingNumberType>::ControlledGate::controlIndex];
+    Circuit<FloatingNumberType>::SingleTargetGate::remapQubits(qubitMap);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::PhaseGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::PHASE);
+    encoder.writeWord(SingleTargetGate::qubitIndex);
+    encoder.writeAngle(angle);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::PhaseGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("u1", {SingleTargetGate::qubitIndex}, {writer.evaluate(angle)});
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::ControlledPhaseGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::CONTROLLED_PHASE);
+    encoder.writeWord(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    encoder.writeWord(Circuit<FloatingNumberType>::PhaseGate::qubitIndex);
+    encoder.writeAngle(PhaseGate::angle);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::ControlledPhaseGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("cu1", {Circuit<FloatingNumberType>::ControlledGate::controlIndex,
+                                  Circuit<FloatingNumberType>::PhaseGate::qubitIndex},
+                          {writer.evaluate(PhaseGate::angle)});
+}
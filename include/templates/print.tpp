@@ -4,8 +4,8 @@ Circuit<FloatingNumberType>::PrintGate::PrintGate(const size_t &qubitIndex, std:
         outputStream(outputStream){}
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::PrintGate::apply(Circuit<FloatingNumberType> *circuit) {
-    *outputStream << circuit->qubits[SingleTargetGate::qubitIndex].getState() << std::endl;
+void Circuit<FloatingNumberType>::PrintGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    program.addPrint(circuit->resolveQubit(SingleTargetGate::qubitIndex), outputStream);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -27,4 +27,14 @@ typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>
 template<std_floating_point FloatingNumberType>
 std::string Circuit<FloatingNumberType>::PrintGate::getRepresentation() const {
     return "PRINT[Q#" + std::to_string(SingleTargetGate::qubitIndex) + "]";
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::PrintGate::isDeterministic() const {
+    return false;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::PrintGate::writeQASM(QASMWriter &writer) const {
+    writer.writeComment(getRepresentation());
+}
@@ -1,11 +1,92 @@
 template<std_floating_point FloatingNumberType>
-ProbabilityEngine<FloatingNumberType>::ProbabilityEngine(): device(std::random_device()), distribution(0.0, 1.0) {}
+ProbabilityEngine<FloatingNumberType>::ProbabilityEngine(): ProbabilityEngine(2e-10) {}
+
+template<std_floating_point FloatingNumberType>
+ProbabilityEngine<FloatingNumberType>::ProbabilityEngine(const FloatingNumberType& errorMargin_):
+        ProbabilityEngine(errorMargin_, static_cast<std::uint64_t>(std::random_device()()) << 32 | std::random_device()()) {}
+
+template<std_floating_point FloatingNumberType>
+ProbabilityEngine<FloatingNumberType>::ProbabilityEngine(const FloatingNumberType& errorMargin_, const std::uint64_t& seed_,
+                                                         const Mode& mode_):
+        errorMargin(errorMargin_),
+        seed(seed_),
+        mode(mode_),
+        sequentialGenerator(seed_),
+        counterGenerator(seed_, 0) {}
+
+template<std_floating_point FloatingNumberType>
+std::uint64_t ProbabilityEngine<FloatingNumberType>::getBits() {
+    drawCount++;
+    return mode == SEQUENTIAL ? sequentialGenerator() : counterGenerator();
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType ProbabilityEngine<FloatingNumberType>::toProbability(const std::uint64_t& bits) {
+    // Keep as many bits as the mantissa can represent exactly, so the result is never rounded up to 1
+    constexpr int digits = std::min(std::numeric_limits<FloatingNumberType>::digits, 64);
+    return static_cast<FloatingNumberType>(bits >> (64 - digits)) * std::ldexp(FloatingNumberType(1), -digits);
+}
 
 template<std_floating_point FloatingNumberType>
 FloatingNumberType ProbabilityEngine<FloatingNumberType>::getProbability() {
-    std::mt19937_64 generator(device());
-    return distribution(generator);
+    return toProbability(getBits());
+}
+
+template<std_floating_point FloatingNumberType>
+void ProbabilityEngine<FloatingNumberType>::fill(std::span<FloatingNumberType> values) {
+    drawCount += values.size();
+    if(mode == SEQUENTIAL){
+        for(auto& value : values){
+            value = toProbability(sequentialGenerator());
+        }
+    } else {
+        for(auto& value : values){
+            value = toProbability(counterGenerator());
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void ProbabilityEngine<FloatingNumberType>::discard(const std::uint64_t &count) {
+    drawCount += count;
+    if(mode == SEQUENTIAL){
+        sequentialGenerator.discard(count);
+    } else {
+        counterGenerator.discard(count);
+    }
 }
 
 template<std_floating_point FloatingNumberType>
-ProbabilityEngine<FloatingNumberType>::ProbabilityEngine(const FloatingNumberType& errorMargin_): errorMargin(errorMargin_) {}
\ No newline at end of file
+void ProbabilityEngine<FloatingNumberType>::setSeed(const std::uint64_t& seed_) {
+    seed = seed_;
+    sequentialGenerator.seed(seed_);
+    counterGenerator = Philox(seed_, counterGenerator.getStream());
+}
+
+template<std_floating_point FloatingNumberType>
+std::uint64_t ProbabilityEngine<FloatingNumberType>::getSeed() const {
+    return seed;
+}
+
+template<std_floating_point FloatingNumberType>
+typename ProbabilityEngine<FloatingNumberType>::Mode ProbabilityEngine<FloatingNumberType>::getMode() const {
+    return mode;
+}
+
+template<std_floating_point FloatingNumberType>
+std::uint64_t ProbabilityEngine<FloatingNumberType>::getDrawCount() const {
+    return drawCount;
+}
+
+template<std_floating_point FloatingNumberType>
+std::shared_ptr<ProbabilityEngine<FloatingNumberType>> ProbabilityEngine<FloatingNumberType>::split(const std::uint64_t& stream) const {
+    auto engine = std::make_shared<ProbabilityEngine>(errorMargin, seed, COUNTER_BASED);
+    engine->setStream(stream);
+    return engine;
+}
+
+template<std_floating_point FloatingNumberType>
+void ProbabilityEngine<FloatingNumberType>::setStream(const std::uint64_t& stream) {
+    // Stream 0 is the one of the parent engine in counter-based mode, so the substreams start at 1
+    counterGenerator = Philox(seed, stream + 1);
+}
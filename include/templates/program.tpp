@@ -0,0 +1,453 @@
+template<std_floating_point FloatingNumberType>
+Program<FloatingNumberType>::Program(const size_t &qubitCount, const size_t &classicBitCount):
+        qubitCount(qubitCount),
+        classicBitCount(classicBitCount) {}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addInstruction(const Opcode &opcode, const size_t &target, const size_t &operand,
+                                                 const size_t &count, std::span<const size_t> controls,
+                                                 const Matrix &matrix) {
+    // Only the registers with fewer qubits than the bits of a mask, the ones indexed by basis state, read the mask
+    size_t controlMask = 0;
+    for(const size_t &control : controls){
+        if(control < std::numeric_limits<size_t>::digits){
+            controlMask |= size_t(1) << control;
+        }
+    }
+    instructions.push_back(Instruction{opcode, target, operand, count, controlMask, controlQubits.size(), controls.size(), matrix});
+    controlQubits.insert(controlQubits.end(), controls.begin(), controls.end());
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::beginGate() {
+    gateOffsets.push_back(instructions.size());
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::beginProfile(const std::string &symbol) {
+    const size_t entry = profile.getEntry(symbol, openProfileEntries.empty() ? Profile::NO_PARENT : openProfileEntries.back());
+    openProfileEntries.push_back(entry);
+    addInstruction(ENTER, 0, entry, 0);
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::endProfile() {
+    openProfileEntries.pop_back();
+    addInstruction(LEAVE, 0, 0, 0);
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Program<FloatingNumberType>::allocateClassicBits(const size_t &count) {
+    const size_t first = classicBitCount;
+    classicBitCount += count;
+    return first;
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addMatrix(const size_t &target, const Matrix &matrix, std::span<const size_t> controls) {
+    addInstruction(MATRIX, target, 0, 0, controls, matrix);
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addX(const size_t &target, std::span<const size_t> controls) {
+    addInstruction(X, target, 0, 0, controls);
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addPhase(const size_t &target, const Amplitude &phase, std::span<const size_t> controls) {
+    addInstruction(PHASE, target, 0, 0, controls, {phase});
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addParametricPhase(const size_t &target, const Angle<FloatingNumberType> &angle,
+                                                     std::span<const FloatingNumberType> values,
+                                                     std::span<const size_t> controls) {
+    bindings.push_back(Binding{instructions.size(), angle});
+    addPhase(target, std::polar(FloatingNumberType(1), angle.evaluate(values)), controls);
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::bind(std::span<const FloatingNumberType> values) {
+    for(const auto& binding : bindings){
+        instructions[binding.instruction].matrix[0] = std::polar(FloatingNumberType(1), binding.angle.evaluate(values));
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+bool Program<FloatingNumberType>::isParametric() const {
+    return !bindings.empty();
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addSwap(const size_t &qubit1, const size_t &qubit2, std::span<const size_t> controls) {
+    addInstruction(SWAP, qubit1, qubit2, 0, controls);
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addUnitary(std::span<const size_t> targets, std::span<const Amplitude> matrix,
+                                             std::span<const size_t> controls) {
+    addInstruction(UNITARY, unitaryTargets.size(), unitaryMatrices.size(), targets.size(), controls);
+    unitaryTargets.insert(unitaryTargets.end(), targets.begin(), targets.end());
+    unitaryMatrices.insert(unitaryMatrices.end(), matrix.begin(), matrix.end());
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addPermutation(std::span<const size_t> targets, std::span<const size_t> table,
+                                                 std::span<const size_t> controls) {
+    addInstruction(PERMUTE, unitaryTargets.size(), permutationTables.size(), targets.size(), controls);
+    unitaryTargets.insert(unitaryTargets.end(), targets.begin(), targets.end());
+    permutationTables.insert(permutationTables.end(), table.begin(), table.end());
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addMeasure(const size_t &target, const size_t &classicBit) {
+    addInstruction(MEASURE, target, classicBit, 0);
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addInit(const size_t &target, const Matrix &preparation) {
+    addInstruction(INIT, target, 0, 0, {}, preparation);
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addClear(const size_t &firstClassicBit, const size_t &count) {
+    addInstruction(CLEAR, 0, firstClassicBit, count);
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::addPrint(const size_t &target, std::ostream *outputStream) {
+    addInstruction(PRINT, target, outputStreams.size(), 0);
+    outputStreams.push_back(outputStream);
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Program<FloatingNumberType>::beginClassicControl(const size_t &classicBit) {
+    addInstruction(SKIP_UNLESS, 0, classicBit, 0);
+    return instructions.size() - 1;
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::endClassicControl(const size_t &blockIndex) {
+    instructions[blockIndex].count = instructions.size() - blockIndex - 1;
+}
+
+template<std_floating_point FloatingNumberType>
+void Program<FloatingNumberType>::batchDiagonals(const size_t &maxSpan) {
+    // Runs cannot cross the end of a classically controlled block
+    std::vector<bool> blockEnds(instructions.size() + 1, false);
+    for(size_t i = 0; i < instructions.size(); i++){
+        if(instructions[i].opcode == SKIP_UNLESS){
+            blockEnds[i + instructions[i].count + 1] = true;
+        }
+    }
+    // The phases of parametric instructions change on every bind, so they are kept as they are
+    std::vector<bool> parametric(instructions.size(), false);
+    for(const auto& binding : bindings){
+        parametric[binding.instruction] = true;
+    }
+    // The qubits are compared by index rather than through the masks, which do not hold the qubits of wide registers
+    const auto getLowest = [this](const Instruction &instruction){
+        const std::span<const size_t> controls = getControls(instruction);
+        return std::min(instruction.target, controls.empty() ? instruction.target : *std::min_element(controls.begin(), controls.end()));
+    };
+    const auto getHighest = [this](const Instruction &instruction){
+        const std::span<const size_t> controls = getControls(instruction);
+        return std::max(instruction.target, controls.empty() ? instruction.target : *std::max_element(controls.begin(), controls.end()));
+    };
+
+    std::vector<Instruction> batched;
+    std::vector<size_t> newIndices(instructions.size() + 1);
+    for(size_t i = 0, j; i < instructions.size(); i = j){
+        j = i + 1;
+        if(instructions[i].opcode != PHASE || parametric[i]){
+            newIndices[i] = batched.size();
+            batched.push_back(instructions[i]);
+            continue;
+        }
+        size_t lowestQubit = getLowest(instructions[i]);
+        size_t highestQubit = getHighest(instructions[i]);
+        while(j < instructions.size() && instructions[j].opcode == PHASE && !parametric[j] && !blockEnds[j] &&
+              std::max(highestQubit, getHighest(instructions[j])) - std::min(lowestQubit, getLowest(instructions[j])) < maxSpan){
+            lowestQubit = std::min(lowestQubit, getLowest(instructions[j]));
+            highestQubit = std::max(highestQubit, getHighest(instructions[j]));
+            j++;
+        }
+        for(size_t k = i; k < j; k++){
+            newIndices[k] = batched.size();
+        }
+        if(j - i == 1){
+            batched.push_back(instructions[i]);
+            continue;
+        }
+        const size_t span = highestQubit - lowestQubit + 1;
+        const size_t offset = diagonalPhases.size();
+        diagonalPhases.resize(offset + (size_t(1) << span), Amplitude(1));
+        for(size_t k = i; k < j; k++){
+            size_t localMask = size_t(1) << (instructions[k].target - lowestQubit);
+            for(const size_t &control : getControls(instructions[k])){
+                localMask |= size_t(1) << (control - lowestQubit);
+            }
+            for(size_t localState = localMask; localState < (size_t(1) << span); localState = (localState + 1) | localMask){
+                diagonalPhases[offset + localState] *= instructions[k].matrix[0];
+            }
+        }
+        batched.push_back(Instruction{DIAGONAL, lowestQubit, offset, span, 0, 0, 0, {}});
+    }
+    newIndices[instructions.size()] = batched.size();
+
+    for(size_t i = 0; i < instructions.size(); i++){
+        if(instructions[i].opcode == SKIP_UNLESS){
+            batched[newIndices[i]].count = newIndices[i + instructions[i].count + 1] - newIndices[i] - 1;
+        }
+    }
+    for(auto& gateOffset : gateOffsets){
+        gateOffset = newIndices[gateOffset];
+    }
+    for(auto& binding : bindings){
+        binding.instruction = newIndices[binding.instruction];
+    }
+    instructions = std::move(batched);
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Program<FloatingNumberType>::getQubitCount() const {
+    return qubitCount;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Program<FloatingNumberType>::getClassicBitCount() const {
+    return classicBitCount;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<typename Program<FloatingNumberType>::Instruction> &Program<FloatingNumberType>::getInstructions() const {
+    return instructions;
+}
+
+template<std_floating_point FloatingNumberType>
+std::span<const size_t> Program<FloatingNumberType>::getControls(const Instruction &instruction) const {
+    return std::span<const size_t>(controlQubits).subspan(instruction.controlOffset, instruction.controlCount);
+}
+
+template<std_floating_point FloatingNumberType>
+const Profile &Program<FloatingNumberType>::getProfile() const {
+    return profile;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Program<FloatingNumberType>::getGateOffset(const size_t &gateIndex) const {
+    return gateIndex < gateOffsets.size() ? gateOffsets[gateIndex] : instructions.size();
+}
+
+template<std_floating_point FloatingNumberType>
+bool Program<FloatingNumberType>::isClifford() const {
+    for(const auto& instruction : instructions){
+        bool clifford = true;
+        switch(instruction.opcode){
+            case MATRIX:
+                clifford = Tableau<FloatingNumberType>::isClifford(instruction.matrix, instruction.controlCount);
+                break;
+            case X:
+                clifford = instruction.controlCount <= 1;
+                break;
+            case PHASE:
+                clifford = Tableau<FloatingNumberType>::isClifford(instruction.matrix[0], instruction.controlCount);
+                break;
+            case SWAP:
+                clifford = instruction.controlCount == 0;
+                break;
+            case PERMUTE:
+                clifford = Tableau<FloatingNumberType>::isClifford(
+                        std::span<const size_t>(permutationTables).subspan(instruction.operand, size_t(1) << instruction.count),
+                        instruction.controlCount);
+                break;
+            case DIAGONAL:
+                clifford = Tableau<FloatingNumberType>::isClifford(
+                        std::span<const Amplitude>(diagonalPhases).subspan(instruction.operand, size_t(1) << instruction.count));
+                break;
+            case INIT:
+                clifford = Tableau<FloatingNumberType>::isClifford(instruction.matrix, 0);
+                break;
+            case UNITARY:
+            case PRINT:
+                clifford = false;
+                break;
+            default:
+                break;
+        }
+        if(!clifford){
+            return false;
+        }
+    }
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+template<class Register>
+void Program<FloatingNumberType>::execute(Register &state, std::vector<ClassicBit> &classicBits,
+                                          Profile *profile_) const {
+    execute(state, classicBits, 0, instructions.size(), profile_);
+}
+
+template<std_floating_point FloatingNumberType>
+template<class Register>
+void Program<FloatingNumberType>::execute(Register &state, std::vector<ClassicBit> &classicBits,
+                                          const size_t &begin, const size_t &end, Profile *profile_) const {
+    // The registers indexed by basis state take the controls as a mask, the other ones as a list of qubits
+    const auto getControlOperand = [this](const Instruction &instruction){
+        if constexpr(requires(Register &register_, const size_t &mask){ register_.applyX(mask, mask); }){
+            return instruction.controlMask;
+        } else {
+            return getControls(instruction);
+        }
+    };
+    std::uint64_t measurementCount = 0;
+    for(size_t i = begin; i < end; i++){
+        const Instruction& instruction = instructions[i];
+        switch(instruction.opcode){
+            case MATRIX:
+                state.applyMatrix(instruction.target, instruction.matrix, getControlOperand(instruction));
+                break;
+            case X:
+                state.applyX(instruction.target, getControlOperand(instruction));
+                break;
+            case PHASE:
+                state.applyPhase(instruction.target, instruction.matrix[0], getControlOperand(instruction));
+                break;
+            case SWAP:
+                state.applySwap(instruction.target, instruction.operand, getControlOperand(instruction));
+                break;
+            case UNITARY: {
+                const size_t dimension = size_t(1) << instruction.count;
+                state.applyUnitary(std::span<const size_t>(unitaryTargets).subspan(instruction.target, instruction.count),
+                                   std::span<const Amplitude>(unitaryMatrices).subspan(instruction.operand, dimension * dimension),
+                                   getControlOperand(instruction));
+                break;
+            }
+            case PERMUTE:
+                state.applyPermutation(std::span<const size_t>(unitaryTargets).subspan(instruction.target, instruction.count),
+                                       std::span<const size_t>(permutationTables).subspan(instruction.operand, size_t(1) << instruction.count),
+                                       getControlOperand(instruction));
+                break;
+            case DIAGONAL:
+                state.applyDiagonal(instruction.target,
+                                    std::span<const Amplitude>(diagonalPhases).subspan(instruction.operand, size_t(1) << instruction.count));
+                break;
+            case MEASURE:
+                classicBits[instruction.operand] = state.measure(instruction.target);
+                measurementCount++;
+                break;
+            case INIT:
+                state.initialize(instruction.target, instruction.matrix);
+                break;
+            case CLEAR:
+                std::fill_n(classicBits.begin() + instruction.operand, instruction.count, ClassicBit());
+                break;
+            case SKIP_UNLESS:
+                if(classicBits[instruction.operand].getState() != ClassicBit::State::ONE){
+                    i += instruction.count;
+                }
+                break;
+            case PRINT:
+                *outputStreams[instruction.operand] << state.getQubitState(instruction.target) << std::endl;
+                break;
+            case ENTER:
+                if(profile_ != nullptr){
+                    profile_->enter(instruction.operand, state.getProbabilityEngine()->getDrawCount(), measurementCount);
+                }
+                break;
+            case LEAVE:
+                if(profile_ != nullptr){
+                    profile_->leave(state.getProbabilityEngine()->getDrawCount(), measurementCount);
+                }
+                break;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+template<class Register>
+size_t Program<FloatingNumberType>::executePrefix(Register &state, std::vector<ClassicBit> &classicBits) const {
+    size_t i = 0;
+    for(; i < instructions.size(); i++){
+        const Instruction& instruction = instructions[i];
+        switch(instruction.opcode){
+            case MEASURE:
+            case INIT: {
+                // A draw p gives ❘0〉 when p < zeroProbability, so only the outcomes of probability 0 or 1 are certain
+                const FloatingNumberType zeroProbability = 1 - state.getOneProbability(instruction.target);
+                if(zeroProbability > 0 && zeroProbability < 1){
+                    return i;
+                }
+                execute(state, classicBits, i, i + 1);
+                break;
+            }
+            case SKIP_UNLESS:
+                if(classicBits[instruction.operand].getState() != ClassicBit::State::ONE){
+                    i += instruction.count;
+                }
+                break;
+            case PRINT:
+            case ENTER:
+            case LEAVE:
+                return i;
+            default:
+                execute(state, classicBits, i, i + 1);
+        }
+    }
+    return std::min(i, instructions.size());
+}
+
+template<std_floating_point FloatingNumberType>
+template<class Register, class Leaf>
+void Program<FloatingNumberType>::executeBranches(Register &state, std::vector<ClassicBit> &classicBits,
+                                                  const size_t &begin, const size_t &end,
+                                                  const FloatingNumberType &probability, const Leaf &leaf) const {
+    for(size_t i = begin; i < end; i++){
+        const Instruction& instruction = instructions[i];
+        switch(instruction.opcode){
+            case MEASURE:
+            case INIT: {
+                const FloatingNumberType oneProbability = state.getOneProbability(instruction.target);
+                const auto& engine = state.getProbabilityEngine();
+                const bool zeroPossible = !engine->compare(1 - oneProbability, FloatingNumberType(0));
+                const bool onePossible = !engine->compare(oneProbability, FloatingNumberType(0));
+                const auto follow = [&](Register &branch, std::vector<ClassicBit> &branchBits, const bool &outcome){
+                    const FloatingNumberType outcomeProbability = outcome ? oneProbability : 1 - oneProbability;
+                    branch.collapse(instruction.target, outcome, outcomeProbability);
+                    if(instruction.opcode == MEASURE){
+                        branchBits[instruction.operand] = ClassicBit(outcome);
+                    } else {
+                        if(outcome){
+                            branch.applyX(instruction.target);
+                        }
+                        branch.applyMatrix(instruction.target, instruction.matrix);
+                    }
+                    executeBranches(branch, branchBits, i + 1, end, probability * outcomeProbability, leaf);
+                };
+                if(zeroPossible && onePossible){
+                    Register branch = state;
+                    std::vector<ClassicBit> branchBits = classicBits;
+                    follow(branch, branchBits, true);
+                }
+                follow(state, classicBits, onePossible && !zeroPossible);
+                return;
+            }
+            case CLEAR:
+                std::fill_n(classicBits.begin() + instruction.operand, instruction.count, ClassicBit());
+                break;
+            case SKIP_UNLESS:
+                if(classicBits[instruction.operand].getState() != ClassicBit::State::ONE){
+                    i += instruction.count;
+                }
+                break;
+            case PRINT:
+            case ENTER:
+            case LEAVE:
+                break;
+            default:
+                execute(state, classicBits, i, i + 1);
+        }
+    }
+    leaf(state, classicBits, probability);
+}
@@ -0,0 +1,811 @@
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::UnsupportedGateException::UnsupportedGateException(const std::string &reason):
+        std::runtime_error("Cannot write the circuit as OpenQASM 2: " + reason) {}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::QASMParseException::QASMParseException(const size_t &line, const std::string &reason):
+        std::runtime_error("Invalid OpenQASM 2 at line " + std::to_string(line) + ": " + reason),
+        line(line) {}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::QASMWriter::QASMWriter(std::ostream &stream, const size_t &qubitCount,
+                                                    const bool &splitClassicBits,
+                                                    std::span<const FloatingNumberType> parameterValues):
+        stream(stream),
+        qubitMap(qubitCount),
+        condition(NO_CONDITION),
+        splitClassicBits(splitClassicBits),
+        parameterValues(parameterValues) {
+    for(size_t i = 0; i < qubitCount; i++){
+        qubitMap[i] = i;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+std::string Circuit<FloatingNumberType>::QASMWriter::getClassicBitName(const size_t &classicBitIndex) const {
+    if(splitClassicBits){
+        return "c" + std::to_string(classicBitIndex) + "[0]";
+    }
+    return "c[" + std::to_string(classicBitIndex) + "]";
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMWriter::writeCondition() {
+    if(condition != NO_CONDITION){
+        stream << "if(c" << condition << "==1) ";
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMWriter::writeOperation(const std::string &name, const std::vector<size_t> &qubits,
+                                                             const std::vector<FloatingNumberType> &parameters) {
+    // The controlled versions of the gates defined by qelib1.inc
+    static const std::set<std::string, std::less<>> operations = {
+            "x", "y", "z", "h", "u1", "u3", "swap", "cx", "cy", "cz", "ch", "cu1", "cu3", "ccx", "cswap"
+    };
+    const std::string controlledName = std::string(controls.size(), 'c') + name;
+    if(!operations.contains(controlledName)){
+        throw UnsupportedGateException("qelib1.inc has no " + controlledName + " gate");
+    }
+    writeCondition();
+    stream << controlledName;
+    for(size_t i = 0; i < parameters.size(); i++){
+        stream << (i == 0 ? "(" : ",") << parameters[i];
+    }
+    stream << (parameters.empty() ? " " : ") ");
+    for(size_t i = 0; i < controls.size(); i++){
+        stream << (i == 0 ? "" : ",") << "q[" << controls[i] << "]";
+    }
+    for(size_t i = 0; i < qubits.size(); i++){
+        stream << (i == 0 && controls.empty() ? "" : ",") << "q[" << qubitMap[qubits[i]] << "]";
+    }
+    stream << ";\n";
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMWriter::writeMeasure(const size_t &qubitIndex, const size_t &classicBitIndex) {
+    if(isControlled()){
+        throw UnsupportedGateException("OpenQASM 2 cannot control a measurement with a qubit");
+    }
+    writeCondition();
+    stream << "measure q[" << qubitMap[qubitIndex] << "] -> " << getClassicBitName(classicBitIndex) << ";\n";
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMWriter::writeReset(const size_t &qubitIndex) {
+    if(isControlled()){
+        throw UnsupportedGateException("OpenQASM 2 cannot control a reset with a qubit");
+    }
+    writeCondition();
+    stream << "reset q[" << qubitMap[qubitIndex] << "];\n";
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMWriter::writeComment(const std::string &comment) {
+    stream << "// " << comment << "\n";
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMWriter::writeControlled(const size_t &controlIndex, const bool &classic,
+                                                              const Gate &gate) {
+    if(!classic){
+        controls.push_back(qubitMap[controlIndex]);
+        gate.writeQASM(*this);
+        controls.pop_back();
+        return;
+    }
+    if(!splitClassicBits || condition != NO_CONDITION){
+        throw UnsupportedGateException("OpenQASM 2 conditions can only test a single classic bit of the circuit");
+    }
+    condition = controlIndex;
+    gate.writeQASM(*this);
+    condition = NO_CONDITION;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMWriter::writeCircuit(const Circuit &circuit, const std::vector<size_t> &qubitIndices) {
+    if(circuit.getClassicBitCount() > 0){
+        throw UnsupportedGateException("OpenQASM 2 sub-circuits cannot have classic bits of their own");
+    }
+    std::vector<size_t> innerQubitMap(qubitIndices.size());
+    for(size_t i = 0; i < qubitIndices.size(); i++){
+        innerQubitMap[i] = qubitMap[qubitIndices[i]];
+    }
+    std::swap(qubitMap, innerQubitMap);
+    for(const auto &gate: circuit.getGates()){
+        gate->writeQASM(*this);
+    }
+    std::swap(qubitMap, innerQubitMap);
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType Circuit<FloatingNumberType>::QASMWriter::evaluate(const Angle<FloatingNumberType> &angle) const {
+    return angle.evaluate(parameterValues);
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::QASMWriter::isControlled() const {
+    return !controls.empty();
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::writeQASM(std::ostream &stream) const {
+    // Conditions compare whole registers, so classically controlled gates need a register for every classic bit
+    const bool splitClassicBits = std::any_of(gates->begin(), gates->end(), [](const auto &gate){
+        const auto *controlledGate = dynamic_cast<const CustomControlledGate *>(gate.get());
+        return controlledGate != nullptr && controlledGate->isClassic();
+    });
+    const std::ios_base::fmtflags flags = stream.flags(std::ios_base::fmtflags());
+    const std::streamsize precision = stream.precision(std::numeric_limits<FloatingNumberType>::max_digits10);
+    stream << "OPENQASM 2.0;\ninclude \"qelib1.inc\";\n";
+    if(getQubitCount() > 0){
+        stream << "qreg q[" << getQubitCount() << "];\n";
+    }
+    if(splitClassicBits){
+        for(size_t i = 0; i < classicBitCount; i++){
+            stream << "creg c" << i << "[1];\n";
+        }
+    } else if(classicBitCount > 0){
+        stream << "creg c[" << classicBitCount << "];\n";
+    }
+    QASMWriter writer(stream, getQubitCount(), splitClassicBits, parameterValues);
+    for(const auto &gate: *gates){
+        gate->writeQASM(writer);
+    }
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+template<std_floating_point FloatingNumberType>
+std::string Circuit<FloatingNumberType>::toQASM() const {
+    std::ostringstream stream;
+    writeQASM(stream);
+    return stream.str();
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType> Circuit<FloatingNumberType>::fromQASM(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                                                  std::string_view source) {
+    QASMParser parser(std::move(probabilityEngine), source);
+    return parser.parse();
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::QASMParser::QASMParser(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                                    std::string_view source):
+        probabilityEngine(std::move(probabilityEngine)),
+        source(source) {}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::fail(const std::string &reason) const {
+    const size_t line = 1 + std::count(source.begin(), source.begin() + static_cast<std::ptrdiff_t>(position), '\n');
+    throw QASMParseException(line, reason);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::skipSpace() {
+    while(position < source.size()){
+        const char character = source[position];
+        if(character == ' ' || character == '\t' || character == '\n' || character == '\r'){
+            position++;
+        } else if(character == '/' && position + 1 < source.size() && source[position + 1] == '/'){
+            while(position < source.size() && source[position] != '\n'){
+                position++;
+            }
+        } else {
+            return;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::QASMParser::accept(const char &character) {
+    skipSpace();
+    if(position < source.size() && source[position] == character){
+        position++;
+        return true;
+    }
+    return false;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::expect(const char &character) {
+    if(!accept(character)){
+        fail(std::string("expected '") + character + "'");
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+std::string_view Circuit<FloatingNumberType>::QASMParser::readIdentifier() {
+    skipSpace();
+    const size_t begin = position;
+    while(position < source.size() && (std::isalpha(static_cast<unsigned char>(source[position])) ||
+                                       source[position] == '_' ||
+                                       (position > begin && std::isdigit(static_cast<unsigned char>(source[position]))))){
+        position++;
+    }
+    if(position == begin){
+        fail("expected an identifier");
+    }
+    return source.substr(begin, position - begin);
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::QASMParser::readInteger() {
+    skipSpace();
+    size_t value = 0;
+    const auto [next, error] = std::from_chars(source.data() + position, source.data() + source.size(), value);
+    if(error != std::errc()){
+        fail("expected an integer");
+    }
+    position = static_cast<size_t>(next - source.data());
+    return value;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::readExpression(Expression &terms) {
+    readTerm(terms);
+    while(true){
+        if(accept('+')){
+            readTerm(terms);
+            terms.push_back({Term::ADD});
+        } else if(accept('-')){
+            readTerm(terms);
+            terms.push_back({Term::SUBTRACT});
+        } else {
+            return;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::readTerm(Expression &terms) {
+    readFactor(terms);
+    while(true){
+        if(accept('*')){
+            readFactor(terms);
+            terms.push_back({Term::MULTIPLY});
+        } else if(accept('/')){
+            readFactor(terms);
+            terms.push_back({Term::DIVIDE});
+        } else {
+            return;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::readFactor(Expression &terms) {
+    if(accept('-')){
+        readFactor(terms);
+        terms.push_back({Term::NEGATE});
+        return;
+    }
+    readPrimary(terms);
+    if(accept('^')){
+        readFactor(terms);
+        terms.push_back({Term::POWER});
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::readPrimary(Expression &terms) {
+    if(accept('(')){
+        readExpression(terms);
+        expect(')');
+        return;
+    }
+    skipSpace();
+    if(position < source.size() && (std::isdigit(static_cast<unsigned char>(source[position])) || source[position] == '.')){
+        FloatingNumberType value = 0;
+        const auto [next, error] = std::from_chars(source.data() + position, source.data() + source.size(), value);
+        if(error != std::errc()){
+            fail("invalid number");
+        }
+        position = static_cast<size_t>(next - source.data());
+        terms.push_back({Term::NUMBER, value});
+        return;
+    }
+    const std::string_view name = readIdentifier();
+    if(name == "pi"){
+        terms.push_back({Term::NUMBER, std::numbers::pi_v<FloatingNumberType>});
+        return;
+    }
+    if(definition != nullptr){
+        const auto parameter = std::find(definition->parameters.begin(), definition->parameters.end(), name);
+        if(parameter != definition->parameters.end()){
+            terms.push_back({Term::PARAMETER, 0, static_cast<size_t>(parameter - definition->parameters.begin())});
+            return;
+        }
+    }
+    static const std::map<std::string_view, FloatingNumberType (*)(FloatingNumberType)> functions = {
+            {"sin",  [](FloatingNumberType x){ return std::sin(x); }},
+            {"cos",  [](FloatingNumberType x){ return std::cos(x); }},
+            {"tan",  [](FloatingNumberType x){ return std::tan(x); }},
+            {"exp",  [](FloatingNumberType x){ return std::exp(x); }},
+            {"ln",   [](FloatingNumberType x){ return std::log(x); }},
+            {"sqrt", [](FloatingNumberType x){ return std::sqrt(x); }}
+    };
+    const auto function = functions.find(name);
+    if(function == functions.end()){
+        fail("unknown parameter " + std::string(name));
+    }
+    expect('(');
+    readExpression(terms);
+    expect(')');
+    terms.push_back({Term::FUNCTION, 0, 0, function->second});
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType Circuit<FloatingNumberType>::QASMParser::evaluate(const Expression &terms,
+                                                                     std::span<const FloatingNumberType> parameterValues) {
+    stack.clear();
+    for(const Term &term: terms){
+        if(term.kind == Term::NUMBER){
+            stack.push_back(term.number);
+        } else if(term.kind == Term::PARAMETER){
+            stack.push_back(parameterValues[term.parameter]);
+        } else if(term.kind == Term::NEGATE){
+            stack.back() = -stack.back();
+        } else if(term.kind == Term::FUNCTION){
+            stack.back() = term.function(stack.back());
+        } else {
+            const FloatingNumberType right = stack.back();
+            stack.pop_back();
+            FloatingNumberType &left = stack.back();
+            switch(term.kind){
+                case Term::ADD:
+                    left += right;
+                    break;
+                case Term::SUBTRACT:
+                    left -= right;
+                    break;
+                case Term::MULTIPLY:
+                    left *= right;
+                    break;
+                case Term::DIVIDE:
+                    left /= right;
+                    break;
+                default:
+                    left = std::pow(left, right);
+                    break;
+            }
+        }
+    }
+    return stack.back();
+}
+
+template<std_floating_point FloatingNumberType>
+typename Circuit<FloatingNumberType>::QASMParser::Argument Circuit<FloatingNumberType>::QASMParser::readArgument(const bool &classic) {
+    const std::string_view name = readIdentifier();
+    const auto &registers = classic ? classicRegisters : quantumRegisters;
+    const auto found = registers.find(name);
+    if(found == registers.end()){
+        fail("unknown " + std::string(classic ? "classic" : "quantum") + " register " + std::string(name));
+    }
+    const Register &reg = found->second;
+    if(!accept('[')){
+        return {reg.offset, reg.size};
+    }
+    const size_t index = readInteger();
+    expect(']');
+    if(index >= reg.size){
+        fail("index " + std::to_string(index) + " is out of the register " + std::string(name));
+    }
+    return {reg.offset + index, 1};
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType> Circuit<FloatingNumberType>::QASMParser::parse() {
+    skipSpace();
+    while(position < source.size()){
+        parseStatement();
+        skipSpace();
+    }
+    // The source is external data, so its gates are verified whatever the validation level
+    Circuit circuit(probabilityEngine, qubitCount, classicBitCount);
+    for(const auto &gate: gates){
+        gate->verify(&circuit);
+    }
+    *circuit.gates = std::move(gates);
+    return circuit;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::parseStatement() {
+    const std::string_view keyword = readIdentifier();
+    if(keyword == "OPENQASM"){
+        skipSpace();
+        const size_t versionBegin = position;
+        while(position < source.size() && source[position] != ';'){
+            position++;
+        }
+        if(source.substr(versionBegin, position - versionBegin).substr(0, 2) != "2."){
+            position = versionBegin;
+            fail("only OpenQASM 2 is supported");
+        }
+        expect(';');
+    } else if(keyword == "include"){
+        expect('"');
+        const size_t fileBegin = position;
+        while(position < source.size() && source[position] != '"'){
+            position++;
+        }
+        const std::string_view file = source.substr(fileBegin, position - fileBegin);
+        expect('"');
+        expect(';');
+        if(file != "qelib1.inc"){
+            fail("only qelib1.inc can be included, not " + std::string(file));
+        }
+    } else if(keyword == "qreg" || keyword == "creg"){
+        parseRegister(keyword == "creg");
+    } else if(keyword == "gate"){
+        parseDefinition();
+    } else if(keyword == "opaque"){
+        fail("opaque gates are not supported");
+    } else if(keyword == "if"){
+        expect('(');
+        const std::string_view name = readIdentifier();
+        const auto found = classicRegisters.find(name);
+        if(found == classicRegisters.end()){
+            fail("unknown classic register " + std::string(name));
+        }
+        expect('=');
+        expect('=');
+        const size_t value = readInteger();
+        expect(')');
+        // Gates are only controlled by classic bits being 1, so every bit of the register must be tested for 1
+        const Register &reg = found->second;
+        if(reg.size >= 64 || value != (size_t(1) << reg.size) - 1){
+            fail("conditions can only require every bit of a register to be 1");
+        }
+        std::vector<size_t> conditions(reg.size);
+        for(size_t i = 0; i < reg.size; i++){
+            conditions[i] = reg.offset + i;
+        }
+        parseOperation(readIdentifier(), conditions);
+    } else {
+        parseOperation(keyword, {});
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::parseRegister(const bool &classic) {
+    const std::string_view name = readIdentifier();
+    expect('[');
+    const size_t size = readInteger();
+    expect(']');
+    expect(';');
+    if(size == 0){
+        fail("the register " + std::string(name) + " is empty");
+    }
+    if(quantumRegisters.contains(name) || classicRegisters.contains(name)){
+        fail("the register " + std::string(name) + " is already declared");
+    }
+    // The registers are laid out one after the other
+    size_t &count = classic ? classicBitCount : qubitCount;
+    (classic ? classicRegisters : quantumRegisters).emplace(std::string(name), Register{count, size});
+    count += size;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::parseDefinition() {
+    const std::string_view name = readIdentifier();
+    if(definitions.contains(name)){
+        fail("the gate " + std::string(name) + " is already defined");
+    }
+    Definition gateDefinition;
+    gateDefinition.name = name;
+    const auto readNames = [this](std::vector<std::string> &names){
+        do {
+            const std::string_view identifier = readIdentifier();
+            if(std::find(names.begin(), names.end(), identifier) != names.end()){
+                fail(std::string(identifier) + " is declared twice");
+            }
+            names.emplace_back(identifier);
+        } while(accept(','));
+    };
+    if(accept('(') && !accept(')')){
+        readNames(gateDefinition.parameters);
+        expect(')');
+    }
+    readNames(gateDefinition.qubits);
+    expect('{');
+    // The body is parsed here, while the gate is not defined yet, so it can only apply the gates defined before it
+    definition = &gateDefinition;
+    while(!accept('}')){
+        if(position == source.size()){
+            fail("the body of the gate " + std::string(name) + " is not closed");
+        }
+        const size_t statementBegin = position;
+        const std::string_view operation = readIdentifier();
+        if(operation == "OPENQASM" || operation == "include" || operation == "qreg" || operation == "creg" ||
+           operation == "gate" || operation == "opaque" || operation == "measure" || operation == "reset" ||
+           operation == "if"){
+            position = statementBegin;
+            fail(std::string(operation) + " statements are not allowed in gate definitions");
+        }
+        Statement statement{};
+        if(operation != "barrier" && accept('(') && !accept(')')){
+            do {
+                readExpression(statement.parameters.emplace_back());
+            } while(accept(','));
+            expect(')');
+        }
+        // The qubits of a gate are used by name, without an index
+        do {
+            const std::string_view qubit = readIdentifier();
+            const auto found = std::find(gateDefinition.qubits.begin(), gateDefinition.qubits.end(), qubit);
+            if(found == gateDefinition.qubits.end()){
+                fail("unknown qubit " + std::string(qubit));
+            }
+            const auto index = static_cast<size_t>(found - gateDefinition.qubits.begin());
+            if(std::find(statement.qubits.begin(), statement.qubits.end(), index) != statement.qubits.end()){
+                fail("the qubit " + std::string(qubit) + " is used twice by " + std::string(operation));
+            }
+            statement.qubits.push_back(index);
+        } while(accept(','));
+        expect(';');
+        if(operation == "barrier"){
+            continue;
+        }
+        resolve(operation, statement.parameters.size(), statement.qubits.size(), statement.builtin, statement.definition);
+        if(statement.definition != nullptr){
+            gateDefinition.depth = std::max(gateDefinition.depth, statement.definition->depth + 1);
+            if(gateDefinition.depth > MAX_DEFINITION_DEPTH){
+                fail("the gate " + std::string(name) + " nests more than " + std::to_string(MAX_DEFINITION_DEPTH) +
+                     " gate definitions");
+            }
+        }
+        gateDefinition.body.push_back(std::move(statement));
+    }
+    definition = nullptr;
+    definitions.emplace(gateDefinition.name, std::move(gateDefinition));
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::parseMeasure(const std::vector<size_t> &conditions) {
+    const Argument qubits = readArgument(false);
+    expect('-');
+    expect('>');
+    const Argument classicBits = readArgument(true);
+    expect(';');
+    if(qubits.size != classicBits.size){
+        fail("the registers of a measurement have different sizes");
+    }
+    std::vector<std::pair<size_t, size_t>> qubitClassicBitPairs(qubits.size);
+    for(size_t i = 0; i < qubits.size; i++){
+        qubitClassicBitPairs[i] = {qubits.offset + i, classicBits.offset + i};
+    }
+    addGate(gates, std::make_unique<MeasureGate>(qubitClassicBitPairs), conditions);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::parseOperation(const std::string_view &name,
+                                                             const std::vector<size_t> &conditions) {
+    if(name == "measure"){
+        parseMeasure(conditions);
+        return;
+    }
+    std::vector<FloatingNumberType> parameters;
+    if(name != "reset" && name != "barrier" && accept('(') && !accept(')')){
+        do {
+            expression.clear();
+            readExpression(expression);
+            parameters.push_back(evaluate(expression, {}));
+        } while(accept(','));
+        expect(')');
+    }
+    std::vector<Argument> arguments;
+    do {
+        arguments.push_back(readArgument(false));
+    } while(accept(','));
+    expect(';');
+    if(name == "barrier"){
+        return;
+    }
+    const Builtin *builtin = nullptr;
+    Definition *gateDefinition = nullptr;
+    if(name != "reset"){
+        resolve(name, parameters.size(), arguments.size(), builtin, gateDefinition);
+    } else if(arguments.size() != 1){
+        fail("reset acts on a single qubit");
+    }
+    // Whole registers are broadcast over, one operation for every qubit
+    size_t width = 1;
+    for(const auto &argument: arguments){
+        if(argument.size != 1){
+            if(width != 1 && width != argument.size){
+                fail("the registers of an operation have different sizes");
+            }
+            width = argument.size;
+        }
+    }
+    std::vector<size_t> qubits(arguments.size());
+    for(size_t i = 0; i < width; i++){
+        for(size_t j = 0; j < arguments.size(); j++){
+            qubits[j] = arguments[j].offset + (arguments[j].size == 1 ? 0 : i);
+        }
+        if(name == "reset"){
+            addGate(gates, std::make_unique<InitGate>(qubits[0], typename Qubit<FloatingNumberType>::State(
+                    probabilityEngine, FloatingNumberType(1), FloatingNumberType(0))), conditions);
+        } else {
+            addOperation(gates, builtin, gateDefinition, parameters, qubits, conditions);
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+const typename Circuit<FloatingNumberType>::QASMParser::Builtin *
+Circuit<FloatingNumberType>::QASMParser::findBuiltin(const std::string_view &name) {
+    static constexpr Builtin builtins[] = {
+            {"U", U3, 3, 1}, {"u3", U3, 3, 1}, {"u", U3, 3, 1}, {"u2", U2, 2, 1}, {"u1", U1, 1, 1}, {"p", U1, 1, 1},
+            {"rx", RX, 1, 1}, {"ry", RY, 1, 1}, {"rz", RZ, 1, 1}, {"sx", SX, 0, 1}, {"sxdg", SXDG, 0, 1},
+            {"x", X, 0, 1}, {"y", Y, 0, 1}, {"z", Z, 0, 1}, {"h", H, 0, 1}, {"s", S, 0, 1}, {"sdg", SDG, 0, 1},
+            {"t", T, 0, 1}, {"tdg", TDG, 0, 1}, {"id", ID, 0, 1}, {"u0", ID, 1, 1}, {"CX", CX, 0, 2},
+            {"cx", CX, 0, 2}, {"cy", CY, 0, 2}, {"cz", CZ, 0, 2}, {"ch", CH, 0, 2}, {"swap", SWAP, 0, 2},
+            {"cu1", CU1, 1, 2}, {"cp", CU1, 1, 2}, {"crz", CRZ, 1, 2}, {"crx", CRX, 1, 2}, {"cry", CRY, 1, 2},
+            {"cu3", CU3, 3, 2}, {"ccx", CCX, 0, 3}, {"cswap", CSWAP, 0, 3}
+    };
+    const Builtin *builtin = std::find_if(std::begin(builtins), std::end(builtins), [&name](const Builtin &candidate){
+        return candidate.name == name;
+    });
+    return builtin == std::end(builtins) ? nullptr : builtin;
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::resolve(const std::string_view &name, const size_t &parameterCount,
+                                                      const size_t &qubitCount, const Builtin *&builtin,
+                                                      Definition *&gateDefinition) {
+    builtin = nullptr;
+    gateDefinition = nullptr;
+    size_t expectedParameterCount;
+    size_t expectedQubitCount;
+    // The gates defined in the source take precedence over the gates of qelib1.inc
+    const auto found = definitions.find(name);
+    if(found != definitions.end()){
+        gateDefinition = &found->second;
+        expectedParameterCount = gateDefinition->parameters.size();
+        expectedQubitCount = gateDefinition->qubits.size();
+    } else {
+        builtin = findBuiltin(name);
+        if(builtin == nullptr){
+            fail("unknown gate " + std::string(name));
+        }
+        expectedParameterCount = builtin->parameterCount;
+        expectedQubitCount = builtin->qubitCount;
+    }
+    if(parameterCount != expectedParameterCount || qubitCount != expectedQubitCount){
+        fail("the gate " + std::string(name) + " takes " + std::to_string(expectedParameterCount) + " parameters and " +
+             std::to_string(expectedQubitCount) + " qubits");
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::addGate(GateList &target, std::unique_ptr<Gate> gate,
+                                                      const std::vector<size_t> &conditions) {
+    for(auto condition = conditions.rbegin(); condition != conditions.rend(); condition++){
+        gate = std::make_unique<CustomControlledGate>(*condition, std::move(gate), true);
+    }
+    target.emplace_back(std::move(gate));
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::QASMParser::addOperation(GateList &target, const Builtin *builtin,
+                                                           Definition *gateDefinition,
+                                                           const std::vector<FloatingNumberType> &parameters,
+                                                           const std::vector<size_t> &qubits,
+                                                           const std::vector<size_t> &conditions) {
+    if(gateDefinition != nullptr){
+        auto gate = std::make_unique<CircuitGate>(expand(*gateDefinition, parameters), qubits);
+        gate->name = gateDefinition->name;
+        addGate(target, std::move(gate), conditions);
+        return;
+    }
+    // The gates of qelib1.inc, as single-qubit fused gates when the library has no equivalent gate
+    constexpr FloatingNumberType pi = std::numbers::pi_v<FloatingNumberType>;
+    // u3(θ, φ, λ) = [[cos(θ/2), -e^(iλ) sin(θ/2)], [e^(iφ) sin(θ/2), e^(i(φ+λ)) cos(θ/2)]]
+    const auto makeU3 = [](const size_t &qubitIndex, const FloatingNumberType &theta, const FloatingNumberType &phi,
+                           const FloatingNumberType &lambda){
+        const FloatingNumberType cosine = std::cos(theta / 2);
+        const FloatingNumberType sine = std::sin(theta / 2);
+        return std::make_unique<FusedGate>(std::vector<size_t>{qubitIndex}, std::vector<typename FusedGate::Amplitude>{
+                cosine, -std::polar(sine, lambda), std::polar(sine, phi), std::polar(cosine, phi + lambda)});
+    };
+    const auto makeControlled = [](const size_t &controlIndex, std::unique_ptr<Gate> gate){
+        return std::make_unique<CustomControlledGate>(controlIndex, std::move(gate));
+    };
+    switch(builtin->operation){
+        case U3:
+            return addGate(target, makeU3(qubits[0], parameters[0], parameters[1], parameters[2]), conditions);
+        case U2:
+            return addGate(target, makeU3(qubits[0], pi / 2, parameters[0], parameters[1]), conditions);
+        case RX:
+            return addGate(target, makeU3(qubits[0], parameters[0], -pi / 2, pi / 2), conditions);
+        case RY:
+            return addGate(target, makeU3(qubits[0], parameters[0], 0, 0), conditions);
+        case SX:
+            return addGate(target, makeU3(qubits[0], pi / 2, -pi / 2, pi / 2), conditions);
+        case SXDG:
+            return addGate(target, makeU3(qubits[0], -pi / 2, -pi / 2, pi / 2), conditions);
+        case U1:
+        case RZ:
+            return addGate(target, std::make_unique<PhaseGate>(qubits[0], parameters[0]), conditions);
+        case S:
+            return addGate(target, std::make_unique<PhaseGate>(qubits[0], pi / 2), conditions);
+        case SDG:
+            return addGate(target, std::make_unique<PhaseGate>(qubits[0], -pi / 2), conditions);
+        case T:
+            return addGate(target, std::make_unique<PhaseGate>(qubits[0], pi / 4), conditions);
+        case TDG:
+            return addGate(target, std::make_unique<PhaseGate>(qubits[0], -pi / 4), conditions);
+        case X:
+            return addGate(target, std::make_unique<XGate>(qubits[0]), conditions);
+        case Y:
+            return addGate(target, std::make_unique<YGate>(qubits[0]), conditions);
+        case Z:
+            return addGate(target, std::make_unique<ZGate>(qubits[0]), conditions);
+        case H:
+            return addGate(target, std::make_unique<HadamardGate>(qubits[0]), conditions);
+        case ID:
+            return;
+        case CX:
+            return addGate(target, std::make_unique<CXGate>(qubits[0], qubits[1]), conditions);
+        case CY:
+            return addGate(target, std::make_unique<CYGate>(qubits[0], qubits[1]), conditions);
+        case CZ:
+            return addGate(target, std::make_unique<CZGate>(qubits[0], qubits[1]), conditions);
+        case CH:
+            return addGate(target, std::make_unique<ControlledHadamardGate>(qubits[0], qubits[1]), conditions);
+        case SWAP:
+            return addGate(target, std::make_unique<SwapGate>(qubits[0], qubits[1]), conditions);
+        case CU1:
+            return addGate(target, std::make_unique<ControlledPhaseGate>(qubits[0], qubits[1], parameters[0]),
+                           conditions);
+        case CRZ:
+            // crz(λ) applies diag(e^(-iλ/2), e^(iλ/2)), which is a controlled phase of λ and a phase of -λ/2 on the control
+            addGate(target, std::make_unique<ControlledPhaseGate>(qubits[0], qubits[1], parameters[0]), conditions);
+            return addGate(target, std::make_unique<PhaseGate>(qubits[0], -parameters[0] / 2), conditions);
+        case CRX:
+            return addGate(target, makeControlled(qubits[0], makeU3(qubits[1], parameters[0], -pi / 2, pi / 2)),
+                           conditions);
+        case CRY:
+            return addGate(target, makeControlled(qubits[0], makeU3(qubits[1], parameters[0], 0, 0)), conditions);
+        case CU3:
+            return addGate(target, makeControlled(qubits[0], makeU3(qubits[1], parameters[0], parameters[1],
+                                                                    parameters[2])), conditions);
+        case CCX:
+            return addGate(target, makeControlled(qubits[0], std::make_unique<CXGate>(qubits[1], qubits[2])),
+                           conditions);
+        case CSWAP:
+            return addGate(target, makeControlled(qubits[0], std::make_unique<SwapGate>(qubits[1], qubits[2])),
+                           conditions);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+std::shared_ptr<Circuit<FloatingNumberType>> Circuit<FloatingNumberType>::QASMParser::expand(
+        Definition &gateDefinition, const std::vector<FloatingNumberType> &parameters) {
+    // Every use of a gate with the same parameter values shares its sub-circuit
+    const auto found = gateDefinition.expansions.find(parameters);
+    if(found != gateDefinition.expansions.end()){
+        return found->second;
+    }
+    // The body was parsed with the definition, so only its parameters are evaluated here
+    GateList body;
+    std::vector<FloatingNumberType> values;
+    for(const Statement &statement: gateDefinition.body){
+        values.resize(statement.parameters.size());
+        for(size_t i = 0; i < values.size(); i++){
+            values[i] = evaluate(statement.parameters[i], parameters);
+        }
+        addOperation(body, statement.builtin, statement.definition, values, statement.qubits, {});
+    }
+    auto circuit = std::make_shared<Circuit>(probabilityEngine, gateDefinition.qubits.size());
+    for(const auto &gate: body){
+        gate->verify(circuit.get());
+    }
+    *circuit->gates = std::move(body);
+    gateDefinition.expansions.emplace(parameters, circuit);
+    return circuit;
+}
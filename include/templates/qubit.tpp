@@ -1,8 +1,10 @@
 template<std_floating_point FloatingNumberType>
 void Qubit<FloatingNumberType>::State::assertValid() const {
-    const std::complex<FloatingNumberType> total = norm(alpha) + norm(beta);
-    if (!probabilityEngine->template compare<std::complex<FloatingNumberType>>(total, 1.0)) {
-        throw Qubit<FloatingNumberType>::State::InvalidStateException(*this);
+    if constexpr (VALIDATION_ENABLED) {
+        const std::complex<FloatingNumberType> total = norm(alpha) + norm(beta);
+        if (!probabilityEngine->template compare<std::complex<FloatingNumberType>>(total, 1.0)) {
+            throw Qubit<FloatingNumberType>::State::InvalidStateException(*this);
+        }
     }
 }
 
@@ -0,0 +1,356 @@
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::CircuitFormatException::CircuitFormatException(const std::string &reason):
+        std::runtime_error("Invalid circuit data: " + reason) {}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Encoder::writeWord(const size_t &word) {
+    if(word > std::numeric_limits<std::uint32_t>::max()){
+        throw CircuitFormatException("the value " + std::to_string(word) + " does not fit in 32 bits");
+    }
+    words->push_back(static_cast<std::uint32_t>(word));
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Encoder::writeFloat(const FloatingNumberType &value) {
+    const auto bits = std::bit_cast<std::uint64_t>(static_cast<double>(value));
+    words->push_back(static_cast<std::uint32_t>(bits));
+    words->push_back(static_cast<std::uint32_t>(bits >> 32));
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Encoder::writeComplex(const std::complex<FloatingNumberType> &value) {
+    writeFloat(value.real());
+    writeFloat(value.imag());
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Encoder::writeAngle(const Angle<FloatingNumberType> &angle) {
+    if(angle.isParametric()){
+        if(angle.getParameter() >= std::numeric_limits<std::uint32_t>::max()){
+            throw CircuitFormatException("the parameter " + std::to_string(angle.getParameter()) + " does not fit in 32 bits");
+        }
+        writeWord(angle.getParameter());
+    } else {
+        words->push_back(std::numeric_limits<std::uint32_t>::max());
+    }
+    writeFloat(angle.getCoefficient());
+    writeFloat(angle.getOffset());
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Encoder::writeString(const std::string &string) {
+    writeWord(string.size());
+    const size_t firstWord = words->size();
+    words->resize(firstWord + (string.size() + 3) / 4, 0);
+    for(size_t i = 0; i < string.size(); i++){
+        (*words)[firstWord + i / 4] |= std::uint32_t(static_cast<unsigned char>(string[i])) << (8 * (i % 4));
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Encoder::writeGate(const Gate &gate) {
+    gate.encode(*this);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Encoder::writeCircuit(const Circuit &circuit) {
+    writeWord(encodeCircuit(circuit));
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::Encoder::encodeCircuit(const Circuit &circuit) {
+    // Circuits sharing their gates are the same sub-circuit, written once
+    const auto key = std::make_tuple(circuit.gates.get(), circuit.getQubitCount(), circuit.getClassicBitCount());
+    const auto found = circuitIndices.find(key);
+    if(found != circuitIndices.end()){
+        return found->second;
+    }
+    std::vector<std::uint32_t> circuitWords;
+    std::vector<std::uint32_t> *parentWords = std::exchange(words, &circuitWords);
+    writeWord(circuit.getQubitCount());
+    writeWord(circuit.getClassicBitCount());
+    writeWord(circuit.gates->size());
+    for(const auto &gate: *circuit.gates){
+        gate->encode(*this);
+    }
+    words = parentWords;
+    // The sub-circuits were added while encoding the gates, so they come before the circuit
+    circuits.emplace_back(std::move(circuitWords));
+    circuitIndices.emplace(key, circuits.size() - 1);
+    return circuits.size() - 1;
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType>::Decoder::Decoder(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                              std::span<const std::byte> data):
+        probabilityEngine(std::move(probabilityEngine)),
+        data(data) {}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::Decoder::require(const size_t &wordCount) const {
+    if(wordCount > data.size() / 4 - position){
+        throw CircuitFormatException("the data ends in the middle of a circuit");
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::Decoder::readWord() {
+    require(1);
+    std::uint32_t word;
+    std::memcpy(&word, data.data() + 4 * position, 4);
+    position++;
+    if constexpr (std::endian::native == std::endian::big) {
+        word = (word >> 24) | ((word >> 8) & 0xFF00) | ((word << 8) & 0xFF0000) | (word << 24);
+    }
+    return word;
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType Circuit<FloatingNumberType>::Decoder::readFloat() {
+    const std::uint64_t low = readWord();
+    const std::uint64_t high = readWord();
+    return static_cast<FloatingNumberType>(std::bit_cast<double>(high << 32 | low));
+}
+
+template<std_floating_point FloatingNumberType>
+std::complex<FloatingNumberType> Circuit<FloatingNumberType>::Decoder::readComplex() {
+    const FloatingNumberType real = readFloat();
+    const FloatingNumberType imaginary = readFloat();
+    return {real, imaginary};
+}
+
+template<std_floating_point FloatingNumberType>
+Angle<FloatingNumberType> Circuit<FloatingNumberType>::Decoder::readAngle() {
+    const size_t parameter = readWord();
+    const FloatingNumberType coefficient = readFloat();
+    const FloatingNumberType offset = readFloat();
+    if(parameter == std::numeric_limits<std::uint32_t>::max()){
+        return offset;
+    }
+    return Angle<FloatingNumberType>::Parameter(parameter) * coefficient + offset;
+}
+
+template<std_floating_point FloatingNumberType>
+std::string Circuit<FloatingNumberType>::Decoder::readString() {
+    const size_t length = readWord();
+    require((length + 3) / 4);
+    std::string string(reinterpret_cast<const char *>(data.data() + 4 * position), length);
+    position += (length + 3) / 4;
+    return string;
+}
+
+template<std_floating_point FloatingNumberType>
+std::shared_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumberType>::Decoder::readGate() {
+    const size_t code = readWord();
+    switch(code){
+        case Encoder::HADAMARD:
+            return std::make_shared<HadamardGate>(readWord());
+        case Encoder::X:
+            return std::make_shared<XGate>(readWord());
+        case Encoder::Y:
+            return std::make_shared<YGate>(readWord());
+        case Encoder::Z:
+            return std::make_shared<ZGate>(readWord());
+        case Encoder::CONTROLLED_HADAMARD:
+        case Encoder::CX:
+        case Encoder::CY:
+        case Encoder::CZ: {
+            const size_t controlIndex = readWord();
+            const size_t targetIndex = readWord();
+            switch(code){
+                case Encoder::CONTROLLED_HADAMARD:
+                    return std::make_shared<ControlledHadamardGate>(controlIndex, targetIndex);
+                case Encoder::CX:
+                    return std::make_shared<CXGate>(controlIndex, targetIndex);
+                case Encoder::CY:
+                    return std::make_shared<CYGate>(controlIndex, targetIndex);
+                default:
+                    return std::make_shared<CZGate>(controlIndex, targetIndex);
+            }
+        }
+        case Encoder::PHASE: {
+            const size_t qubitIndex = readWord();
+            return std::make_shared<PhaseGate>(qubitIndex, readAngle());
+        }
+        case Encoder::CONTROLLED_PHASE: {
+            const size_t controlIndex = readWord();
+            const size_t targetIndex = readWord();
+            return std::make_shared<ControlledPhaseGate>(controlIndex, targetIndex, readAngle());
+        }
+        case Encoder::SWAP: {
+            const size_t qubitIndex1 = readWord();
+            const size_t qubitIndex2 = readWord();
+            return std::make_shared<SwapGate>(qubitIndex1, qubitIndex2);
+        }
+        case Encoder::MEASURE: {
+            const size_t pairCount = readWord();
+            require(2 * pairCount);
+            std::vector<std::pair<size_t, size_t>> qubitClassicBitPairs(pairCount);
+            for(auto &[qubitIndex, classicBitIndex]: qubitClassicBitPairs){
+                qubitIndex = readWord();
+                classicBitIndex = readWord();
+            }
+            return std::make_shared<MeasureGate>(qubitClassicBitPairs);
+        }
+        case Encoder::INIT: {
+            const size_t qubitIndex = readWord();
+            const std::complex<FloatingNumberType> alpha = readComplex();
+            const std::complex<FloatingNumberType> beta = readComplex();
+            return std::make_shared<InitGate>(qubitIndex, typename Qubit<FloatingNumberType>::State(probabilityEngine, alpha, beta));
+        }
+        case Encoder::CIRCUIT: {
+            const size_t circuitIndex = readWord();
+            if(circuitIndex >= circuits.size()){
+                throw CircuitFormatException("a CircuitGate refers to the circuit " + std::to_string(circuitIndex) +
+                                             ", which is not defined before it");
+            }
+            auto gate = std::make_shared<CircuitGate>(circuits[circuitIndex]);
+            gate->name = readString();
+            const size_t qubitCount = readWord();
+            require(qubitCount);
+            std::vector<size_t> qubitIndices(qubitCount);
+            for(auto &qubitIndex: qubitIndices){
+                qubitIndex = readWord();
+            }
+            gate->setQubitIndices(qubitIndices);
+            return gate;
+        }
+        case Encoder::CUSTOM_CONTROLLED: {
+            const size_t controlIndex = readWord();
+            const bool classic = readWord() != 0;
+            if(depth == FORMAT_MAX_NESTING_DEPTH){
+                throw CircuitFormatException("the controlled gates are nested more than " +
+                                             std::to_string(FORMAT_MAX_NESTING_DEPTH) + " times");
+            }
+            depth++;
+            // Gates are read into shared pointers, as they are stored in the circuits, so the controlled one is cloned
+            auto gate = std::make_shared<CustomControlledGate>(controlIndex, readGate()->clone(), classic);
+            depth--;
+            return gate;
+        }
+        case Encoder::FUSED:
+        case Encoder::PERMUTATION: {
+            const size_t qubitCount = readWord();
+            // Wider gates could not be allocated anyway, and are rejected before their size overflows
+            if(qubitCount > 16){
+                throw CircuitFormatException("a gate acts on " + std::to_string(qubitCount) + " qubits");
+            }
+            require(qubitCount);
+            std::vector<size_t> qubitIndices(qubitCount);
+            for(auto &qubitIndex: qubitIndices){
+                qubitIndex = readWord();
+            }
+            const size_t dimension = size_t(1) << qubitCount;
+            if(code == Encoder::PERMUTATION){
+                require(dimension);
+                std::vector<size_t> table(dimension);
+                for(auto &image: table){
+                    image = readWord();
+                }
+                return std::make_shared<PermutationGate>(qubitIndices, table);
+            }
+            require(4 * dimension * dimension);
+            std::vector<typename FusedGate::Amplitude> matrix(dimension * dimension);
+            for(auto &amplitude: matrix){
+                amplitude = readComplex();
+            }
+            return std::make_shared<FusedGate>(qubitIndices, matrix);
+        }
+        default:
+            throw CircuitFormatException("unknown gate code " + std::to_string(code));
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::save(std::ostream &stream) const {
+    Encoder encoder;
+    encoder.encodeCircuit(*this);
+    std::vector<std::uint32_t> header = {FORMAT_MAGIC, FORMAT_VERSION};
+    encoder.words = &header;
+    encoder.writeWord(encoder.circuits.size());
+    std::vector<std::uint32_t> parameters;
+    encoder.words = &parameters;
+    encoder.writeWord(parameterValues.size());
+    for(const auto &value: parameterValues){
+        encoder.writeFloat(value);
+    }
+    const auto writeWords = [&stream](std::vector<std::uint32_t> &words){
+        if constexpr (std::endian::native == std::endian::big) {
+            for(auto &word: words){
+                word = (word >> 24) | ((word >> 8) & 0xFF00) | ((word << 8) & 0xFF0000) | (word << 24);
+            }
+        }
+        stream.write(reinterpret_cast<const char *>(words.data()), static_cast<std::streamsize>(4 * words.size()));
+    };
+    writeWords(header);
+    for(auto &circuitWords: encoder.circuits){
+        writeWords(circuitWords);
+    }
+    writeWords(parameters);
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType> Circuit<FloatingNumberType>::load(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                                              std::span<const std::byte> data) {
+    Decoder decoder(probabilityEngine, data);
+    if(decoder.readWord() != FORMAT_MAGIC){
+        throw CircuitFormatException("the data does not start with the magic number of a circuit");
+    }
+    const size_t version = decoder.readWord();
+    if(version != FORMAT_VERSION){
+        throw CircuitFormatException("version " + std::to_string(version) + " is not supported");
+    }
+    const size_t circuitCount = decoder.readWord();
+    if(circuitCount == 0){
+        throw CircuitFormatException("the data holds no circuit");
+    }
+    // Every circuit takes at least its three counts
+    decoder.require(3 * circuitCount);
+    decoder.circuits.reserve(circuitCount);
+    size_t bitCount = 0;
+    for(size_t i = 0; i < circuitCount; i++){
+        const size_t qubitCount = decoder.readWord();
+        const size_t classicBitCount = decoder.readWord();
+        const size_t gateCount = decoder.readWord();
+        // Every circuit is kept until the end, so their registers are bounded together, and the rest of the circuits
+        // must still fit in the data
+        bitCount += qubitCount + classicBitCount;
+        if(bitCount > FORMAT_MAX_BIT_COUNT){
+            throw CircuitFormatException("the circuits have more than " + std::to_string(FORMAT_MAX_BIT_COUNT) +
+                                         " qubits and classic bits");
+        }
+        decoder.require(gateCount + 3 * (circuitCount - i - 1));
+        auto circuit = std::make_shared<Circuit>(probabilityEngine, qubitCount, classicBitCount);
+        GateList &gates = *circuit->gates;
+        gates.reserve(gateCount);
+        for(size_t j = 0; j < gateCount; j++){
+            // The data is external, so its gates are verified whatever the validation level
+            auto gate = decoder.readGate();
+            gate->verify(circuit.get());
+            gates.emplace_back(std::move(gate));
+        }
+        decoder.circuits.emplace_back(std::move(circuit));
+    }
+    Circuit circuit(*decoder.circuits.back());
+    const size_t parameterCount = decoder.readWord();
+    decoder.require(2 * parameterCount);
+    circuit.parameterValues.resize(parameterCount);
+    for(auto &value: circuit.parameterValues){
+        value = decoder.readFloat();
+    }
+    return circuit;
+}
+
+template<std_floating_point FloatingNumberType>
+Circuit<FloatingNumberType> Circuit<FloatingNumberType>::load(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                                              std::istream &stream) {
+    std::vector<std::byte> data;
+    constexpr size_t chunkSize = 1 << 16;
+    while(stream){
+        const size_t size = data.size();
+        data.resize(size + chunkSize);
+        stream.read(reinterpret_cast<char *>(data.data() + size), chunkSize);
+        data.resize(size + static_cast<size_t>(stream.gcount()));
+    }
+    return load(std::move(probabilityEngine), data);
+}
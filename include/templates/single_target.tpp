@@ -10,7 +10,17 @@ Circuit<FloatingNumberType>::SingleTargetGate::SingleTargetGate(const size_t &ta
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::SingleTargetGate::verify(const Circuit *circuit) const {
-    if(qubitIndex >= circuit->qubits.size()){
+    if(qubitIndex >= circuit->getQubitCount()){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(qubitIndex);
     }
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::SingleTargetGate::getQubitIndices() const {
+    return {qubitIndex};
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::SingleTargetGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    qubitIndex = qubitMap[qubitIndex];
+}
@@ -0,0 +1,460 @@
+template<std_floating_point FloatingNumberType>
+SparseStateVector<FloatingNumberType>::RegisterTooLargeException::RegisterTooLargeException(const size_t &qubitCount):
+        std::runtime_error("Cannot key the basis states of a sparse state vector of " + std::to_string(qubitCount) + " qubits"),
+        qubitCount(qubitCount) {}
+
+template<std_floating_point FloatingNumberType>
+SparseStateVector<FloatingNumberType>::SparseStateVector(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                                         const size_t &qubitCount):
+        probabilityEngine(probabilityEngine),
+        qubitCount(qubitCount),
+        dense(probabilityEngine, qubitCount) {}
+
+template<std_floating_point FloatingNumberType>
+size_t SparseStateVector<FloatingNumberType>::hashKey(const size_t &key) {
+    std::uint64_t hash = key;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+    return hash ^ (hash >> 31);
+}
+
+template<std_floating_point FloatingNumberType>
+size_t SparseStateVector<FloatingNumberType>::findSlot(const std::vector<size_t> &keys_, const size_t &key) {
+    const size_t mask = keys_.size() - 1;
+    for(size_t slot = hashKey(key) & mask;; slot = (slot + 1) & mask){
+        if(keys_[slot] == key || keys_[slot] == FREE_SLOT){
+            return slot;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::clearTable(std::vector<size_t> &keys_, std::vector<Amplitude> &values_,
+                                                       const size_t &size) {
+    // Free slots ignore their values, so only the keys are cleared
+    keys_.resize(size);
+    values_.resize(size);
+    std::fill(keys_.begin(), keys_.end(), FREE_SLOT);
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::accumulate(const size_t &key, const Amplitude &value) {
+    // Keep the load factor under 1/2
+    if(2 * (nextEntryCount + 1) > nextKeys.size()){
+        std::vector<size_t> oldKeys(std::max(2 * nextKeys.size(), INITIAL_CAPACITY), FREE_SLOT);
+        std::vector<Amplitude> oldValues(oldKeys.size());
+        std::swap(oldKeys, nextKeys);
+        std::swap(oldValues, nextValues);
+        for(size_t slot = 0; slot < oldKeys.size(); slot++){
+            if(oldKeys[slot] != FREE_SLOT){
+                const size_t newSlot = findSlot(nextKeys, oldKeys[slot]);
+                nextKeys[newSlot] = oldKeys[slot];
+                nextValues[newSlot] = oldValues[slot];
+            }
+        }
+    }
+    const size_t slot = findSlot(nextKeys, key);
+    if(nextKeys[slot] == FREE_SLOT){
+        nextKeys[slot] = key;
+        nextValues[slot] = value;
+        nextEntryCount++;
+    } else {
+        nextValues[slot] += value;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+template<class Transform>
+void SparseStateVector<FloatingNumberType>::transform(const Transform &transform_) {
+    // Sized for the entries to double, as under a Hadamard gate, so that the table shrinks after a collapse
+    clearTable(nextKeys, nextValues, std::bit_ceil(std::max(4 * entryCount, INITIAL_CAPACITY)));
+    nextEntryCount = 0;
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] != FREE_SLOT){
+            transform_(keys[slot], values[slot]);
+        }
+    }
+    std::swap(keys, nextKeys);
+    std::swap(values, nextValues);
+    entryCount = nextEntryCount;
+    prune();
+    checkFill();
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::prune() {
+    size_t prunedCount = 0;
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] != FREE_SLOT && std::norm(values[slot]) <= sparsity.pruningThreshold){
+            prunedCount++;
+        }
+    }
+    if(prunedCount == 0){
+        return;
+    }
+    // Removing entries would break the probe sequences, so the kept ones are inserted again
+    clearTable(nextKeys, nextValues, keys.size());
+    nextEntryCount = 0;
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] != FREE_SLOT && std::norm(values[slot]) > sparsity.pruningThreshold){
+            accumulate(keys[slot], values[slot]);
+        }
+    }
+    std::swap(keys, nextKeys);
+    std::swap(values, nextValues);
+    entryCount = nextEntryCount;
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::checkFill() {
+    if(sparsity.denseFillRatio <= 0 || FloatingNumberType(entryCount) <= std::ldexp(sparsity.denseFillRatio, int(qubitCount))){
+        return;
+    }
+    denseAmplitudes.assign(size_t(1) << qubitCount, Amplitude(0));
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] != FREE_SLOT){
+            denseAmplitudes[keys[slot]] = values[slot];
+        }
+    }
+    dense.swapAmplitudes(denseAmplitudes);
+    denseLayout = true;
+    // The tables keep their buffers for the next reset
+    keys.clear();
+    values.clear();
+    entryCount = 0;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t SparseStateVector<FloatingNumberType>::gatherBits(const size_t &key, std::span<const size_t> qubits) {
+    size_t local = 0;
+    for(size_t i = 0; i < qubits.size(); i++){
+        local |= ((key >> qubits[i]) & 1) << i;
+    }
+    return local;
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::reset() {
+    if(qubitCount >= std::numeric_limits<size_t>::digits){
+        throw RegisterTooLargeException(qubitCount);
+    }
+    if(denseLayout){
+        // The amplitudes go back to the buffer, to be reused if the register becomes dense again
+        dense.swapAmplitudes(denseAmplitudes);
+        denseLayout = false;
+    }
+    clearTable(keys, values, INITIAL_CAPACITY);
+    const size_t slot = findSlot(keys, 0);
+    keys[slot] = 0;
+    values[slot] = 1;
+    entryCount = 1;
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::resize(const size_t &qubitCount) {
+    this->qubitCount = qubitCount;
+    keys.clear();
+    values.clear();
+    nextKeys.clear();
+    nextValues.clear();
+    entryCount = 0;
+    dense.resize(qubitCount);
+    denseLayout = false;
+}
+
+template<std_floating_point FloatingNumberType>
+bool SparseStateVector<FloatingNumberType>::isInitialized() const {
+    return denseLayout || !keys.empty();
+}
+
+template<std_floating_point FloatingNumberType>
+size_t SparseStateVector<FloatingNumberType>::getQubitCount() const {
+    return qubitCount;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::shared_ptr<ProbabilityEngine<FloatingNumberType>> &SparseStateVector<FloatingNumberType>::getProbabilityEngine() const {
+    return probabilityEngine;
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::setSparsity(const Sparsity &sparsity_) {
+    sparsity = sparsity_;
+}
+
+template<std_floating_point FloatingNumberType>
+const typename SparseStateVector<FloatingNumberType>::Sparsity &SparseStateVector<FloatingNumberType>::getSparsity() const {
+    return sparsity;
+}
+
+template<std_floating_point FloatingNumberType>
+bool SparseStateVector<FloatingNumberType>::isDense() const {
+    return denseLayout;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t SparseStateVector<FloatingNumberType>::getEntryCount() const {
+    return denseLayout ? dense.getAmplitudes().size() : entryCount;
+}
+
+template<std_floating_point FloatingNumberType>
+typename SparseStateVector<FloatingNumberType>::Amplitude SparseStateVector<FloatingNumberType>::getAmplitude(const size_t &basisState) const {
+    if(denseLayout){
+        return dense.getAmplitudes()[basisState];
+    }
+    const size_t slot = findSlot(keys, basisState);
+    return keys[slot] == FREE_SLOT ? Amplitude(0) : values[slot];
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::applyMatrix(const size_t &target, const Matrix &matrix,
+                                                        const size_t &controlMask) {
+    if(denseLayout){
+        dense.applyMatrix(target, matrix, controlMask);
+        return;
+    }
+    const size_t targetBit = size_t(1) << target;
+    transform([&](const size_t &key, const Amplitude &value){
+        if((key & controlMask) != controlMask){
+            accumulate(key, value);
+            return;
+        }
+        // The entry is the column of the matrix given by the target bit, and its images the rows
+        const size_t column = (key & targetBit) != 0 ? 1 : 0;
+        if(matrix[column] != Amplitude(0)){
+            accumulate(key & ~targetBit, matrix[column] * value);
+        }
+        if(matrix[2 + column] != Amplitude(0)){
+            accumulate(key | targetBit, matrix[2 + column] * value);
+        }
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::applyUnitary(std::span<const size_t> targets,
+                                                         std::span<const Amplitude> matrix,
+                                                         const size_t &controlMask) {
+    if(denseLayout){
+        dense.applyUnitary(targets, matrix, controlMask);
+        return;
+    }
+    const size_t dimension = size_t(1) << targets.size();
+    // The bits of each basis state of the targets in a basis state of the register
+    std::vector<size_t> offsets(dimension, 0);
+    for(size_t state = 0; state < dimension; state++){
+        for(size_t i = 0; i < targets.size(); i++){
+            offsets[state] |= ((state >> i) & 1) << targets[i];
+        }
+    }
+    transform([&](const size_t &key, const Amplitude &value){
+        if((key & controlMask) != controlMask){
+            accumulate(key, value);
+            return;
+        }
+        const size_t column = gatherBits(key, targets);
+        const size_t base = key & ~offsets.back();
+        for(size_t row = 0; row < dimension; row++){
+            const Amplitude &element = matrix[row * dimension + column];
+            if(element != Amplitude(0)){
+                accumulate(base | offsets[row], element * value);
+            }
+        }
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::applyPermutation(std::span<const size_t> targets,
+                                                             std::span<const size_t> table,
+                                                             const size_t &controlMask) {
+    if(denseLayout){
+        dense.applyPermutation(targets, table, controlMask);
+        return;
+    }
+    std::vector<size_t> offsets(table.size(), 0);
+    for(size_t state = 0; state < table.size(); state++){
+        for(size_t i = 0; i < targets.size(); i++){
+            offsets[state] |= ((state >> i) & 1) << targets[i];
+        }
+    }
+    transform([&](const size_t &key, const Amplitude &value){
+        if((key & controlMask) != controlMask){
+            accumulate(key, value);
+            return;
+        }
+        accumulate((key & ~offsets.back()) | offsets[table[gatherBits(key, targets)]], value);
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::applyX(const size_t &target, const size_t &controlMask) {
+    if(denseLayout){
+        dense.applyX(target, controlMask);
+        return;
+    }
+    const size_t targetBit = size_t(1) << target;
+    transform([&](const size_t &key, const Amplitude &value){
+        accumulate((key & controlMask) == controlMask ? key ^ targetBit : key, value);
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::applyPhase(const size_t &target, const Amplitude &phase,
+                                                       const size_t &controlMask) {
+    if(denseLayout){
+        dense.applyPhase(target, phase, controlMask);
+        return;
+    }
+    // Phases do not move the entries, so they are applied in place
+    const size_t mask = controlMask | (size_t(1) << target);
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] != FREE_SLOT && (keys[slot] & mask) == mask){
+            values[slot] *= phase;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::applyDiagonal(const size_t &lowestQubit, std::span<const Amplitude> phases) {
+    if(denseLayout){
+        dense.applyDiagonal(lowestQubit, phases);
+        return;
+    }
+    const size_t localMask = phases.size() - 1;
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] != FREE_SLOT){
+            values[slot] *= phases[(keys[slot] >> lowestQubit) & localMask];
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::applySwap(const size_t &qubit1, const size_t &qubit2,
+                                                      const size_t &controlMask) {
+    if(denseLayout){
+        dense.applySwap(qubit1, qubit2, controlMask);
+        return;
+    }
+    const size_t bits = (size_t(1) << qubit1) | (size_t(1) << qubit2);
+    transform([&](const size_t &key, const Amplitude &value){
+        const bool differ = ((key >> qubit1) & 1) != ((key >> qubit2) & 1);
+        accumulate(differ && (key & controlMask) == controlMask ? key ^ bits : key, value);
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType SparseStateVector<FloatingNumberType>::getOneProbability(const size_t &target) const {
+    if(denseLayout){
+        return dense.getOneProbability(target);
+    }
+    const size_t targetBit = size_t(1) << target;
+    FloatingNumberType probability = 0;
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] != FREE_SLOT && (keys[slot] & targetBit) != 0){
+            probability += std::norm(values[slot]);
+        }
+    }
+    return probability;
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<FloatingNumberType> SparseStateVector<FloatingNumberType>::getProbabilities(std::span<const size_t> qubits) const {
+    if(denseLayout){
+        return dense.getProbabilities(qubits);
+    }
+    std::vector<FloatingNumberType> probabilities(size_t(1) << qubits.size(), 0);
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] != FREE_SLOT){
+            probabilities[gatherBits(keys[slot], qubits)] += std::norm(values[slot]);
+        }
+    }
+    return probabilities;
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::collapse(const size_t &target, const bool &outcome,
+                                                     const FloatingNumberType &probability) {
+    if(denseLayout){
+        dense.collapse(target, outcome, probability);
+        return;
+    }
+    const size_t targetBit = size_t(1) << target;
+    const FloatingNumberType scale = 1 / std::sqrt(probability);
+    transform([&](const size_t &key, const Amplitude &value){
+        if(((key & targetBit) != 0) == outcome){
+            accumulate(key, value * scale);
+        }
+    });
+}
+
+template<std_floating_point FloatingNumberType>
+ClassicBit SparseStateVector<FloatingNumberType>::measure(const size_t &target) {
+    if(denseLayout){
+        return dense.measure(target);
+    }
+    const FloatingNumberType oneProbability = getOneProbability(target);
+    const FloatingNumberType zeroProbability = 1 - oneProbability;
+    const bool outcome = !(probabilityEngine->getProbability() < zeroProbability);
+    collapse(target, outcome, outcome ? oneProbability : zeroProbability);
+    return ClassicBit(outcome);
+}
+
+template<std_floating_point FloatingNumberType>
+void SparseStateVector<FloatingNumberType>::initialize(const size_t &target, const Matrix &preparation) {
+    if(measure(target).getState() == ClassicBit::State::ONE){
+        applyX(target);
+    }
+    applyMatrix(target, preparation);
+}
+
+template<std_floating_point FloatingNumberType>
+typename Qubit<FloatingNumberType>::State SparseStateVector<FloatingNumberType>::getQubitState(const size_t &target) const {
+    if(denseLayout){
+        return dense.getQubitState(target);
+    }
+    const size_t targetBit = size_t(1) << target;
+    FloatingNumberType zeroProbability = 0;
+    FloatingNumberType oneProbability = 0;
+    Amplitude coherence = 0;
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] == FREE_SLOT){
+            continue;
+        }
+        if((keys[slot] & targetBit) == 0){
+            zeroProbability += std::norm(values[slot]);
+            coherence += std::conj(values[slot]) * getAmplitude(keys[slot] | targetBit);
+        } else {
+            oneProbability += std::norm(values[slot]);
+        }
+    }
+    const FloatingNumberType relativePhase = std::abs(coherence) > 0 ? std::arg(coherence) : 0;
+    return typename Qubit<FloatingNumberType>::State(probabilityEngine, std::sqrt(zeroProbability),
+                                                     std::polar(std::sqrt(oneProbability), relativePhase));
+}
+
+template<std_floating_point FloatingNumberType>
+std::string SparseStateVector<FloatingNumberType>::getRepresentation() const {
+    if(denseLayout){
+        return dense.getRepresentation();
+    }
+    std::vector<size_t> slots;
+    for(size_t slot = 0; slot < keys.size(); slot++){
+        if(keys[slot] != FREE_SLOT && !probabilityEngine->compare(std::norm(values[slot]), FloatingNumberType(0))){
+            slots.push_back(slot);
+        }
+    }
+    std::sort(slots.begin(), slots.end(), [&](const size_t &first, const size_t &second){
+        return keys[first] < keys[second];
+    });
+    std::string representation;
+    for(const auto& slot : slots){
+        std::string ket;
+        for(size_t qubit = qubitCount; qubit > 0; qubit--){
+            ket += (keys[slot] >> (qubit - 1)) & 1 ? "1" : "0";
+        }
+        if(!representation.empty()){
+            representation += " + ";
+        }
+        representation += "(" + std::to_string(values[slot].real()) + " + " + std::to_string(values[slot].imag()) + "i)" + "×❘" + ket + "〉";
+    }
+    return representation;
+}
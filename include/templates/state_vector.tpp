@@ -0,0 +1,300 @@
+template<std_floating_point FloatingNumberType>
+StateVector<FloatingNumberType>::RegisterTooLargeException::RegisterTooLargeException(const size_t &qubitCount):
+        std::runtime_error("Cannot allocate a state vector for " + std::to_string(qubitCount) + " qubits"),
+        qubitCount(qubitCount) {}
+
+template<std_floating_point FloatingNumberType>
+StateVector<FloatingNumberType>::StateVector(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                             const size_t &qubitCount):
+        probabilityEngine(probabilityEngine),
+        qubitCount(qubitCount) {}
+
+template<std_floating_point FloatingNumberType>
+size_t StateVector<FloatingNumberType>::insertZeroBit(const size_t &index, const size_t &position) {
+    const size_t lowMask = (size_t(1) << position) - 1;
+    return ((index & ~lowMask) << 1) | (index & lowMask);
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::reset() {
+    if(qubitCount >= sizeof(size_t) * 8 - 1 ||
+       (size_t(1) << qubitCount) > amplitudes.max_size()){
+        throw RegisterTooLargeException(qubitCount);
+    }
+    amplitudes.assign(size_t(1) << qubitCount, Amplitude(0));
+    amplitudes[0] = 1;
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::resize(const size_t &qubitCount) {
+    this->qubitCount = qubitCount;
+    amplitudes.clear();
+}
+
+template<std_floating_point FloatingNumberType>
+bool StateVector<FloatingNumberType>::isInitialized() const {
+    return !amplitudes.empty();
+}
+
+template<std_floating_point FloatingNumberType>
+size_t StateVector<FloatingNumberType>::getQubitCount() const {
+    return qubitCount;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::shared_ptr<ProbabilityEngine<FloatingNumberType>> &StateVector<FloatingNumberType>::getProbabilityEngine() const {
+    return probabilityEngine;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::vector<typename StateVector<FloatingNumberType>::Amplitude> &StateVector<FloatingNumberType>::getAmplitudes() const {
+    return amplitudes;
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::setAmplitudes(std::vector<Amplitude> amplitudes_) {
+    amplitudes = std::move(amplitudes_);
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::swapAmplitudes(std::vector<Amplitude> &amplitudes_) {
+    std::swap(amplitudes, amplitudes_);
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::applyMatrix(const size_t &target, const Matrix &matrix, const size_t &controlMask) {
+    if constexpr (std::is_same_v<FloatingNumberType, double>) {
+        Kernels::applyMatrix(amplitudes.data(), amplitudes.size(), target, matrix, controlMask);
+        return;
+    }
+    const size_t targetBit = size_t(1) << target;
+    const size_t pairCount = amplitudes.size() / 2;
+    for(size_t k = 0; k < pairCount; k++){
+        const size_t i0 = insertZeroBit(k, target);
+        if((i0 & controlMask) != controlMask){
+            continue;
+        }
+        const size_t i1 = i0 | targetBit;
+        const Amplitude a0 = amplitudes[i0];
+        const Amplitude a1 = amplitudes[i1];
+        amplitudes[i0] = matrix[0] * a0 + matrix[1] * a1;
+        amplitudes[i1] = matrix[2] * a0 + matrix[3] * a1;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::prepareGroups(std::span<const size_t> targets) {
+    const size_t dimension = size_t(1) << targets.size();
+    targetPositions.assign(targets.begin(), targets.end());
+    std::sort(targetPositions.begin(), targetPositions.end());
+    targetOffsets.assign(dimension, 0);
+    for(size_t j = 0; j < dimension; j++){
+        for(size_t i = 0; i < targets.size(); i++){
+            targetOffsets[j] |= ((j >> i) & 1) << targets[i];
+        }
+    }
+    gathered.resize(dimension);
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::applyUnitary(std::span<const size_t> targets, std::span<const Amplitude> matrix,
+                                                   const size_t &controlMask) {
+    const size_t dimension = size_t(1) << targets.size();
+    prepareGroups(targets);
+    const size_t groupCount = amplitudes.size() >> targets.size();
+    for(size_t k = 0; k < groupCount; k++){
+        size_t base = k;
+        for(const auto& position : targetPositions){
+            base = insertZeroBit(base, position);
+        }
+        if((base & controlMask) != controlMask){
+            continue;
+        }
+        for(size_t j = 0; j < dimension; j++){
+            gathered[j] = amplitudes[base | targetOffsets[j]];
+        }
+        for(size_t row = 0; row < dimension; row++){
+            Amplitude value = 0;
+            for(size_t column = 0; column < dimension; column++){
+                value += matrix[row * dimension + column] * gathered[column];
+            }
+            amplitudes[base | targetOffsets[row]] = value;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::applyPermutation(std::span<const size_t> targets, std::span<const size_t> table,
+                                                       const size_t &controlMask) {
+    const size_t dimension = size_t(1) << targets.size();
+    prepareGroups(targets);
+    const size_t groupCount = amplitudes.size() >> targets.size();
+    for(size_t k = 0; k < groupCount; k++){
+        size_t base = k;
+        for(const auto& position : targetPositions){
+            base = insertZeroBit(base, position);
+        }
+        if((base & controlMask) != controlMask){
+            continue;
+        }
+        for(size_t j = 0; j < dimension; j++){
+            gathered[j] = amplitudes[base | targetOffsets[j]];
+        }
+        for(size_t j = 0; j < dimension; j++){
+            amplitudes[base | targetOffsets[table[j]]] = gathered[j];
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::applyX(const size_t &target, const size_t &controlMask) {
+    const size_t targetBit = size_t(1) << target;
+    const size_t pairCount = amplitudes.size() / 2;
+    for(size_t k = 0; k < pairCount; k++){
+        const size_t i0 = insertZeroBit(k, target);
+        if((i0 & controlMask) == controlMask){
+            std::swap(amplitudes[i0], amplitudes[i0 | targetBit]);
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::applyPhase(const size_t &target, const Amplitude &phase, const size_t &controlMask) {
+    const size_t mask = controlMask | (size_t(1) << target);
+    if constexpr (std::is_same_v<FloatingNumberType, double>) {
+        Kernels::applyPhase(amplitudes.data(), amplitudes.size(), mask, phase);
+        return;
+    }
+    for(size_t i = 0; i < amplitudes.size(); i++){
+        if((i & mask) == mask){
+            amplitudes[i] *= phase;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::applyDiagonal(const size_t &lowestQubit, std::span<const Amplitude> phases) {
+    if constexpr (std::is_same_v<FloatingNumberType, double>) {
+        Kernels::applyDiagonal(amplitudes.data(), amplitudes.size(), lowestQubit, phases.data(), phases.size());
+        return;
+    }
+    const size_t rangeMask = phases.size() - 1;
+    for(size_t i = 0; i < amplitudes.size(); i++){
+        amplitudes[i] *= phases[(i >> lowestQubit) & rangeMask];
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::applySwap(const size_t &qubit1, const size_t &qubit2, const size_t &controlMask) {
+    const size_t bit1 = size_t(1) << qubit1;
+    const size_t bit2 = size_t(1) << qubit2;
+    // Only the ❘..1..0..〉 and ❘..0..1..〉 pairs are exchanged
+    for(size_t i = 0; i < amplitudes.size(); i++){
+        if((i & bit1) != 0 && (i & bit2) == 0 && (i & controlMask) == controlMask){
+            std::swap(amplitudes[i], amplitudes[(i & ~bit1) | bit2]);
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType StateVector<FloatingNumberType>::getOneProbability(const size_t &target) const {
+    const size_t targetBit = size_t(1) << target;
+    FloatingNumberType probability = 0;
+    for(size_t i = 0; i < amplitudes.size(); i++){
+        if((i & targetBit) != 0){
+            probability += std::norm(amplitudes[i]);
+        }
+    }
+    return probability;
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<FloatingNumberType> StateVector<FloatingNumberType>::getProbabilities(std::span<const size_t> qubits) const {
+    std::vector<FloatingNumberType> probabilities(size_t(1) << qubits.size(), 0);
+    for(size_t i = 0; i < amplitudes.size(); i++){
+        size_t outcome = 0;
+        for(size_t j = 0; j < qubits.size(); j++){
+            outcome |= ((i >> qubits[j]) & 1) << j;
+        }
+        probabilities[outcome] += std::norm(amplitudes[i]);
+    }
+    return probabilities;
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::collapse(const size_t &target, const bool &outcome,
+                                               const FloatingNumberType &probability) {
+    const size_t targetBit = size_t(1) << target;
+    const FloatingNumberType scale = 1 / std::sqrt(probability);
+    for(size_t i = 0; i < amplitudes.size(); i++){
+        if(((i & targetBit) != 0) == outcome){
+            amplitudes[i] *= scale;
+        } else {
+            amplitudes[i] = 0;
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+ClassicBit StateVector<FloatingNumberType>::measure(const size_t &target) {
+    const FloatingNumberType oneProbability = getOneProbability(target);
+    const FloatingNumberType zeroProbability = 1 - oneProbability;
+    const bool outcome = !(probabilityEngine->getProbability() < zeroProbability);
+    collapse(target, outcome, outcome ? oneProbability : zeroProbability);
+    return ClassicBit(outcome);
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::initialize(const size_t &target,
+                                                 const typename Qubit<FloatingNumberType>::State &state) {
+    // Unitary mapping ❘0〉 to α❘0〉 + β❘1〉
+    const Amplitude alpha = state.getAlpha();
+    const Amplitude beta = state.getBeta();
+    initialize(target, Matrix{alpha, -std::conj(beta), beta, std::conj(alpha)});
+}
+
+template<std_floating_point FloatingNumberType>
+void StateVector<FloatingNumberType>::initialize(const size_t &target, const Matrix &preparation) {
+    if(measure(target).getState() == ClassicBit::State::ONE){
+        applyX(target);
+    }
+    applyMatrix(target, preparation);
+}
+
+template<std_floating_point FloatingNumberType>
+typename Qubit<FloatingNumberType>::State StateVector<FloatingNumberType>::getQubitState(const size_t &target) const {
+    const size_t targetBit = size_t(1) << target;
+    FloatingNumberType zeroProbability = 0;
+    FloatingNumberType oneProbability = 0;
+    Amplitude coherence = 0;
+    for(size_t i = 0; i < amplitudes.size(); i++){
+        if((i & targetBit) == 0){
+            zeroProbability += std::norm(amplitudes[i]);
+            coherence += std::conj(amplitudes[i]) * amplitudes[i | targetBit];
+        } else {
+            oneProbability += std::norm(amplitudes[i]);
+        }
+    }
+    const FloatingNumberType relativePhase = std::abs(coherence) > 0 ? std::arg(coherence) : 0;
+    return typename Qubit<FloatingNumberType>::State(probabilityEngine, std::sqrt(zeroProbability),
+                                                     std::polar(std::sqrt(oneProbability), relativePhase));
+}
+
+template<std_floating_point FloatingNumberType>
+std::string StateVector<FloatingNumberType>::getRepresentation() const {
+    std::string representation;
+    for(size_t i = 0; i < amplitudes.size(); i++){
+        if(probabilityEngine->compare(std::norm(amplitudes[i]), FloatingNumberType(0))){
+            continue;
+        }
+        std::string ket;
+        for(size_t qubit = qubitCount; qubit > 0; qubit--){
+            ket += (i >> (qubit - 1)) & 1 ? "1" : "0";
+        }
+        if(!representation.empty()){
+            representation += " + ";
+        }
+        representation += "(" + std::to_string(amplitudes[i].real()) + " + " + std::to_string(amplitudes[i].imag()) + "i)" + "×❘" + ket + "〉";
+    }
+    return representation;
+}
@@ -4,11 +4,8 @@ Circuit<FloatingNumberType>::SwapGate::SwapSameQubitException::SwapSameQubitExce
                                             qubitIndex(qubitIndex) {}
 template<std_floating_point FloatingNumberType>
 typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::SwapGate::getDrawings(
-        const Circuit<FloatingNumberType> *circuit) const {
-    typename Gate::Drawings drawings(circuit->qubits.size() + 1);
-    std::array<std::string, 3> outsideDrawing = {"       ", "───────", "       "};
+        const Circuit<FloatingNumberType> *) const {
     std::array<std::string, 3> insideDrawing = {"   │   ", "───┼───", "   │   "};
-    std::array<std::string, 3> measureDrawing = {"       ", "═══════", "       "};
     std::array<std::string, 3> topTargetDrawing = {"┌─────┐", "┤ SWP ├", "└──┬──┘"};
     std::array<std::string, 3> bottomTargetDrawing = {"┌──┴──┐", "┤ SWP ├", "└─────┘"};
     size_t minQubitIndex;
@@ -20,18 +17,14 @@ typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>
         minQubitIndex = qubitIndex2;
         maxQubitIndex = qubitIndex1;
     }
-    for(size_t i = 0; i < minQubitIndex; i++){
-        drawings[i] = outsideDrawing;
-    }
-    drawings[minQubitIndex] = topTargetDrawing;
+    typename Gate::Drawings drawings;
+    drawings.firstRow = minQubitIndex;
+    drawings.rows.reserve(maxQubitIndex - minQubitIndex + 1);
+    drawings.rows.push_back(topTargetDrawing);
     for(size_t i = minQubitIndex + 1; i < maxQubitIndex; i++){
-        drawings[i] = insideDrawing;
-    }
-    drawings[maxQubitIndex] = bottomTargetDrawing;
-    for(size_t i = maxQubitIndex + 1; i < circuit->qubits.size(); i++){
-        drawings[i] = outsideDrawing;
+        drawings.rows.push_back(insideDrawing);
     }
-    drawings[circuit->qubits.size()] = measureDrawing;
+    drawings.rows.push_back(bottomTargetDrawing);
     return drawings;
 }
 
@@ -44,9 +37,13 @@ std::string Circuit<FloatingNumberType>::SwapGate::getRepresentation() const {
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::SwapGate::apply(Circuit<FloatingNumberType> *circuit) {
-    // Swap qubits
-    std::swap(circuit->qubits[qubitIndex1], circuit->qubits[qubitIndex2]);
+void Circuit<FloatingNumberType>::SwapGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    // Uncontrolled swaps only relabel the qubits, the state is reordered once by Circuit::restoreLayout
+    if(circuit->controls.empty() && !circuit->classicallyControlled){
+        circuit->swapLayout(qubitIndex1, qubitIndex2);
+        return;
+    }
+    program.addSwap(circuit->resolveQubit(qubitIndex1), circuit->resolveQubit(qubitIndex2), circuit->controls);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -59,10 +56,46 @@ void Circuit<FloatingNumberType>::SwapGate::verify(const Circuit* circuit) const
     if(qubitIndex1 == qubitIndex2){
         throw SwapSameQubitException(qubitIndex1);
     }
-    if(qubitIndex1 >= circuit->qubits.size()){
+    if(qubitIndex1 >= circuit->getQubitCount()){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(qubitIndex1);
     }
-    if(qubitIndex2 >= circuit->qubits.size()){
+    if(qubitIndex2 >= circuit->getQubitCount()){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(qubitIndex2);
     }
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::SwapGate::getQubitIndices() const {
+    return {qubitIndex1, qubitIndex2};
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::SwapGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    qubitIndex1 = qubitMap[qubitIndex1];
+    qubitIndex2 = qubitMap[qubitIndex2];
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::SwapGate::isPermutation() const {
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::SwapGate::permuteBasisState(const size_t &basisState) const {
+    if(((basisState >> qubitIndex1) & 1) == ((basisState >> qubitIndex2) & 1)){
+        return basisState;
+    }
+    return basisState ^ ((size_t(1) << qubitIndex1) | (size_t(1) << qubitIndex2));
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::SwapGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::SWAP);
+    encoder.writeWord(qubitIndex1);
+    encoder.writeWord(qubitIndex2);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::SwapGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("swap", {qubitIndex1, qubitIndex2});
+}
@@ -0,0 +1,594 @@
+template<std_floating_point FloatingNumberType>
+Tableau<FloatingNumberType>::NonCliffordOperationException::NonCliffordOperationException(const std::string &operation):
+        std::runtime_error("Cannot apply a non-Clifford " + operation + " on a stabilizer tableau") {}
+
+template<std_floating_point FloatingNumberType>
+Tableau<FloatingNumberType>::Tableau(std::shared_ptr<ProbabilityEngine<FloatingNumberType>> probabilityEngine,
+                                     const size_t &qubitCount):
+        probabilityEngine(probabilityEngine),
+        qubitCount(qubitCount) {}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::reset() {
+    wordCount = (qubitCount + 63) / 64;
+    rows.assign(2 * qubitCount * 2 * wordCount, 0);
+    signs.assign(2 * qubitCount, 0);
+    // Destabilizer i is X on qubit i and stabilizer i is Z on qubit i
+    for(size_t i = 0; i < qubitCount; i++){
+        getRow(i)[i / 64] |= std::uint64_t(1) << (i % 64);
+        getRow(qubitCount + i)[wordCount + i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::resize(const size_t &qubitCount) {
+    this->qubitCount = qubitCount;
+    rows.clear();
+    signs.clear();
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::isInitialized() const {
+    return !signs.empty();
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Tableau<FloatingNumberType>::getQubitCount() const {
+    return qubitCount;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::shared_ptr<ProbabilityEngine<FloatingNumberType>> &Tableau<FloatingNumberType>::getProbabilityEngine() const {
+    return probabilityEngine;
+}
+
+template<std_floating_point FloatingNumberType>
+std::uint64_t *Tableau<FloatingNumberType>::getRow(const size_t &row) {
+    return rows.data() + row * 2 * wordCount;
+}
+
+template<std_floating_point FloatingNumberType>
+const std::uint64_t *Tableau<FloatingNumberType>::getRow(const size_t &row) const {
+    return rows.data() + row * 2 * wordCount;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::getX(const size_t &row, const size_t &qubit) const {
+    return (getRow(row)[qubit / 64] >> (qubit % 64)) & 1;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::getZ(const size_t &row, const size_t &qubit) const {
+    return (getRow(row)[wordCount + qubit / 64] >> (qubit % 64)) & 1;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::multiply(std::uint64_t *target, const bool &targetSign, const std::uint64_t *source,
+                                           const bool &sourceSign) const {
+    // Sum over the qubits of the power of i of source[q] * target[q] (+1, -1 or 0), per word
+    std::int64_t exponent = 0;
+    for(size_t w = 0; w < wordCount; w++){
+        const std::uint64_t x1 = source[w];
+        const std::uint64_t z1 = source[wordCount + w];
+        const std::uint64_t x2 = target[w];
+        const std::uint64_t z2 = target[wordCount + w];
+        // XY = iZ, YZ = iX and ZX = iY, while the reversed products give -i
+        const std::uint64_t plus = (x1 & z1 & z2 & ~x2) | (x1 & ~z1 & x2 & z2) | (~x1 & z1 & x2 & ~z2);
+        const std::uint64_t minus = (x1 & z1 & x2 & ~z2) | (x1 & ~z1 & ~x2 & z2) | (~x1 & z1 & x2 & z2);
+        exponent += std::popcount(plus) - std::popcount(minus);
+        target[w] = x1 ^ x2;
+        target[wordCount + w] = z1 ^ z2;
+    }
+    // The product of commuting strings is real, so the exponent is even
+    exponent += 2 * (int(targetSign) + int(sourceSign));
+    return ((exponent % 4) + 4) % 4 == 2;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::isRandom(const size_t &target) const {
+    for(size_t i = qubitCount; i < 2 * qubitCount; i++){
+        if(getX(i, target)){
+            return true;
+        }
+    }
+    return false;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::getDeterministicOutcome(const size_t &target, std::vector<std::uint64_t> &product) const {
+    // Z on the target is the product of the stabilizers paired with the destabilizers that anticommute with it
+    product.assign(2 * wordCount, 0);
+    bool sign = false;
+    for(size_t i = 0; i < qubitCount; i++){
+        if(getX(i, target)){
+            sign = multiply(product.data(), sign, getRow(qubitCount + i), signs[qubitCount + i]);
+        }
+    }
+    return sign;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::measureDeterministic(const size_t &target) {
+    // Z on the target is the product of the stabilizers paired with the destabilizers that anticommute with it, and
+    // some destabilizer does, since the generators span every Pauli string
+    size_t first = 0;
+    while(!getX(first, target)){
+        first++;
+    }
+    for(size_t i = first + 1; i < qubitCount; i++){
+        if(getX(i, target)){
+            // The product replaces the stabilizer paired with the first destabilizer, so the others are multiplied by
+            // that destabilizer to keep commuting with it, which also clears their X bit on the target
+            signs[qubitCount + first] = multiply(getRow(qubitCount + first), signs[qubitCount + first],
+                                                 getRow(qubitCount + i), signs[qubitCount + i]);
+            signs[i] = multiply(getRow(i), signs[i], getRow(first), signs[first]);
+        }
+    }
+    return signs[qubitCount + first];
+}
+
+template<std_floating_point FloatingNumberType>
+std::string Tableau<FloatingNumberType>::getStabilizer(const size_t &index) const {
+    std::string stabilizer = signs[qubitCount + index] ? "-" : "+";
+    for(size_t q = 0; q < qubitCount; q++){
+        const bool x = getX(qubitCount + index, q);
+        const bool z = getZ(qubitCount + index, q);
+        stabilizer += x ? (z ? 'Y' : 'X') : (z ? 'Z' : 'I');
+    }
+    return stabilizer;
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyHadamard(const size_t &target) {
+    const size_t word = target / 64;
+    const size_t bit = target % 64;
+    for(size_t i = 0; i < 2 * qubitCount; i++){
+        std::uint64_t *row = getRow(i);
+        const std::uint64_t x = (row[word] >> bit) & 1;
+        const std::uint64_t z = (row[wordCount + word] >> bit) & 1;
+        signs[i] ^= x & z;
+        row[word] ^= (x ^ z) << bit;
+        row[wordCount + word] ^= (x ^ z) << bit;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyS(const size_t &target) {
+    const size_t word = target / 64;
+    const size_t bit = target % 64;
+    for(size_t i = 0; i < 2 * qubitCount; i++){
+        std::uint64_t *row = getRow(i);
+        const std::uint64_t x = (row[word] >> bit) & 1;
+        const std::uint64_t z = (row[wordCount + word] >> bit) & 1;
+        signs[i] ^= x & z;
+        row[wordCount + word] ^= x << bit;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyCX(const size_t &control, const size_t &target) {
+    const size_t controlWord = control / 64;
+    const size_t controlBit = control % 64;
+    const size_t targetWord = target / 64;
+    const size_t targetBit = target % 64;
+    for(size_t i = 0; i < 2 * qubitCount; i++){
+        std::uint64_t *row = getRow(i);
+        const std::uint64_t xc = (row[controlWord] >> controlBit) & 1;
+        const std::uint64_t zc = (row[wordCount + controlWord] >> controlBit) & 1;
+        const std::uint64_t xt = (row[targetWord] >> targetBit) & 1;
+        const std::uint64_t zt = (row[wordCount + targetWord] >> targetBit) & 1;
+        signs[i] ^= xc & zt & (xt ^ zc ^ 1);
+        row[targetWord] ^= xc << targetBit;
+        row[wordCount + controlWord] ^= zt << controlBit;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyCZ(const size_t &qubit1, const size_t &qubit2) {
+    const size_t word1 = qubit1 / 64;
+    const size_t bit1 = qubit1 % 64;
+    const size_t word2 = qubit2 / 64;
+    const size_t bit2 = qubit2 % 64;
+    for(size_t i = 0; i < 2 * qubitCount; i++){
+        std::uint64_t *row = getRow(i);
+        const std::uint64_t x1 = (row[word1] >> bit1) & 1;
+        const std::uint64_t z1 = (row[wordCount + word1] >> bit1) & 1;
+        const std::uint64_t x2 = (row[word2] >> bit2) & 1;
+        const std::uint64_t z2 = (row[wordCount + word2] >> bit2) & 1;
+        signs[i] ^= x1 & x2 & (z1 ^ z2);
+        row[wordCount + word1] ^= x2 << bit1;
+        row[wordCount + word2] ^= x1 << bit2;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyImages(const size_t &target, const std::array<PauliImage, 3> &images) {
+    const size_t word = target / 64;
+    const size_t bit = target % 64;
+    for(size_t i = 0; i < 2 * qubitCount; i++){
+        std::uint64_t *row = getRow(i);
+        const bool x = (row[word] >> bit) & 1;
+        const bool z = (row[wordCount + word] >> bit) & 1;
+        if(!x && !z){
+            continue;
+        }
+        // X, Y and Z are images[0], images[1] and images[2]
+        const PauliImage &image = images[x ? (z ? 1 : 0) : 2];
+        signs[i] ^= image.negative;
+        row[word] = (row[word] & ~(std::uint64_t(1) << bit)) | (std::uint64_t(image.x) << bit);
+        row[wordCount + word] = (row[wordCount + word] & ~(std::uint64_t(1) << bit)) | (std::uint64_t(image.z) << bit);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyMatrix(const size_t &target, const Matrix &matrix, std::span<const size_t> controls) {
+    if(controls.empty()){
+        std::array<PauliImage, 3> images{};
+        if(!getImages(matrix, images)){
+            throwNonClifford("single-qubit unitary");
+        }
+        applyImages(target, images);
+        return;
+    }
+    int pauli;
+    int power;
+    if(controls.size() != 1 || !getPauli(matrix, pauli, power)){
+        throwNonClifford("controlled unitary");
+    }
+    // A controlled i^k P is diag(1, i^k) on the control followed by a controlled P
+    const size_t control = controls[0];
+    for(int i = 0; i < power; i++){
+        applyS(control);
+    }
+    switch(pauli){
+        case 1:
+            applyCX(control, target);
+            break;
+        case 2:
+            // Y = S X S†, and S† = S^3
+            for(int i = 0; i < 3; i++){
+                applyS(target);
+            }
+            applyCX(control, target);
+            applyS(target);
+            break;
+        case 3:
+            applyCZ(control, target);
+            break;
+        default:
+            break;
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyUnitary(std::span<const size_t>, std::span<const Amplitude>, std::span<const size_t>) {
+    throwNonClifford("multi-qubit unitary");
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyPermutation(std::span<const size_t> targets, std::span<const size_t> table,
+                                                   std::span<const size_t> controls) {
+    std::vector<size_t> positions;
+    if(!controls.empty() || !getQubitPermutation(table, positions)){
+        throwNonClifford("permutation");
+    }
+    for(size_t i = 0; i < 2 * qubitCount; i++){
+        std::uint64_t *row = getRow(i);
+        std::uint64_t xBits = 0;
+        std::uint64_t zBits = 0;
+        for(size_t j = 0; j < targets.size(); j++){
+            xBits |= std::uint64_t((row[targets[j] / 64] >> (targets[j] % 64)) & 1) << positions[j];
+            zBits |= std::uint64_t((row[wordCount + targets[j] / 64] >> (targets[j] % 64)) & 1) << positions[j];
+        }
+        for(size_t j = 0; j < targets.size(); j++){
+            const std::uint64_t mask = std::uint64_t(1) << (targets[j] % 64);
+            row[targets[j] / 64] = (row[targets[j] / 64] & ~mask) | (((xBits >> j) & 1) << (targets[j] % 64));
+            row[wordCount + targets[j] / 64] = (row[wordCount + targets[j] / 64] & ~mask) | (((zBits >> j) & 1) << (targets[j] % 64));
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyX(const size_t &target, std::span<const size_t> controls) {
+    if(!controls.empty()){
+        if(controls.size() != 1){
+            throwNonClifford("multi-controlled X");
+        }
+        applyCX(controls[0], target);
+        return;
+    }
+    // X flips the sign of the generators with Z or Y on the target
+    for(size_t i = 0; i < 2 * qubitCount; i++){
+        signs[i] ^= getZ(i, target);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyPhase(const size_t &target, const Amplitude &phase, std::span<const size_t> controls) {
+    const int power = getPowerOfI(phase);
+    if(controls.empty() && power >= 0){
+        for(int i = 0; i < power; i++){
+            applyS(target);
+        }
+        return;
+    }
+    if(controls.size() != 1 || (power != 0 && power != 2)){
+        throwNonClifford("phase");
+    }
+    if(power == 2){
+        applyCZ(controls[0], target);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applyDiagonal(const size_t &lowestQubit, std::span<const Amplitude> phases) {
+    DiagonalDecomposition decomposition;
+    if(!decomposeDiagonal(phases, decomposition)){
+        throwNonClifford("diagonal");
+    }
+    for(size_t j = 0; j < decomposition.sPowers.size(); j++){
+        for(std::uint8_t i = 0; i < decomposition.sPowers[j]; i++){
+            applyS(lowestQubit + j);
+        }
+    }
+    for(const auto& [qubit1, qubit2] : decomposition.controlledZPairs){
+        applyCZ(lowestQubit + qubit1, lowestQubit + qubit2);
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::applySwap(const size_t &qubit1, const size_t &qubit2, std::span<const size_t> controls) {
+    if(!controls.empty()){
+        throwNonClifford("controlled swap");
+    }
+    for(size_t i = 0; i < 2 * qubitCount; i++){
+        std::uint64_t *row = getRow(i);
+        for(const size_t offset : {size_t(0), wordCount}){
+            const std::uint64_t bit1 = (row[offset + qubit1 / 64] >> (qubit1 % 64)) & 1;
+            const std::uint64_t bit2 = (row[offset + qubit2 / 64] >> (qubit2 % 64)) & 1;
+            row[offset + qubit1 / 64] ^= (bit1 ^ bit2) << (qubit1 % 64);
+            row[offset + qubit2 / 64] ^= (bit1 ^ bit2) << (qubit2 % 64);
+        }
+    }
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType Tableau<FloatingNumberType>::getOneProbability(const size_t &target) const {
+    if(isRandom(target)){
+        return FloatingNumberType(0.5);
+    }
+    std::vector<std::uint64_t> product;
+    return getDeterministicOutcome(target, product) ? 1 : 0;
+}
+
+template<std_floating_point FloatingNumberType>
+ClassicBit Tableau<FloatingNumberType>::measure(const size_t &target) {
+    // A value is drawn even for deterministic outcomes, so that the engine advances like for a StateVector
+    const FloatingNumberType value = probabilityEngine->getProbability();
+    size_t pivot = qubitCount;
+    while(pivot < 2 * qubitCount && !getX(pivot, target)){
+        pivot++;
+    }
+    if(pivot == 2 * qubitCount){
+        return ClassicBit(measureDeterministic(target));
+    }
+
+    const bool outcome = !(value < FloatingNumberType(0.5));
+    for(size_t i = 0; i < 2 * qubitCount; i++){
+        if(i != pivot && getX(i, target)){
+            signs[i] = multiply(getRow(i), signs[i], getRow(pivot), signs[pivot]);
+        }
+    }
+    // The pivot becomes the destabilizer of the new stabilizer ±Z on the target
+    std::copy_n(getRow(pivot), 2 * wordCount, getRow(pivot - qubitCount));
+    signs[pivot - qubitCount] = signs[pivot];
+    std::fill_n(getRow(pivot), 2 * wordCount, 0);
+    getRow(pivot)[wordCount + target / 64] = std::uint64_t(1) << (target % 64);
+    signs[pivot] = outcome;
+    return ClassicBit(outcome);
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::initialize(const size_t &target, const Matrix &preparation) {
+    if(measure(target).getState() == ClassicBit::State::ONE){
+        applyX(target);
+    }
+    applyMatrix(target, preparation);
+}
+
+template<std_floating_point FloatingNumberType>
+typename Qubit<FloatingNumberType>::State Tableau<FloatingNumberType>::getQubitState(const size_t &) const {
+    throwNonClifford("qubit state read");
+}
+
+template<std_floating_point FloatingNumberType>
+FloatingNumberType Tableau<FloatingNumberType>::getTolerance() {
+    return std::sqrt(std::numeric_limits<FloatingNumberType>::epsilon());
+}
+
+template<std_floating_point FloatingNumberType>
+int Tableau<FloatingNumberType>::getPowerOfI(const Amplitude &phase) {
+    const std::array<Amplitude, 4> powers = {Amplitude(1, 0), Amplitude(0, 1), Amplitude(-1, 0), Amplitude(0, -1)};
+    for(int i = 0; i < 4; i++){
+        if(std::abs(phase - powers[i]) < getTolerance()){
+            return i;
+        }
+    }
+    return -1;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::getImages(const Matrix &matrix, std::array<PauliImage, 3> &images) {
+    const auto multiply = [](const Matrix &a, const Matrix &b){
+        return Matrix{a[0] * b[0] + a[1] * b[2], a[0] * b[1] + a[1] * b[3],
+                      a[2] * b[0] + a[3] * b[2], a[2] * b[1] + a[3] * b[3]};
+    };
+    const Matrix adjoint = {std::conj(matrix[0]), std::conj(matrix[2]), std::conj(matrix[1]), std::conj(matrix[3])};
+    const Amplitude i(0, 1);
+    const std::array<Matrix, 3> paulis = {Matrix{0, 1, 1, 0}, Matrix{0, -i, i, 0}, Matrix{1, 0, 0, -1}};
+    for(size_t p = 0; p < 3; p++){
+        const Matrix image = multiply(multiply(matrix, paulis[p]), adjoint);
+        // Coordinates of the image on X, Y and Z: tr(P image) / 2
+        const std::array<Amplitude, 3> coordinates = {(image[1] + image[2]) / FloatingNumberType(2),
+                                                      (i * image[1] - i * image[2]) / FloatingNumberType(2),
+                                                      (image[0] - image[3]) / FloatingNumberType(2)};
+        int found = -1;
+        for(int q = 0; q < 3; q++){
+            if(std::abs(std::abs(coordinates[q].real()) - 1) < getTolerance() && std::abs(coordinates[q].imag()) < getTolerance()){
+                found = q;
+            } else if(std::abs(coordinates[q]) >= getTolerance()){
+                return false;
+            }
+        }
+        if(found < 0){
+            return false;
+        }
+        images[p] = PauliImage{found != 2, found != 0, coordinates[found].real() < 0};
+    }
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::getPauli(const Matrix &matrix, int &pauli, int &power) {
+    const Amplitude i(0, 1);
+    const std::array<Matrix, 4> paulis = {Matrix{1, 0, 0, 1}, Matrix{0, 1, 1, 0}, Matrix{0, -i, i, 0}, Matrix{1, 0, 0, -1}};
+    // The first non-zero entry of a Pauli matrix gives the power of i
+    for(pauli = 0; pauli < 4; pauli++){
+        const size_t pivot = paulis[pauli][0] != Amplitude(0) ? 0 : 1;
+        power = getPowerOfI(matrix[pivot] / paulis[pauli][pivot]);
+        if(power < 0){
+            continue;
+        }
+        const Amplitude factor = std::pow(i, power);
+        bool matches = true;
+        for(size_t k = 0; k < 4; k++){
+            matches = matches && std::abs(matrix[k] - factor * paulis[pauli][k]) < getTolerance();
+        }
+        if(matches){
+            return true;
+        }
+    }
+    return false;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::decomposeDiagonal(std::span<const Amplitude> phases,
+                                                    DiagonalDecomposition &decomposition) {
+    if(!std::has_single_bit(phases.size())){
+        return false;
+    }
+    const size_t span = std::countr_zero(phases.size());
+    std::vector<int> exponents(phases.size());
+    for(size_t state = 0; state < phases.size(); state++){
+        exponents[state] = getPowerOfI(phases[state]);
+        if(exponents[state] < 0){
+            return false;
+        }
+    }
+    // The phase of ❘0...0〉 is a global phase
+    const auto getExponent = [&](const size_t &state){
+        return (exponents[state] - exponents[0] + 4) % 4;
+    };
+    decomposition.sPowers.resize(span);
+    for(size_t j = 0; j < span; j++){
+        decomposition.sPowers[j] = getExponent(size_t(1) << j);
+    }
+    for(size_t j = 0; j < span; j++){
+        for(size_t k = j + 1; k < span; k++){
+            const int pairExponent = (getExponent((size_t(1) << j) | (size_t(1) << k)) -
+                                      decomposition.sPowers[j] - decomposition.sPowers[k] + 8) % 4;
+            if(pairExponent == 2){
+                decomposition.controlledZPairs.emplace_back(j, k);
+            } else if(pairExponent != 0){
+                return false;
+            }
+        }
+    }
+    for(size_t state = 0; state < phases.size(); state++){
+        int expected = 0;
+        for(size_t j = 0; j < span; j++){
+            expected += ((state >> j) & 1) * decomposition.sPowers[j];
+        }
+        for(const auto& [j, k] : decomposition.controlledZPairs){
+            expected += 2 * ((state >> j) & (state >> k) & 1);
+        }
+        if(expected % 4 != getExponent(state)){
+            return false;
+        }
+    }
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::getQubitPermutation(std::span<const size_t> table, std::vector<size_t> &positions) {
+    if(!std::has_single_bit(table.size())){
+        return false;
+    }
+    const size_t width = std::countr_zero(table.size());
+    positions.resize(width);
+    for(size_t j = 0; j < width; j++){
+        if(!std::has_single_bit(table[size_t(1) << j])){
+            return false;
+        }
+        positions[j] = std::countr_zero(table[size_t(1) << j]);
+    }
+    for(size_t state = 0; state < table.size(); state++){
+        size_t image = 0;
+        for(size_t j = 0; j < width; j++){
+            image |= ((state >> j) & 1) << positions[j];
+        }
+        if(table[state] != image){
+            return false;
+        }
+    }
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+void Tableau<FloatingNumberType>::throwNonClifford(const std::string &operation) {
+    throw NonCliffordOperationException(operation);
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::isClifford(const Matrix &matrix, const size_t &controlCount) {
+    if(controlCount == 0){
+        std::array<PauliImage, 3> images{};
+        return getImages(matrix, images);
+    }
+    int pauli;
+    int power;
+    return controlCount == 1 && getPauli(matrix, pauli, power);
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::isClifford(const Amplitude &phase, const size_t &controlCount) {
+    const int power = getPowerOfI(phase);
+    if(controlCount == 0){
+        return power >= 0;
+    }
+    return controlCount == 1 && (power == 0 || power == 2);
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::isClifford(std::span<const size_t> table, const size_t &controlCount) {
+    std::vector<size_t> positions;
+    return controlCount == 0 && getQubitPermutation(table, positions);
+}
+
+template<std_floating_point FloatingNumberType>
+bool Tableau<FloatingNumberType>::isClifford(std::span<const Amplitude> phases) {
+    DiagonalDecomposition decomposition;
+    return decomposeDiagonal(phases, decomposition);
+}
+
+template<std_floating_point FloatingNumberType>
+std::string Tableau<FloatingNumberType>::getRepresentation() const {
+    std::string representation;
+    for(size_t i = 0; i < qubitCount; i++){
+        if(i > 0){
+            representation += "\n";
+        }
+        representation += getStabilizer(i);
+    }
+    return representation;
+}
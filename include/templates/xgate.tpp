@@ -30,18 +30,15 @@ std::string Circuit<FloatingNumberType>::CXGate::getRepresentation() const {
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::XGate::apply(Circuit<FloatingNumberType> *circuit) {
-    auto& targetQubit = circuit->qubits[SingleTargetGate::qubitIndex];
-    const auto newAlpha = targetQubit.getState().getBeta();
-    const auto newBeta = targetQubit.getState().getAlpha();
-    targetQubit.setState(newAlpha, newBeta);
+void Circuit<FloatingNumberType>::XGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    program.addX(circuit->resolveQubit(SingleTargetGate::qubitIndex), circuit->controls);
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::CXGate::apply(Circuit<FloatingNumberType> *circuit) {
-    if(Circuit<FloatingNumberType>::ControlledGate::getControlState(circuit)) {
-        Circuit<FloatingNumberType>::XGate::apply(circuit);
-    }
+void Circuit<FloatingNumberType>::CXGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    const size_t previousControlCount = circuit->pushControl(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    Circuit<FloatingNumberType>::XGate::compile(circuit, program);
+    circuit->popControl(previousControlCount);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -56,7 +53,7 @@ std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumb
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::XGate::verify(const Circuit* circuit) const {
-    if(SingleTargetGate::qubitIndex >= circuit->qubits.size()){
+    if(SingleTargetGate::qubitIndex >= circuit->getQubitCount()){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(SingleTargetGate::qubitIndex);
     }
 }
@@ -65,4 +62,62 @@ template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::CXGate::verify(const Circuit* circuit) const {
     Circuit<FloatingNumberType>::ControlledGate::verify(circuit);
     Circuit<FloatingNumberType>::XGate::verify(circuit);
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::CXGate::getQubitIndices() const {
+    return {Circuit<FloatingNumberType>::ControlledGate::controlIndex, Circuit<FloatingNumberType>::XGate::qubitIndex};
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CXGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    Circuit<FloatingNumberType>::ControlledGate::controlIndex = qubitMap[Circuit<FloatingNumberType>::ControlledGate::controlIndex];
+    Circuit<FloatingNumberType>::SingleTargetGate::remapQubits(qubitMap);
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::XGate::isPermutation() const {
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::XGate::permuteBasisState(const size_t &basisState) const {
+    return basisState ^ (size_t(1) << SingleTargetGate::qubitIndex);
+}
+
+template<std_floating_point FloatingNumberType>
+bool Circuit<FloatingNumberType>::CXGate::isPermutation() const {
+    return true;
+}
+
+template<std_floating_point FloatingNumberType>
+size_t Circuit<FloatingNumberType>::CXGate::permuteBasisState(const size_t &basisState) const {
+    if(((basisState >> Circuit<FloatingNumberType>::ControlledGate::controlIndex) & 1) == 0){
+        return basisState;
+    }
+    return Circuit<FloatingNumberType>::XGate::permuteBasisState(basisState);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::XGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::X);
+    encoder.writeWord(SingleTargetGate::qubitIndex);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::XGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("x", {SingleTargetGate::qubitIndex});
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CXGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::CX);
+    encoder.writeWord(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    encoder.writeWord(Circuit<FloatingNumberType>::XGate::qubitIndex);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CXGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("cx", {Circuit<FloatingNumberType>::ControlledGate::controlIndex,
+                                 Circuit<FloatingNumberType>::XGate::qubitIndex});
+}
@@ -1,7 +1,7 @@
 template<std_floating_point FloatingNumberType>
 typename Circuit<FloatingNumberType>::Gate::Drawings Circuit<FloatingNumberType>::CYGate::getDrawings(
         const Circuit<FloatingNumberType> *circuit) const {
-    return Circuit<FloatingNumberType>::ControlledGate::getStandardDrawing(circuit, "Y", XGate::qubitIndex);
+    return Circuit<FloatingNumberType>::ControlledGate::getStandardDrawing(circuit, "Y", YGate::qubitIndex);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -14,7 +14,10 @@ template<std_floating_point FloatingNumberType>
 Circuit<FloatingNumberType>::YGate::YGate(const size_t &qubitIndex): SingleTargetGate(qubitIndex) {}
 
 template<std_floating_point FloatingNumberType>
-Circuit<FloatingNumberType>::CYGate::CYGate(const size_t &controlQubitIndex, const size_t &qubitIndex): Circuit<FloatingNumberType>::ControlledGate(controlQubitIndex), Circuit<FloatingNumberType>::XGate(qubitIndex) {}
+Circuit<FloatingNumberType>::CYGate::CYGate(const size_t &controlQubitIndex, const size_t &qubitIndex):
+Circuit<FloatingNumberType>::SingleTargetGate(qubitIndex),
+Circuit<FloatingNumberType>::ControlledGate(controlQubitIndex),
+Circuit<FloatingNumberType>::YGate(qubitIndex) {}
 
 template<std_floating_point FloatingNumberType>
 std::string Circuit<FloatingNumberType>::YGate::getRepresentation() const {
@@ -23,22 +26,20 @@ std::string Circuit<FloatingNumberType>::YGate::getRepresentation() const {
 
 template<std_floating_point FloatingNumberType>
 std::string Circuit<FloatingNumberType>::CYGate::getRepresentation() const {
-    return "CY[Q#" + std::to_string(Circuit<FloatingNumberType>::ControlledGate::controlIndex) + " ⇏ Q#" + std::to_string(Circuit<FloatingNumberType>::XGate::qubitIndex) + "]";
+    return "CY[Q#" + std::to_string(Circuit<FloatingNumberType>::ControlledGate::controlIndex) + " ⇏ Q#" + std::to_string(Circuit<FloatingNumberType>::YGate::qubitIndex) + "]";
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::YGate::apply(Circuit<FloatingNumberType> *circuit) {
-    auto& targetQubit = circuit->qubits[SingleTargetGate::qubitIndex];
-    const auto newAlpha = targetQubit.getState().getBeta();
-    const auto newBeta = -targetQubit.getState().getAlpha();
-    targetQubit.setState(newAlpha, newBeta);
+void Circuit<FloatingNumberType>::YGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    const std::complex<FloatingNumberType> i(0, 1);
+    program.addMatrix(circuit->resolveQubit(SingleTargetGate::qubitIndex), {0, -i, i, 0}, circuit->controls);
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::CYGate::apply(Circuit<FloatingNumberType> *circuit) {
-    if(Circuit<FloatingNumberType>::ControlledGate::getControlState(circuit)) {
-        Circuit<FloatingNumberType>::YGate::apply(circuit);
-    }
+void Circuit<FloatingNumberType>::CYGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    const size_t previousControlCount = circuit->pushControl(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    Circuit<FloatingNumberType>::YGate::compile(circuit, program);
+    circuit->popControl(previousControlCount);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -53,7 +54,7 @@ std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumb
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::YGate::verify(const Circuit* circuit) const {
-    if(SingleTargetGate::qubitIndex >= circuit->qubits.size()){
+    if(SingleTargetGate::qubitIndex >= circuit->getQubitCount()){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(SingleTargetGate::qubitIndex);
     }
 }
@@ -62,4 +63,39 @@ template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::CYGate::verify(const Circuit* circuit) const {
     Circuit<FloatingNumberType>::ControlledGate::verify(circuit);
     Circuit<FloatingNumberType>::YGate::verify(circuit);
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::CYGate::getQubitIndices() const {
+    return {Circuit<FloatingNumberType>::ControlledGate::controlIndex, Circuit<FloatingNumberType>::YGate::qubitIndex};
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CYGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    Circuit<FloatingNumberType>::ControlledGate::controlIndex = qubitMap[Circuit<FloatingNumberType>::ControlledGate::controlIndex];
+    Circuit<FloatingNumberType>::SingleTargetGate::remapQubits(qubitMap);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::YGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::Y);
+    encoder.writeWord(SingleTargetGate::qubitIndex);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::YGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("y", {SingleTargetGate::qubitIndex});
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CYGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::CY);
+    encoder.writeWord(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    encoder.writeWord(Circuit<FloatingNumberType>::YGate::qubitIndex);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CYGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("cy", {Circuit<FloatingNumberType>::ControlledGate::controlIndex,
+                                 Circuit<FloatingNumberType>::YGate::qubitIndex});
+}
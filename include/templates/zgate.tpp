@@ -14,7 +14,10 @@ template<std_floating_point FloatingNumberType>
 Circuit<FloatingNumberType>::ZGate::ZGate(const size_t &qubitIndex): SingleTargetGate(qubitIndex) {}
 
 template<std_floating_point FloatingNumberType>
-Circuit<FloatingNumberType>::CZGate::CZGate(const size_t &controlQubitIndex, const size_t &qubitIndex): Circuit<FloatingNumberType>::ControlledGate(controlQubitIndex), Circuit<FloatingNumberType>::ZGate(qubitIndex) {}
+Circuit<FloatingNumberType>::CZGate::CZGate(const size_t &controlQubitIndex, const size_t &qubitIndex):
+Circuit<FloatingNumberType>::SingleTargetGate(qubitIndex),
+Circuit<FloatingNumberType>::ControlledGate(controlQubitIndex),
+Circuit<FloatingNumberType>::ZGate(qubitIndex) {}
 
 template<std_floating_point FloatingNumberType>
 std::string Circuit<FloatingNumberType>::ZGate::getRepresentation() const {
@@ -27,17 +30,15 @@ std::string Circuit<FloatingNumberType>::CZGate::getRepresentation() const {
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::ZGate::apply(Circuit<FloatingNumberType> *circuit) {
-    auto& targetQubit = circuit->qubits[SingleTargetGate::qubitIndex];
-    const auto newBeta = -targetQubit.getState().getBeta();
-    targetQubit.setState(targetQubit.getState().getAlpha(), newBeta);
+void Circuit<FloatingNumberType>::ZGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    program.addPhase(circuit->resolveQubit(SingleTargetGate::qubitIndex), -1, circuit->controls);
 }
 
 template<std_floating_point FloatingNumberType>
-void Circuit<FloatingNumberType>::CZGate::apply(Circuit<FloatingNumberType> *circuit) {
-    if(Circuit<FloatingNumberType>::ControlledGate::getControlState(circuit)) {
-        Circuit<FloatingNumberType>::ZGate::apply(circuit);
-    }
+void Circuit<FloatingNumberType>::CZGate::compile(Circuit<FloatingNumberType> *circuit, Program<FloatingNumberType> &program) const {
+    const size_t previousControlCount = circuit->pushControl(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    Circuit<FloatingNumberType>::ZGate::compile(circuit, program);
+    circuit->popControl(previousControlCount);
 }
 
 template<std_floating_point FloatingNumberType>
@@ -52,7 +53,7 @@ std::unique_ptr<typename Circuit<FloatingNumberType>::Gate> Circuit<FloatingNumb
 
 template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::ZGate::verify(const Circuit* circuit) const {
-    if(SingleTargetGate::qubitIndex >= circuit->qubits.size()){
+    if(SingleTargetGate::qubitIndex >= circuit->getQubitCount()){
         throw Circuit<FloatingNumberType>::InvalidQubitIndexException(SingleTargetGate::qubitIndex);
     }
 }
@@ -61,4 +62,39 @@ template<std_floating_point FloatingNumberType>
 void Circuit<FloatingNumberType>::CZGate::verify(const Circuit* circuit) const {
     Circuit<FloatingNumberType>::ControlledGate::verify(circuit);
     Circuit<FloatingNumberType>::ZGate::verify(circuit);
-}
\ No newline at end of file
+}
+
+template<std_floating_point FloatingNumberType>
+std::vector<size_t> Circuit<FloatingNumberType>::CZGate::getQubitIndices() const {
+    return {Circuit<FloatingNumberType>::ControlledGate::controlIndex, Circuit<FloatingNumberType>::ZGate::qubitIndex};
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CZGate::remapQubits(const std::vector<size_t> &qubitMap) {
+    Circuit<FloatingNumberType>::ControlledGate::controlIndex = qubitMap[Circuit<FloatingNumberType>::ControlledGate::controlIndex];
+    Circuit<FloatingNumberType>::SingleTargetGate::remapQubits(qubitMap);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::ZGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::Z);
+    encoder.writeWord(SingleTargetGate::qubitIndex);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::ZGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("z", {SingleTargetGate::qubitIndex});
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CZGate::encode(Encoder &encoder) const {
+    encoder.writeWord(Encoder::CZ);
+    encoder.writeWord(Circuit<FloatingNumberType>::ControlledGate::controlIndex);
+    encoder.writeWord(Circuit<FloatingNumberType>::ZGate::qubitIndex);
+}
+
+template<std_floating_point FloatingNumberType>
+void Circuit<FloatingNumberType>::CZGate::writeQASM(QASMWriter &writer) const {
+    writer.writeOperation("cz", {Circuit<FloatingNumberType>::ControlledGate::controlIndex,
+                                 Circuit<FloatingNumberType>::ZGate::qubitIndex});
+}
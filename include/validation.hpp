@@ -0,0 +1,37 @@
+/// @file validation.hpp
+/// @brief This file contains the compile-time validation policy.
+///
+/// The policy is selected with the QPP_VALIDATION macro (the QPP_VALIDATION CMake option), set to one of the
+/// ValidationPolicy values. It defaults to CHECKED.
+///
+/// @author Mario Deaconescu
+
+#pragma once
+
+namespace QPP {
+
+/// @brief Selects which runtime checks are compiled in.
+///
+/// The checks covered by the policy are the normalization of Qubit::State and the verification of the gates added
+/// to a Circuit. With UNCHECKED, invalid states and out-of-range qubit or classic bit indices are undefined behaviour.
+    enum class ValidationPolicy {
+        CHECKED,    /**< Always validate. */
+        DEBUG_ONLY, /**< Validate unless NDEBUG is defined. */
+        UNCHECKED   /**< Never validate. */
+    };
+
+#ifndef QPP_VALIDATION
+#define QPP_VALIDATION CHECKED
+#endif
+
+    /// @brief The validation policy of the build.
+    inline constexpr ValidationPolicy VALIDATION_POLICY = ValidationPolicy::QPP_VALIDATION;
+
+    /// @brief Whether the checks covered by the validation policy are compiled in.
+#ifdef NDEBUG
+    inline constexpr bool VALIDATION_ENABLED = VALIDATION_POLICY == ValidationPolicy::CHECKED;
+#else
+    inline constexpr bool VALIDATION_ENABLED = VALIDATION_POLICY != ValidationPolicy::UNCHECKED;
+#endif
+
+}
@@ -0,0 +1,142 @@
+#include "../include/histogram.hpp"
+
+#include <algorithm>
+
+namespace QPP {
+
+    namespace {
+        constexpr std::size_t INITIAL_CAPACITY = 64;
+
+        /// \brief Mixes the words of a key (splitmix64 finalizer)
+        std::uint64_t hashKey(std::span<const std::uint64_t> key) {
+            std::uint64_t hash = 0;
+            for (const auto &word: key) {
+                hash ^= word + 0x9E3779B97F4A7C15 + (hash << 6) + (hash >> 2);
+                hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+                hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+                hash ^= hash >> 31;
+            }
+            return hash;
+        }
+    }
+
+    Histogram::Histogram(const std::size_t &bitCount) :
+            bitCount(bitCount),
+            wordCount(std::max<std::size_t>((bitCount + 63) / 64, 1)),
+            total(0),
+            usedSlots(0) {}
+
+    std::size_t Histogram::getBitCount() const {
+        return bitCount;
+    }
+
+    std::size_t Histogram::getWordCount() const {
+        return wordCount;
+    }
+
+    bool Histogram::isDense() const {
+        return bitCount <= DENSE_BIT_LIMIT;
+    }
+
+    std::size_t Histogram::findSlot(std::span<const std::uint64_t> key) const {
+        const std::size_t mask = counts.size() - 1;
+        for (std::size_t slot = hashKey(key) & mask;; slot = (slot + 1) & mask) {
+            if (counts[slot] == 0 || std::equal(key.begin(), key.end(), keys.begin() + slot * wordCount)) {
+                return slot;
+            }
+        }
+    }
+
+    void Histogram::grow() {
+        const std::vector<std::size_t> oldCounts = std::move(counts);
+        const std::vector<std::uint64_t> oldKeys = std::move(keys);
+        counts.assign(std::max(2 * oldCounts.size(), INITIAL_CAPACITY), 0);
+        keys.assign(counts.size() * wordCount, 0);
+        for (std::size_t slot = 0; slot < oldCounts.size(); slot++) {
+            if (oldCounts[slot] != 0) {
+                std::span<const std::uint64_t> key(oldKeys.data() + slot * wordCount, wordCount);
+                const std::size_t newSlot = findSlot(key);
+                counts[newSlot] = oldCounts[slot];
+                std::copy(key.begin(), key.end(), keys.begin() + newSlot * wordCount);
+            }
+        }
+    }
+
+    void Histogram::add(std::span<const std::uint64_t> key, const std::size_t &count) {
+        if (count == 0) {
+            return;
+        }
+        total += count;
+        if (isDense()) {
+            if (counts.empty()) {
+                counts.assign(std::size_t(1) << bitCount, 0);
+            }
+            counts[key[0]] += count;
+            return;
+        }
+        // Keep the load factor under 1/2
+        if (2 * (usedSlots + 1) > counts.size()) {
+            grow();
+        }
+        const std::size_t slot = findSlot(key);
+        if (counts[slot] == 0) {
+            usedSlots++;
+            std::copy(key.begin(), key.end(), keys.begin() + slot * wordCount);
+        }
+        counts[slot] += count;
+    }
+
+    std::size_t Histogram::getCount(std::span<const std::uint64_t> key) const {
+        if (counts.empty()) {
+            return 0;
+        }
+        return isDense() ? counts[key[0]] : counts[findSlot(key)];
+    }
+
+    std::size_t Histogram::getTotal() const {
+        return total;
+    }
+
+    std::vector<std::pair<std::vector<std::uint64_t>, std::size_t>> Histogram::getEntries() const {
+        std::vector<std::pair<std::vector<std::uint64_t>, std::size_t>> entries;
+        for (std::size_t i = 0; i < counts.size(); i++) {
+            if (counts[i] == 0) {
+                continue;
+            }
+            if (isDense()) {
+                entries.emplace_back(std::vector<std::uint64_t>{i}, counts[i]);
+            } else {
+                entries.emplace_back(std::vector<std::uint64_t>(keys.begin() + i * wordCount, keys.begin() + (i + 1) * wordCount), counts[i]);
+            }
+        }
+        if (!isDense()) {
+            // The most significant word comes last
+            std::sort(entries.begin(), entries.end(), [](const auto &first, const auto &second) {
+                return std::lexicographical_compare(first.first.rbegin(), first.first.rend(), second.first.rbegin(), second.first.rend());
+            });
+        }
+        return entries;
+    }
+
+    Histogram &Histogram::operator+=(const Histogram &other) {
+        if (isDense()) {
+            if (!other.counts.empty() && counts.empty()) {
+                counts = other.counts;
+                total += other.total;
+                return *this;
+            }
+            for (std::size_t i = 0; i < other.counts.size(); i++) {
+                counts[i] += other.counts[i];
+            }
+            total += other.total;
+            return *this;
+        }
+        for (std::size_t slot = 0; slot < other.counts.size(); slot++) {
+            if (other.counts[slot] != 0) {
+                add(std::span<const std::uint64_t>(other.keys.data() + slot * wordCount, wordCount), other.counts[slot]);
+            }
+        }
+        return *this;
+    }
+
+}
@@ -0,0 +1,350 @@
+#include "../include/kernels.hpp"
+
+#include <algorithm>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define QPP_X86_KERNELS
+#include <immintrin.h>
+#define QPP_TARGET(features) __attribute__((target(features)))
+#endif
+
+namespace QPP {
+
+    namespace {
+        size_t insertZeroBit(const size_t &index, const size_t &position) {
+            const size_t lowMask = (size_t(1) << position) - 1;
+            return ((index & ~lowMask) << 1) | (index & lowMask);
+        }
+
+        void applyMatrixScalar(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &target,
+                               const Kernels::Matrix &matrix, const size_t &controlMask) {
+            const size_t targetBit = size_t(1) << target;
+            for (size_t k = 0; k < size / 2; k++) {
+                const size_t i0 = insertZeroBit(k, target);
+                if ((i0 & controlMask) != controlMask) {
+                    continue;
+                }
+                const size_t i1 = i0 | targetBit;
+                const Kernels::Amplitude a0 = amplitudes[i0];
+                const Kernels::Amplitude a1 = amplitudes[i1];
+                amplitudes[i0] = matrix[0] * a0 + matrix[1] * a1;
+                amplitudes[i1] = matrix[2] * a0 + matrix[3] * a1;
+            }
+        }
+
+        void applyPhaseScalar(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &mask,
+                              const Kernels::Amplitude &phase) {
+            for (size_t i = 0; i < size; i++) {
+                if ((i & mask) == mask) {
+                    amplitudes[i] *= phase;
+                }
+            }
+        }
+
+        void applyDiagonalScalar(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &lowestQubit,
+                                 const Kernels::Amplitude *phases, const size_t &phaseCount) {
+            for (size_t i = 0; i < size; i++) {
+                amplitudes[i] *= phases[(i >> lowestQubit) & (phaseCount - 1)];
+            }
+        }
+
+#ifdef QPP_X86_KERNELS
+        // Complex products on interleaved (real, imaginary) lanes:
+        // m * a = (mr * ar - mi * ai, mr * ai + mi * ar) = fmaddsub(mr, a, mi * swap(a))
+
+        QPP_TARGET("sse3")
+        __m128d multiplySse(const __m128d &real, const __m128d &imaginary, const __m128d &value) {
+            return _mm_addsub_pd(_mm_mul_pd(real, value), _mm_mul_pd(imaginary, _mm_shuffle_pd(value, value, 1)));
+        }
+
+        QPP_TARGET("sse3")
+        void applyMatrixSse(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &target,
+                            const Kernels::Matrix &matrix, const size_t &controlMask) {
+            __m128d real[4];
+            __m128d imaginary[4];
+            for (size_t i = 0; i < 4; i++) {
+                real[i] = _mm_set1_pd(matrix[i].real());
+                imaginary[i] = _mm_set1_pd(matrix[i].imag());
+            }
+            auto *data = reinterpret_cast<double *>(amplitudes);
+            const size_t targetBit = size_t(1) << target;
+            for (size_t k = 0; k < size / 2; k++) {
+                const size_t i0 = insertZeroBit(k, target);
+                if ((i0 & controlMask) != controlMask) {
+                    continue;
+                }
+                const size_t i1 = i0 | targetBit;
+                const __m128d a0 = _mm_loadu_pd(data + 2 * i0);
+                const __m128d a1 = _mm_loadu_pd(data + 2 * i1);
+                _mm_storeu_pd(data + 2 * i0, _mm_add_pd(multiplySse(real[0], imaginary[0], a0),
+                                                        multiplySse(real[1], imaginary[1], a1)));
+                _mm_storeu_pd(data + 2 * i1, _mm_add_pd(multiplySse(real[2], imaginary[2], a0),
+                                                        multiplySse(real[3], imaginary[3], a1)));
+            }
+        }
+
+        QPP_TARGET("sse3")
+        void applyPhaseSse(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &mask,
+                           const Kernels::Amplitude &phase) {
+            const __m128d real = _mm_set1_pd(phase.real());
+            const __m128d imaginary = _mm_set1_pd(phase.imag());
+            auto *data = reinterpret_cast<double *>(amplitudes);
+            for (size_t i = 0; i < size; i++) {
+                if ((i & mask) == mask) {
+                    _mm_storeu_pd(data + 2 * i, multiplySse(real, imaginary, _mm_loadu_pd(data + 2 * i)));
+                }
+            }
+        }
+
+        QPP_TARGET("sse3")
+        void applyDiagonalSse(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &lowestQubit,
+                              const Kernels::Amplitude *phases, const size_t &phaseCount) {
+            auto *data = reinterpret_cast<double *>(amplitudes);
+            const auto *phaseData = reinterpret_cast<const double *>(phases);
+            for (size_t i = 0; i < size; i++) {
+                const __m128d phase = _mm_loadu_pd(phaseData + 2 * ((i >> lowestQubit) & (phaseCount - 1)));
+                _mm_storeu_pd(data + 2 * i, multiplySse(_mm_movedup_pd(phase), _mm_unpackhi_pd(phase, phase),
+                                                        _mm_loadu_pd(data + 2 * i)));
+            }
+        }
+
+        QPP_TARGET("avx2,fma")
+        __m256d multiplyAvx2(const __m256d &real, const __m256d &imaginary, const __m256d &value) {
+            return _mm256_fmaddsub_pd(real, value, _mm256_mul_pd(imaginary, _mm256_permute_pd(value, 0b0101)));
+        }
+
+        QPP_TARGET("avx2,fma")
+        void applyMatrixAvx2(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &target,
+                             const Kernels::Matrix &matrix, const size_t &controlMask) {
+            __m256d real[4];
+            __m256d imaginary[4];
+            for (size_t i = 0; i < 4; i++) {
+                real[i] = _mm256_set1_pd(matrix[i].real());
+                imaginary[i] = _mm256_set1_pd(matrix[i].imag());
+            }
+            auto *data = reinterpret_cast<double *>(amplitudes);
+            const size_t targetBit = size_t(1) << target;
+            // The target is at least qubit 1 and qubit 0 is not a control, so pairs k and k + 1 are adjacent
+            // and share their control bits
+            for (size_t k = 0; k < size / 2; k += 2) {
+                const size_t i0 = insertZeroBit(k, target);
+                if ((i0 & controlMask) != controlMask) {
+                    continue;
+                }
+                const size_t i1 = i0 | targetBit;
+                const __m256d a0 = _mm256_loadu_pd(data + 2 * i0);
+                const __m256d a1 = _mm256_loadu_pd(data + 2 * i1);
+                _mm256_storeu_pd(data + 2 * i0, _mm256_add_pd(multiplyAvx2(real[0], imaginary[0], a0),
+                                                              multiplyAvx2(real[1], imaginary[1], a1)));
+                _mm256_storeu_pd(data + 2 * i1, _mm256_add_pd(multiplyAvx2(real[2], imaginary[2], a0),
+                                                              multiplyAvx2(real[3], imaginary[3], a1)));
+            }
+        }
+
+        QPP_TARGET("avx2,fma")
+        void applyPhaseAvx2(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &mask,
+                            const Kernels::Amplitude &phase) {
+            const __m256d real = _mm256_set1_pd(phase.real());
+            const __m256d imaginary = _mm256_set1_pd(phase.imag());
+            auto *data = reinterpret_cast<double *>(amplitudes);
+            for (size_t i = 0; i < size; i += 2) {
+                if ((i & mask) == mask) {
+                    _mm256_storeu_pd(data + 2 * i, multiplyAvx2(real, imaginary, _mm256_loadu_pd(data + 2 * i)));
+                }
+            }
+        }
+
+        QPP_TARGET("avx2,fma")
+        void applyDiagonalAvx2(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &lowestQubit,
+                               const Kernels::Amplitude *phases, const size_t &phaseCount) {
+            auto *data = reinterpret_cast<double *>(amplitudes);
+            const auto *phaseData = reinterpret_cast<const double *>(phases);
+            for (size_t i = 0; i < size; i += 2) {
+                const __m256d phase = _mm256_set_m128d(
+                        _mm_loadu_pd(phaseData + 2 * (((i + 1) >> lowestQubit) & (phaseCount - 1))),
+                        _mm_loadu_pd(phaseData + 2 * ((i >> lowestQubit) & (phaseCount - 1))));
+                _mm256_storeu_pd(data + 2 * i, multiplyAvx2(_mm256_movedup_pd(phase), _mm256_permute_pd(phase, 0b1111),
+                                                            _mm256_loadu_pd(data + 2 * i)));
+            }
+        }
+
+        QPP_TARGET("avx512f")
+        __m512d multiplyAvx512(const __m512d &real, const __m512d &imaginary, const __m512d &value) {
+            return _mm512_fmaddsub_pd(real, value, _mm512_mul_pd(imaginary, _mm512_shuffle_pd(value, value, 0b01010101)));
+        }
+
+        QPP_TARGET("avx512f")
+        void applyMatrixAvx512(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &target,
+                               const Kernels::Matrix &matrix, const size_t &controlMask) {
+            __m512d real[4];
+            __m512d imaginary[4];
+            for (size_t i = 0; i < 4; i++) {
+                real[i] = _mm512_set1_pd(matrix[i].real());
+                imaginary[i] = _mm512_set1_pd(matrix[i].imag());
+            }
+            auto *data = reinterpret_cast<double *>(amplitudes);
+            const size_t targetBit = size_t(1) << target;
+            for (size_t k = 0; k < size / 2; k += 4) {
+                const size_t i0 = insertZeroBit(k, target);
+                if ((i0 & controlMask) != controlMask) {
+                    continue;
+                }
+                const size_t i1 = i0 | targetBit;
+                const __m512d a0 = _mm512_loadu_pd(data + 2 * i0);
+                const __m512d a1 = _mm512_loadu_pd(data + 2 * i1);
+                _mm512_storeu_pd(data + 2 * i0, _mm512_add_pd(multiplyAvx512(real[0], imaginary[0], a0),
+                                                              multiplyAvx512(real[1], imaginary[1], a1)));
+                _mm512_storeu_pd(data + 2 * i1, _mm512_add_pd(multiplyAvx512(real[2], imaginary[2], a0),
+                                                              multiplyAvx512(real[3], imaginary[3], a1)));
+            }
+        }
+
+        QPP_TARGET("avx512f")
+        void applyPhaseAvx512(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &mask,
+                              const Kernels::Amplitude &phase) {
+            const __m512d real = _mm512_set1_pd(phase.real());
+            const __m512d imaginary = _mm512_set1_pd(phase.imag());
+            auto *data = reinterpret_cast<double *>(amplitudes);
+            for (size_t i = 0; i < size; i += 4) {
+                if ((i & mask) == mask) {
+                    _mm512_storeu_pd(data + 2 * i, multiplyAvx512(real, imaginary, _mm512_loadu_pd(data + 2 * i)));
+                }
+            }
+        }
+
+        QPP_TARGET("avx512f")
+        void applyDiagonalAvx512(Kernels::Amplitude *amplitudes, const size_t &size, const size_t &lowestQubit,
+                                 const Kernels::Amplitude *phases, const size_t &phaseCount) {
+            auto *data = reinterpret_cast<double *>(amplitudes);
+            for (size_t i = 0; i < size; i += 4) {
+                const Kernels::Amplitude &p0 = phases[(i >> lowestQubit) & (phaseCount - 1)];
+                const Kernels::Amplitude &p1 = phases[((i + 1) >> lowestQubit) & (phaseCount - 1)];
+                const Kernels::Amplitude &p2 = phases[((i + 2) >> lowestQubit) & (phaseCount - 1)];
+                const Kernels::Amplitude &p3 = phases[((i + 3) >> lowestQubit) & (phaseCount - 1)];
+                const __m512d phase = _mm512_set_pd(p3.imag(), p3.real(), p2.imag(), p2.real(),
+                                                    p1.imag(), p1.real(), p0.imag(), p0.real());
+                _mm512_storeu_pd(data + 2 * i, multiplyAvx512(_mm512_shuffle_pd(phase, phase, 0b00000000),
+                                                              _mm512_shuffle_pd(phase, phase, 0b11111111),
+                                                              _mm512_loadu_pd(data + 2 * i)));
+            }
+        }
+#endif
+
+        /// \brief Gets the number of amplitudes processed at once by a variant
+        size_t getWidth(const Kernels::Level &level) {
+            return level == Kernels::AVX512 ? 4 : level == Kernels::AVX2 ? 2 : 1;
+        }
+    }
+
+    Kernels::Level Kernels::level = Kernels::getSupportedLevel();
+
+    Kernels::Level Kernels::getSupportedLevel() {
+#ifdef QPP_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return AVX512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return AVX2;
+        }
+        if (__builtin_cpu_supports("sse3")) {
+            return SSE;
+        }
+#endif
+        return SCALAR;
+    }
+
+    Kernels::Level Kernels::getLevel() {
+        return level;
+    }
+
+    void Kernels::setLevel(const Level &level_) {
+        level = std::min(level_, getSupportedLevel());
+    }
+
+    const char *Kernels::getLevelName(const Level &level_) {
+        switch (level_) {
+            case SSE:
+                return "sse";
+            case AVX2:
+                return "avx2";
+            case AVX512:
+                return "avx512";
+            default:
+                return "scalar";
+        }
+    }
+
+    void Kernels::applyMatrix(Amplitude *amplitudes, const size_t &size, const size_t &target, const Matrix &matrix,
+                              const size_t &controlMask, const Level &level_) {
+        Level usedLevel = std::min(level_, getSupportedLevel());
+        // Fall back to narrower vectors when the lowest qubits do not line up with the vector width
+        while (usedLevel > SSE && ((size_t(1) << target) < getWidth(usedLevel) ||
+                                   (controlMask & (getWidth(usedLevel) - 1)) != 0 ||
+                                   size < 2 * getWidth(usedLevel))) {
+            usedLevel = static_cast<Level>(usedLevel - 1);
+        }
+        switch (usedLevel) {
+#ifdef QPP_X86_KERNELS
+            case AVX512:
+                applyMatrixAvx512(amplitudes, size, target, matrix, controlMask);
+                return;
+            case AVX2:
+                applyMatrixAvx2(amplitudes, size, target, matrix, controlMask);
+                return;
+            case SSE:
+                applyMatrixSse(amplitudes, size, target, matrix, controlMask);
+                return;
+#endif
+            default:
+                applyMatrixScalar(amplitudes, size, target, matrix, controlMask);
+        }
+    }
+
+    void Kernels::applyPhase(Amplitude *amplitudes, const size_t &size, const size_t &mask, const Amplitude &phase,
+                             const Level &level_) {
+        Level usedLevel = std::min(level_, getSupportedLevel());
+        while (usedLevel > SSE && ((mask & (getWidth(usedLevel) - 1)) != 0 || size < getWidth(usedLevel))) {
+            usedLevel = static_cast<Level>(usedLevel - 1);
+        }
+        switch (usedLevel) {
+#ifdef QPP_X86_KERNELS
+            case AVX512:
+                applyPhaseAvx512(amplitudes, size, mask, phase);
+                return;
+            case AVX2:
+                applyPhaseAvx2(amplitudes, size, mask, phase);
+                return;
+            case SSE:
+                applyPhaseSse(amplitudes, size, mask, phase);
+                return;
+#endif
+            default:
+                applyPhaseScalar(amplitudes, size, mask, phase);
+        }
+    }
+
+    void Kernels::applyDiagonal(Amplitude *amplitudes, const size_t &size, const size_t &lowestQubit,
+                                const Amplitude *phases, const size_t &phaseCount, const Level &level_) {
+        Level usedLevel = std::min(level_, getSupportedLevel());
+        while (usedLevel > SSE && size < getWidth(usedLevel)) {
+            usedLevel = static_cast<Level>(usedLevel - 1);
+        }
+        switch (usedLevel) {
+#ifdef QPP_X86_KERNELS
+            case AVX512:
+                applyDiagonalAvx512(amplitudes, size, lowestQubit, phases, phaseCount);
+                return;
+            case AVX2:
+                applyDiagonalAvx2(amplitudes, size, lowestQubit, phases, phaseCount);
+                return;
+            case SSE:
+                applyDiagonalSse(amplitudes, size, lowestQubit, phases, phaseCount);
+                return;
+#endif
+            default:
+                applyDiagonalScalar(amplitudes, size, lowestQubit, phases, phaseCount);
+        }
+    }
+
+}
@@ -0,0 +1,69 @@
+#include "../include/philox.hpp"
+
+namespace QPP {
+
+    namespace {
+        constexpr std::uint32_t MULTIPLIER_0 = 0xD2511F53;
+        constexpr std::uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+        constexpr std::uint32_t WEYL_0 = 0x9E3779B9;
+        constexpr std::uint32_t WEYL_1 = 0xBB67AE85;
+        constexpr int ROUNDS = 10;
+    }
+
+    Philox::Philox(const std::uint64_t &key, const std::uint64_t &stream) :
+            key({static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32)}),
+            counter({0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)}),
+            buffer({0, 0}),
+            bufferPosition(2) {}
+
+    Philox::result_type Philox::operator()() {
+        if (bufferPosition == 2) {
+            generateBlock();
+        }
+        return buffer[bufferPosition++];
+    }
+
+    void Philox::seek(const std::uint64_t &block) {
+        counter[0] = static_cast<std::uint32_t>(block);
+        counter[1] = static_cast<std::uint32_t>(block >> 32);
+        bufferPosition = 2;
+    }
+
+    void Philox::discard(const std::uint64_t &count) {
+        // The counter holds the block after the buffered one, so the next output is at 2 * counter - 2 + bufferPosition
+        const std::uint64_t block = static_cast<std::uint64_t>(counter[1]) << 32 | counter[0];
+        const std::uint64_t position = 2 * block - 2 + bufferPosition + count;
+        seek(position / 2);
+        if (position % 2 != 0) {
+            generateBlock();
+            bufferPosition = 1;
+        }
+    }
+
+    std::uint64_t Philox::getStream() const {
+        return static_cast<std::uint64_t>(counter[3]) << 32 | counter[2];
+    }
+
+    void Philox::generateBlock() {
+        std::array<std::uint32_t, 4> state = counter;
+        std::array<std::uint32_t, 2> roundKey = key;
+        for (int round = 0; round < ROUNDS; round++) {
+            const std::uint64_t product0 = static_cast<std::uint64_t>(MULTIPLIER_0) * state[0];
+            const std::uint64_t product1 = static_cast<std::uint64_t>(MULTIPLIER_1) * state[2];
+            state = {static_cast<std::uint32_t>(product1 >> 32) ^ state[1] ^ roundKey[0],
+                     static_cast<std::uint32_t>(product1),
+                     static_cast<std::uint32_t>(product0 >> 32) ^ state[3] ^ roundKey[1],
+                     static_cast<std::uint32_t>(product0)};
+            roundKey[0] += WEYL_0;
+            roundKey[1] += WEYL_1;
+        }
+        buffer[0] = static_cast<std::uint64_t>(state[1]) << 32 | state[0];
+        buffer[1] = static_cast<std::uint64_t>(state[3]) << 32 | state[2];
+        bufferPosition = 0;
+        // Advance the 64-bit block counter
+        if (++counter[0] == 0) {
+            counter[1]++;
+        }
+    }
+
+}
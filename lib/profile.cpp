@@ -0,0 +1,168 @@
+#include "../include/profile.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace QPP {
+
+    std::size_t Profile::getEntry(const std::string &symbol, const std::size_t &parent) {
+        std::vector<std::size_t> &siblings = parent == NO_PARENT ? roots : entries[parent].children;
+        for (const auto &sibling: siblings) {
+            if (entries[sibling].symbol == symbol) {
+                return sibling;
+            }
+        }
+        entries.push_back(Entry{symbol, parent, {}});
+        // entries may have been reallocated, so the siblings are looked up again
+        (parent == NO_PARENT ? roots : entries[parent].children).push_back(entries.size() - 1);
+        return entries.size() - 1;
+    }
+
+    const std::vector<Profile::Entry> &Profile::getEntries() const {
+        return entries;
+    }
+
+    const std::vector<std::size_t> &Profile::getRoots() const {
+        return roots;
+    }
+
+    std::chrono::nanoseconds Profile::getSelfTime(const std::size_t &entry) const {
+        std::chrono::nanoseconds selfTime = entries[entry].totalTime;
+        for (const auto &child: entries[entry].children) {
+            selfTime -= entries[child].totalTime;
+        }
+        return std::max(selfTime, std::chrono::nanoseconds(0));
+    }
+
+    std::chrono::nanoseconds Profile::getTotalTime() const {
+        return totalTime;
+    }
+
+    std::uint64_t Profile::getShotCount() const {
+        return shotCount;
+    }
+
+    void Profile::addRun(const Clock::time_point &start, const std::uint64_t &shots) {
+        totalTime += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+        shotCount += shots;
+    }
+
+    void Profile::enter(const std::size_t &entry, const std::uint64_t &draws, const std::uint64_t &measurements) {
+        frames.push_back(Frame{entry, Clock::now(), draws, measurements});
+    }
+
+    void Profile::leave(const std::uint64_t &draws, const std::uint64_t &measurements) {
+        const auto end = Clock::now();
+        const Frame frame = frames.back();
+        frames.pop_back();
+        Entry &entry = entries[frame.entry];
+        const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(end - frame.start);
+        entry.count++;
+        entry.totalTime += time;
+        entry.maxTime = std::max(entry.maxTime, time);
+        entry.draws += draws - frame.draws;
+        entry.measurements += measurements - frame.measurements;
+    }
+
+    Profile &Profile::operator+=(const Profile &other) {
+        // Parents are always added before their children, so they are mapped first
+        std::vector<std::size_t> mapping(other.entries.size());
+        for (std::size_t i = 0; i < other.entries.size(); i++) {
+            const Entry &source = other.entries[i];
+            mapping[i] = getEntry(source.symbol, source.parent == NO_PARENT ? NO_PARENT : mapping[source.parent]);
+            Entry &target = entries[mapping[i]];
+            target.count += source.count;
+            target.totalTime += source.totalTime;
+            target.maxTime = std::max(target.maxTime, source.maxTime);
+            target.measurements += source.measurements;
+            target.draws += source.draws;
+        }
+        totalTime += other.totalTime;
+        shotCount += other.shotCount;
+        return *this;
+    }
+
+    std::string Profile::getJSON() const {
+        std::string json = "{\"total_ns\": " + std::to_string(totalTime.count()) +
+                           ", \"shots\": " + std::to_string(shotCount) + ", \"gates\": [";
+        for (std::size_t i = 0; i < roots.size(); i++) {
+            json += i == 0 ? "" : ", ";
+            writeJSON(json, roots[i]);
+        }
+        return json + "]}";
+    }
+
+    void Profile::writeJSON(std::string &json, const std::size_t &entry) const {
+        const Entry &current = entries[entry];
+        // Symbols are plain ASCII, but quotes and backslashes are escaped anyway
+        std::string symbol;
+        for (const auto &character: current.symbol) {
+            if (character == '"' || character == '\\') {
+                symbol += '\\';
+            }
+            symbol += character;
+        }
+        json += "{\"symbol\": \"" + symbol + "\"" +
+                ", \"count\": " + std::to_string(current.count) +
+                ", \"total_ns\": " + std::to_string(current.totalTime.count()) +
+                ", \"self_ns\": " + std::to_string(getSelfTime(entry).count()) +
+                ", \"max_ns\": " + std::to_string(current.maxTime.count()) +
+                ", \"measurements\": " + std::to_string(current.measurements) +
+                ", \"draws\": " + std::to_string(current.draws) +
+                ", \"children\": [";
+        for (std::size_t i = 0; i < current.children.size(); i++) {
+            json += i == 0 ? "" : ", ";
+            writeJSON(json, current.children[i]);
+        }
+        json += "]}";
+    }
+
+    std::string Profile::getRepresentation() const {
+        std::ostringstream header;
+        header << std::left << std::setw(24) << "GATE" << std::right
+               << std::setw(12) << "COUNT"
+               << std::setw(14) << "TOTAL (ms)"
+               << std::setw(14) << "SELF (ms)"
+               << std::setw(14) << "MAX (us)"
+               << std::setw(14) << "MEASUREMENTS"
+               << std::setw(12) << "DRAWS" << "\n";
+        std::string table = header.str();
+
+        std::vector<std::size_t> sortedRoots = roots;
+        std::sort(sortedRoots.begin(), sortedRoots.end(), [this](const std::size_t &a, const std::size_t &b) {
+            return entries[a].totalTime > entries[b].totalTime;
+        });
+        for (const auto &root: sortedRoots) {
+            writeRow(table, root, 0);
+        }
+
+        std::ostringstream footer;
+        footer << std::fixed << std::setprecision(3)
+               << "Total: " << std::chrono::duration<double, std::milli>(totalTime).count() << " ms, "
+               << shotCount << " shot" << (shotCount == 1 ? "" : "s");
+        return table + footer.str();
+    }
+
+    void Profile::writeRow(std::string &table, const std::size_t &entry, const std::size_t &depth) const {
+        const Entry &current = entries[entry];
+        std::ostringstream row;
+        row << std::left << std::setw(24) << std::string(2 * depth, ' ') + current.symbol << std::right
+            << std::setw(12) << current.count << std::fixed << std::setprecision(3)
+            << std::setw(14) << std::chrono::duration<double, std::milli>(current.totalTime).count()
+            << std::setw(14) << std::chrono::duration<double, std::milli>(getSelfTime(entry)).count()
+            << std::setw(14) << std::chrono::duration<double, std::micro>(current.maxTime).count()
+            << std::setw(14) << current.measurements
+            << std::setw(12) << current.draws << "\n";
+        table += row.str();
+
+        std::vector<std::size_t> sortedChildren = current.children;
+        std::sort(sortedChildren.begin(), sortedChildren.end(), [this](const std::size_t &a, const std::size_t &b) {
+            return entries[a].totalTime > entries[b].totalTime;
+        });
+        for (const auto &child: sortedChildren) {
+            writeRow(table, child, depth + 1);
+        }
+    }
+
+}
@@ -0,0 +1,26 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/// Replaces the global allocation functions of the test it is linked into, counting the allocations
+/// It is a translation unit of its own, so that the compiler never sees the replacements inlined into their callers
+
+namespace QPP::Test {
+    std::atomic<std::size_t> allocationCount = 0;
+}
+
+void *operator new(std::size_t size) {
+    QPP::Test::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
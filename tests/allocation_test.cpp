@@ -0,0 +1,168 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "../include/circuit.hpp"
+
+/// This executable checks that running a compiled circuit on a warm workspace does not allocate, on every backend
+/// It counts the allocations through the global operator new replaced in allocation_counter.cpp, and exits with a
+/// non-zero status if a run allocates, or if the allocations of simulate grow with the number of shots
+
+namespace QPP::Test {
+    extern std::atomic<std::size_t> allocationCount;
+}
+
+namespace {
+    typedef QPP::Circuit<double> Circuit;
+    typedef std::shared_ptr<QPP::ProbabilityEngine<double>> Engine;
+
+    constexpr std::uint64_t SEED = 42;
+    constexpr size_t QUBIT_COUNT = 10;
+    constexpr size_t WARMUP_RUN_COUNT = 20;
+    constexpr size_t RUN_COUNT = 500;
+    constexpr size_t SHOT_COUNT = 1000;
+
+    size_t failureCount = 0;
+
+    Engine makeEngine() {
+        return std::make_shared<QPP::ProbabilityEngine<double>>(2e-10, SEED);
+    }
+
+    size_t getAllocationCount() {
+        return QPP::Test::allocationCount.load(std::memory_order_relaxed);
+    }
+
+    /// \brief Builds a GHZ circuit measured in the middle, so that the shots are run rather than sampled
+    /// \param clifford Whether the circuit only uses Clifford gates, for the stabilizer backend
+    /// \param spread Whether every qubit ends in superposition, making the sparse backend dense on every shot
+    Circuit makeCircuit(const Engine &engine, const bool &clifford, const bool &spread) {
+        Circuit circuit(engine, QUBIT_COUNT, QUBIT_COUNT);
+        circuit.addHadamardGate(0);
+        for (size_t i = 1; i < QUBIT_COUNT; i++) {
+            circuit.addCXGate(i - 1, i);
+        }
+        if (!clifford) {
+            circuit.addPhaseGate(3, 0.3);
+            circuit.addControlledHadamardGate(2, 7);
+            circuit.addControlledPhaseGate(0, QUBIT_COUNT - 1, 0.7);
+        }
+        circuit.addSwapGate(1, QUBIT_COUNT - 2);
+        circuit.addMeasureGate({{0, 0}});
+        circuit.addXGate(0);
+        if (spread) {
+            for (size_t i = 0; i < QUBIT_COUNT; i++) {
+                circuit.addHadamardGate(i);
+            }
+        }
+        // Spread circuits only measure a few qubits, so that a thousand shots see every outcome
+        std::vector<std::pair<size_t, size_t>> measurements;
+        for (size_t i = 0; i < (spread ? 3 : QUBIT_COUNT); i++) {
+            measurements.emplace_back(i, i);
+        }
+        circuit.addMeasureGate(measurements);
+        return circuit;
+    }
+
+    /// \brief Builds a circuit whose runs of two-qubit gates are fused into UNITARY instructions
+    Circuit makeFusedCircuit(const Engine &engine) {
+        Circuit circuit(engine, QUBIT_COUNT, QUBIT_COUNT);
+        for (size_t i = 0; i + 1 < QUBIT_COUNT; i++) {
+            circuit.addHadamardGate(i);
+            circuit.addControlledPhaseGate(i, i + 1, 0.3);
+            circuit.addCXGate(i + 1, i);
+        }
+        circuit.addMeasureGate({{0, 0}});
+        circuit.addHadamardGate(0);
+        circuit.addMeasureGate({{0, 1}, {1, 2}, {2, 3}});
+        return circuit.fuseGates(2);
+    }
+
+    /// \brief Builds a circuit whose runs of X, CX and swap gates are collapsed into PERMUTE instructions
+    Circuit makePermutationCircuit(const Engine &engine) {
+        Circuit circuit(engine, QUBIT_COUNT, QUBIT_COUNT);
+        for (size_t i = 0; i < 3; i++) {
+            circuit.addHadamardGate(i);
+        }
+        circuit.addMeasureGate({{0, 0}});
+        for (size_t i = 0; i + 2 < QUBIT_COUNT; i++) {
+            circuit.addCXGate(i, i + 1);
+            circuit.addXGate(i + 2);
+            circuit.addSwapGate(i, i + 2);
+        }
+        circuit.addMeasureGate({{0, 1}, {1, 2}, {2, 3}});
+        return circuit.collapsePermutations(4);
+    }
+
+    /// \brief Builds a circuit whose swaps cycle three qubits, so that the layout is restored by a PERMUTE instruction
+    Circuit makeSwapCycleCircuit(const Engine &engine) {
+        Circuit circuit(engine, QUBIT_COUNT, QUBIT_COUNT);
+        circuit.addHadamardGate(0);
+        circuit.addCXGate(0, 1);
+        circuit.addMeasureGate({{0, 0}});
+        circuit.addSwapGate(0, 1);
+        circuit.addSwapGate(1, 2);
+        circuit.addMeasureGate({{0, 1}, {1, 2}, {2, 3}});
+        return circuit;
+    }
+
+    void fail(const std::string &name, const std::string &reason) {
+        std::cerr << name << ": " << reason << "\n";
+        failureCount++;
+    }
+
+    void testRuns(const std::string &name, Circuit &circuit) {
+        Circuit::Workspace workspace(makeEngine());
+        // The first runs compile the circuit and grow the buffers of the workspace to their largest size
+        for (size_t i = 0; i < WARMUP_RUN_COUNT; i++) {
+            (void) circuit.run(workspace);
+        }
+        const size_t before = getAllocationCount();
+        for (size_t i = 0; i < RUN_COUNT; i++) {
+            (void) circuit.run(workspace);
+        }
+        const size_t allocations = getAllocationCount() - before;
+        if (allocations != 0) {
+            fail(name, std::to_string(allocations) + " allocations in " + std::to_string(RUN_COUNT) + " runs on a workspace");
+        }
+    }
+
+    void testSimulation(const std::string &name, Circuit &circuit) {
+        (void) circuit.simulate(SHOT_COUNT, 1);
+        // Every outcome has appeared by now, so more shots only run the allocation-free shot loop for longer
+        size_t before = getAllocationCount();
+        (void) circuit.simulate(SHOT_COUNT, 1);
+        const size_t fewShotAllocations = getAllocationCount() - before;
+        before = getAllocationCount();
+        (void) circuit.simulate(10 * SHOT_COUNT, 1);
+        const size_t manyShotAllocations = getAllocationCount() - before;
+        if (manyShotAllocations > fewShotAllocations) {
+            fail(name, "simulate makes " + std::to_string(fewShotAllocations) + " allocations for " +
+                       std::to_string(SHOT_COUNT) + " shots but " + std::to_string(manyShotAllocations) + " for " +
+                       std::to_string(10 * SHOT_COUNT));
+        }
+    }
+
+    void test(const std::string &name, const Circuit::Backend &backend, Circuit circuit) {
+        circuit.setBackend(backend);
+        testRuns(name, circuit);
+        testSimulation(name, circuit);
+        std::cout << "Checked " << name << "\n";
+    }
+}
+
+int main() {
+    test("state vector", Circuit::STATE_VECTOR, makeCircuit(makeEngine(), false, false));
+    test("stabilizer", Circuit::STABILIZER, makeCircuit(makeEngine(), true, false));
+    test("matrix product state", Circuit::MATRIX_PRODUCT_STATE, makeCircuit(makeEngine(), false, false));
+    test("sparse", Circuit::SPARSE, makeCircuit(makeEngine(), false, false));
+    test("sparse, becoming dense", Circuit::SPARSE, makeCircuit(makeEngine(), false, true));
+    test("state vector, fused gates", Circuit::STATE_VECTOR, makeFusedCircuit(makeEngine()));
+    test("state vector, collapsed permutations", Circuit::STATE_VECTOR, makePermutationCircuit(makeEngine()));
+    test("state vector, cycled swaps", Circuit::STATE_VECTOR, makeSwapCycleCircuit(makeEngine()));
+    if (failureCount != 0) {
+        std::cerr << failureCount << " checks failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/kernels.hpp"
+
+/// This executable checks every vectorized variant of the kernels supported by the CPU against the scalar variant,
+/// on random registers, targets, control masks and phase tables
+/// It exits with a non-zero status if any variant differs from the scalar one
+
+namespace {
+    typedef QPP::Kernels Kernels;
+    typedef Kernels::Amplitude Amplitude;
+
+    constexpr std::uint64_t SEED = 42;
+    constexpr size_t MAX_QUBIT_COUNT = 10;
+    constexpr size_t TRIALS_PER_SIZE = 200;
+    constexpr double TOLERANCE = 1e-12;
+
+    std::mt19937_64 generator(SEED);
+
+    size_t failureCount = 0;
+
+    Amplitude randomAmplitude() {
+        std::normal_distribution<double> distribution;
+        return {distribution(generator), distribution(generator)};
+    }
+
+    std::vector<Amplitude> randomAmplitudes(const size_t &size) {
+        std::vector<Amplitude> amplitudes(size);
+        for (auto &amplitude: amplitudes) {
+            amplitude = randomAmplitude();
+        }
+        return amplitudes;
+    }
+
+    /// \brief Gets a random subset of the bits of a mask
+    size_t randomSubset(const size_t &mask) {
+        return std::uniform_int_distribution<size_t>(0, ~size_t(0))(generator) & mask;
+    }
+
+    size_t randomBelow(const size_t &bound) {
+        return std::uniform_int_distribution<size_t>(0, bound - 1)(generator);
+    }
+
+    void check(const std::string &kernel, const Kernels::Level &level, const size_t &qubitCount,
+               const std::vector<Amplitude> &expected, const std::vector<Amplitude> &actual) {
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (std::abs(expected[i] - actual[i]) > TOLERANCE) {
+                if (failureCount < 10) {
+                    std::cerr << kernel << " " << Kernels::getLevelName(level) << " on " << qubitCount
+                              << " qubits differs from scalar at amplitude " << i << ": " << actual[i] << " instead of "
+                              << expected[i] << "\n";
+                }
+                failureCount++;
+                return;
+            }
+        }
+    }
+
+    void testMatrix(const Kernels::Level &level, const size_t &qubitCount) {
+        const size_t size = size_t(1) << qubitCount;
+        const size_t target = randomBelow(qubitCount);
+        const size_t controlMask = randomSubset((size - 1) & ~(size_t(1) << target));
+        const Kernels::Matrix matrix = {randomAmplitude(), randomAmplitude(), randomAmplitude(), randomAmplitude()};
+        std::vector<Amplitude> expected = randomAmplitudes(size);
+        std::vector<Amplitude> actual = expected;
+        Kernels::applyMatrix(expected.data(), size, target, matrix, controlMask, Kernels::SCALAR);
+        Kernels::applyMatrix(actual.data(), size, target, matrix, controlMask, level);
+        check("applyMatrix", level, qubitCount, expected, actual);
+    }
+
+    void testPhase(const Kernels::Level &level, const size_t &qubitCount) {
+        const size_t size = size_t(1) << qubitCount;
+        const size_t mask = randomSubset(size - 1) | (size_t(1) << randomBelow(qubitCount));
+        const Amplitude phase = std::polar(1.0, std::uniform_real_distribution<double>(0, 6.3)(generator));
+        std::vector<Amplitude> expected = randomAmplitudes(size);
+        std::vector<Amplitude> actual = expected;
+        Kernels::applyPhase(expected.data(), size, mask, phase, Kernels::SCALAR);
+        Kernels::applyPhase(actual.data(), size, mask, phase, level);
+        check("applyPhase", level, qubitCount, expected, actual);
+    }
+
+    void testDiagonal(const Kernels::Level &level, const size_t &qubitCount) {
+        const size_t size = size_t(1) << qubitCount;
+        const size_t lowestQubit = randomBelow(qubitCount);
+        const size_t phaseCount = size_t(1) << (1 + randomBelow(qubitCount - lowestQubit));
+        const std::vector<Amplitude> phases = randomAmplitudes(phaseCount);
+        std::vector<Amplitude> expected = randomAmplitudes(size);
+        std::vector<Amplitude> actual = expected;
+        Kernels::applyDiagonal(expected.data(), size, lowestQubit, phases.data(), phaseCount, Kernels::SCALAR);
+        Kernels::applyDiagonal(actual.data(), size, lowestQubit, phases.data(), phaseCount, level);
+        check("applyDiagonal", level, qubitCount, expected, actual);
+    }
+}
+
+int main() {
+    const Kernels::Level supportedLevel = Kernels::getSupportedLevel();
+    std::cout << "Supported level: " << Kernels::getLevelName(supportedLevel) << "\n";
+    for (int level = Kernels::SCALAR + 1; level <= supportedLevel; level++) {
+        // Every size is tested, so that the variants also fall back to narrower vectors on the smallest registers
+        for (size_t qubitCount = 1; qubitCount <= MAX_QUBIT_COUNT; qubitCount++) {
+            for (size_t trial = 0; trial < TRIALS_PER_SIZE; trial++) {
+                testMatrix(static_cast<Kernels::Level>(level), qubitCount);
+                testPhase(static_cast<Kernels::Level>(level), qubitCount);
+                testDiagonal(static_cast<Kernels::Level>(level), qubitCount);
+            }
+        }
+        std::cout << "Checked " << Kernels::getLevelName(static_cast<Kernels::Level>(level)) << "\n";
+    }
+    if (failureCount != 0) {
+        std::cerr << failureCount << " kernel calls differ from the scalar variant\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}